@@ -2156,11 +2156,16 @@ CallExpr* buildScanExpr(Expr* opExpr, Expr* dataExpr, bool zippered) {
   buildReduceScanPreface1(fn, data, eltType, opExpr, dataExpr, zippered);
   buildReduceScanPreface2(fn, eltType, globalOp, opExpr);
 
-  fn->insertAtTail("compilerWarning('scan has been serialized (see issue #5760)')");
-
   if( !zippered ) {
+    // 1-D arrays may be scanned in parallel, see ChapelReduce
+    VarSymbol* wMsg = new_StringSymbol("scan has been serialized (see issue #5760)");
+    fn->insertAtTail(new CondStmt(new CallExpr("!",
+                                    new CallExpr("chpl__scanIsParallel",
+                                                 globalOp, data)),
+                                  new CallExpr("compilerWarning", wMsg)));
     fn->insertAtTail("'return'(chpl__scanIterator(%S, %S))", globalOp, data);
   } else {
+    fn->insertAtTail("compilerWarning('scan has been serialized (see issue #5760)')");
     fn->insertAtTail("'return'(chpl__scanIteratorZip(%S, %S))", globalOp, data);
   }
 
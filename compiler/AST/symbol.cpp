@@ -1987,6 +1987,10 @@ std::string unescapeString(const char* const str, BaseAST *astForError) {
 }
 
 static int literal_id = 1;
+// String literals are globals in the generated header, so they are
+// numbered separately to keep their names from changing whenever a
+// numeric literal is added or removed.
+static int string_literal_id = 1;
 HashMap<Immediate *, ImmHashFns, VarSymbol *> uniqueConstantsHash;
 HashMap<Immediate *, ImmHashFns, VarSymbol *> stringLiteralsHash;
 FnSymbol* initStringLiterals = NULL;
@@ -2050,7 +2054,7 @@ VarSymbol *new_StringSymbol(const char *str) {
       gFalse);                    // owned = false
   ctor->insertAtTail(gFalse);     // needToCopy = false
 
-  s = new VarSymbol(astr("_str_literal_", istr(literal_id++)), dtString);
+  s = new VarSymbol(astr("_str_literal_", istr(string_literal_id++)), dtString);
   s->addFlag(FLAG_NO_AUTO_DESTROY);
   s->addFlag(FLAG_CONST);
   s->addFlag(FLAG_LOCALE_PRIVATE);
@@ -20,6 +20,7 @@
 #include "codegen.h"
 
 #include "astutil.h"
+#include "compileCache.h"
 #include "stlUtil.h"
 #include "config.h"
 #include "driver.h"
@@ -45,6 +46,7 @@
 #include <cctype>
 #include <cstring>
 #include <cstdio>
+#include <unistd.h>
 #include <vector>
 
 // function prototypes
@@ -1817,6 +1819,50 @@ static const char* generateFileName(ChainHashMap<char*, StringHashFns, int>& fil
   return name;
 }
 
+//
+// With --incremental, every module is generated into a separately
+// compiled file that includes chpl__header.h, so that make can build
+// them in parallel and objects for unchanged files can be reused (see
+// compileCacheReuseObjects()).  Modules share a file until it holds
+// incrementalFileSize bytes, and then the next function starts a new
+// one, so that the files come out about the same size.
+//
+static const long incrementalFileSize = 256 * 1024;
+
+static ChainHashMap<char*, StringHashFns, int> incrementalFileNames;
+static fileinfo incrementalFile = { NULL, NULL, NULL };
+static std::vector<const char*> incrementalObjFiles;
+
+static void closeIncrementalFile() {
+  if (incrementalFile.fptr != NULL) {
+    closeCFile(&incrementalFile);
+    incrementalFile.fptr = NULL;
+  }
+}
+
+static void openIncrementalFile(const char* moduleName) {
+  const char* filename = NULL;
+
+  closeIncrementalFile();
+
+  filename = generateFileName(incrementalFileNames, filename, moduleName);
+  openCFile(&incrementalFile, filename, "c");
+  fprintf(incrementalFile.fptr, "#include \"chpl__header.h\"\n");
+
+  incrementalObjFiles.push_back(astr(asubstr(incrementalFile.pathname,
+                                             strrchr(incrementalFile.pathname,
+                                                     '.')),
+                                     ".o"));
+  gGenInfo->cfile = incrementalFile.fptr;
+}
+
+void startIncrementalFileIfFull(ModuleSymbol* mod) {
+  if (ftell(incrementalFile.fptr) >= incrementalFileSize) {
+    flushStatements();
+    openIncrementalFile(mod->name);
+  }
+}
+
 
 static bool
 shouldChangeArgumentTypeToRef(ArgSymbol* arg) {
@@ -1995,27 +2041,6 @@ void codegen(void) {
     fprintf(mainfile.fptr, "#include \"chpl__header.h\"\n");
     fprintf(mainfile.fptr, "#include \"%s.c\"\n", sCfgFname);
     fprintf(mainfile.fptr, "#include \"chpl__defn.c\"\n");
-
-    std::vector<const char*> userFileName;
-    if(fIncrementalCompilation) {
-      ChainHashMap<char*, StringHashFns, int> fileNameHashMap;
-      forv_Vec(ModuleSymbol, currentModule, allModules) {
-        const char* filename = NULL;
-        filename = generateFileName(fileNameHashMap, filename, currentModule->name);
-        if(currentModule->modTag == MOD_USER) {
-          fileinfo modulefile;
-          openCFile(&modulefile, filename, "c");
-          int modulePathLen = strlen(astr(modulefile.pathname));
-          char path[FILENAME_MAX];
-          strncpy(path, astr(modulefile.pathname), modulePathLen-2);
-          path[modulePathLen-2]='\0';
-          userFileName.push_back(astr(path));
-          closeCFile(&modulefile);
-        }
-      }
-    }
-
-    codegen_makefile(&mainfile, NULL, false, userFileName);
   }
 
   // Vectors to store different symbol names to be used while generating header
@@ -2063,20 +2088,25 @@ void codegen(void) {
       mysystem(astr("# codegen-ing module", currentModule->name),
                "generating comment for --print-commands option");
 
+      if (fIncrementalCompilation) {
+        if (incrementalFile.fptr == NULL)
+          openIncrementalFile(currentModule->name);
+        currentModule->codegenDef();
+        continue;
+      }
+
       const char* filename = NULL;
       filename = generateFileName(fileNameHashMap, filename,currentModule->name);
 
       fileinfo modulefile;
       openCFile(&modulefile, filename, "c");
       info->cfile = modulefile.fptr;
-      if(fIncrementalCompilation && (currentModule->modTag == MOD_USER))
-        fprintf(modulefile.fptr, "#include \"chpl__header.h\"\n");
       currentModule->codegenDef();
       closeCFile(&modulefile);
 
-      if(!(fIncrementalCompilation && (currentModule->modTag == MOD_USER)))
-        fprintf(mainfile.fptr, "#include \"%s%s\"\n", filename, ".c");
+      fprintf(mainfile.fptr, "#include \"%s%s\"\n", filename, ".c");
     }
+    closeIncrementalFile();
 
     fprintf(strconfig.fptr, "#include \"chpl-string.h\"\n");
     fprintf(strconfig.fptr, "chpl_string defaultStringValue=\"\";\n");
@@ -2091,6 +2121,11 @@ void codegen(void) {
     closeCFile(&mainfile);
     closeCFile(&defnfile);
     closeCFile(&strconfig);
+
+    // The object files are only known once the modules are generated
+    if (fIncrementalCompilation)
+      compileCacheReuseObjects(incrementalObjFiles);
+    codegen_makefile(&mainfile, NULL, false, incrementalObjFiles);
   }
 
   if (fPrintEmittedCodeSize)
@@ -2109,10 +2144,24 @@ void makeBinary(void) {
 #endif
   } else {
     const char* makeflags = printSystemCommands ? "-f " : "-s -f ";
+    const char* jobs      = "";
+
+    // Build the separately generated files in parallel
+    if (fIncrementalCompilation) {
+      long numCPUs = sysconf(_SC_NPROCESSORS_ONLN);
+
+      if (numCPUs > 1)
+        jobs = astr("-j", istr((int) numCPUs), " ");
+    }
+
     const char* command = astr(astr(CHPL_MAKE, " "),
+                               jobs,
                                makeflags,
                                getIntermediateDirName(), "/Makefile");
     mysystem(command, "compiling generated source");
+
+    if (fIncrementalCompilation)
+      compileCacheStoreObjects();
   }
 }
 
@@ -1448,6 +1448,8 @@ void ModuleSymbol::codegenDef() {
 #endif
 
   for_vector(FnSymbol, fn, fns) {
+    if (fIncrementalCompilation && !llvmCodegen)
+      startIncrementalFileIfFull(this);
     fn->codegenDef();
   }
 
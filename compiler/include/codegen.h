@@ -45,6 +45,8 @@ class CCodeGenAction;
 
 #endif
 
+class ModuleSymbol;
+
 /* GenInfo is meant to be a global variable which stores
  * the code generator state - e.g. FILE* to print C to
  * or LLVM module in which to generate.
@@ -168,6 +170,7 @@ void zlineToFileIfNeeded(BaseAST* ast, FILE* outfile);
 const char* idCommentTemp(BaseAST* ast);
 void genComment(const char* comment, bool push=false);
 void flushStatements(void);
+void startIncrementalFileIfFull(ModuleSymbol* mod);
 
 
 #endif //CODEGEN_H
@@ -0,0 +1,58 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _COMPILECACHE_H_
+#define _COMPILECACHE_H_
+
+#include <vector>
+
+/*
+  Persistent cache of compiled programs, enabled by --incremental-cache.
+
+  An entry is keyed by the compiler configuration: the compiler binary,
+  its version, the command line, the working directory, every CHPL_*
+  setting, and what the program is compiled and linked against (the
+  runtime libraries and headers, the installed third-party packages,
+  the -I directories, and the back-end compiler and its version).  It
+  records the content hash of each file the compile read (the .chpl
+  modules parsed, internal and standard modules included, and the C
+  sources, headers and objects named on the command line or in
+  'require' statements).  When all of those files still hash the same,
+  the cached executable is copied into place and the passes are skipped.
+
+  With --incremental, the objects built from the generated C files are
+  also cached, keyed by the content of the C file, of chpl__header.h, of
+  the runtime headers and of the command line headers, and by the
+  back-end compiler, its version and its flags.  They are shared by
+  every compile that uses the same cache directory.
+*/
+
+// Returns true if the outputs of this compile were restored from the cache
+bool compileCacheLookup(const char* argv0);
+
+// Records the outputs of a successful compile in the cache
+void compileCacheStore();
+
+// Copies the cached objects for generated files that are unchanged
+void compileCacheReuseObjects(const std::vector<const char*>& objFiles);
+
+// Records the objects that compileCacheReuseObjects() could not find
+void compileCacheStoreObjects();
+
+#endif
@@ -108,6 +108,7 @@ extern const char* CHPL_UNWIND;
 
 extern bool  printPasses;
 extern FILE* printPassesFile;
+extern char  printPassesJson[FILENAME_MAX+1];
 
 // Set true if CHPL_WIDE_POINTERS==struct.
 // In that case, the code generator emits structures
@@ -206,6 +207,9 @@ extern bool fMinimalModules;
 // Set to true if we want to enable incremental compilation.
 extern bool fIncrementalCompilation;
 
+// Directory in which to cache compiled programs, if any
+extern char incrementalCacheDir[FILENAME_MAX+1];
+
 // Set to true if we want to use the experimental
 // Interactive Programming Environment (IPE) mode.
 extern bool fUseIPE;
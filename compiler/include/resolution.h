@@ -38,6 +38,16 @@ extern Vec<BlockStmt*> standardModuleSet;
 
 extern char            arrayUnrefName[];
 
+// Collected for --print-passes-json
+struct ResolutionModuleStats {
+  const char*    name;
+  unsigned long  usecs;          // resolving the module's own init/deinit
+  int            instantiations; // generic instantiations created meanwhile
+};
+
+extern int                                gNumInstantiations;
+extern std::vector<ResolutionModuleStats> gResolutionModuleStats;
+
 bool hasAutoCopyForType(Type* type);
 FnSymbol* getAutoCopyForType(Type* type);
 void getAutoCopyTypeKeys(Vec<Type*> &keys); // type to chpl__autoCopy function
@@ -19,13 +19,19 @@
 
 #include "PhaseTracker.h"
 
+#include "AstCount.h"
 #include "baseAST.h"
 #include "driver.h"
+#include "misc.h"
+#include "ModuleSymbol.h"
+#include "resolution.h"
 
 #include <cstdlib>
 #include <cstring>
 #include <algorithm>
 
+#include <sys/resource.h>
+
 // Used to collect the times as the program runs
 class Phase
 {
@@ -49,6 +55,9 @@ public:
   PhaseTracker::SubPhase   mSubPhase;
   unsigned long            mStartTime;  // Elapsed time from main() usecs
 
+  int                      mAstNodes;   // At the end of the phase, or -1
+  long                     mPeakRssKb;  // At the end of the phase, or -1
+
 private:
   Phase();
 };
@@ -82,6 +91,8 @@ public:
   unsigned long  mPrimary;          // usecs()
   unsigned long  mVerify;           // usecs()
   unsigned long  mCleanAst;         // usecs()
+  int            mAstNodes;         // at the end of the pass, or -1
+  long           mPeakRssKb;        // at the end of the pass, or -1
 };
 
 struct SortByTime
@@ -101,6 +112,8 @@ static void PassesReport(FILE*                    fp,
                          const std::vector<Pass>& passes,
                          unsigned long            totalTime);
 
+static long PeakRssKb();
+
 /************************************* | **************************************
 *                                                                             *
 * Implementation of PhaseTracker                                              *
@@ -150,6 +163,25 @@ void PhaseTracker::Stop()
   mTimer.stop();
 }
 
+// Record the size of the AST and the peak memory use so far against the
+// current phase.  Counting the AST visits every node, so the timer is
+// paused to keep that out of the times being reported.
+void PhaseTracker::RecordAstStatistics()
+{
+  Phase*   phase   = mPhases.back();
+  AstCount visitor;
+
+  mTimer.stop();
+
+  if (rootModule != NULL)
+    rootModule->accept(&visitor);
+
+  phase->mAstNodes  = visitor.total();
+  phase->mPeakRssKb = PeakRssKb();
+
+  mTimer.start();
+}
+
 void PhaseTracker::ReportPass() const
 {
   int index = mPhases.size() - 1;
@@ -221,12 +253,106 @@ void PhaseTracker::PassesCollect(std::vector<Pass>& passes) const
           pass.mCleanAst = elapsed;
           break;
       }
+
+      if (mPhases[i]->mAstNodes >= 0)
+      {
+        pass.mAstNodes  = mPhases[i]->mAstNodes;
+        pass.mPeakRssKb = mPhases[i]->mPeakRssKb;
+      }
     }
 
     passes.push_back(pass);
   }
 }
 
+void PhaseTracker::ReportJson(const char* fileName) const
+{
+  std::vector<Pass> passes;
+  unsigned long     totalTime = mTimer.elapsedUsecs();
+  FILE*             fp        = fopen(fileName, "w");
+  int               astNodes  = -1;
+  int               numStats  = (int) gResolutionModuleStats.size();
+
+  if (fp == NULL)
+  {
+    USR_WARN("Error opening --print-passes-json file: %s.", fileName);
+    return;
+  }
+
+  PassesCollect(passes);
+
+  fprintf(fp, "{\n");
+  fprintf(fp, "  \"totalTime\": %.6f,\n", totalTime / 1e6);
+  fprintf(fp, "  \"passes\": [\n");
+
+  for (size_t i = 0; i < passes.size(); i++)
+  {
+    const Pass& pass = passes[i];
+
+    fprintf(fp, "    { \"name\": \"%s\"", pass.mName);
+
+    if (pass.mPassId > 0)
+      fprintf(fp, ", \"passId\": %d", pass.mPassId);
+
+    fprintf(fp, ", \"time\": %.6f",      pass.TotalTime() / 1e6);
+    fprintf(fp, ", \"mainTime\": %.6f",  pass.mPrimary    / 1e6);
+    fprintf(fp, ", \"checkTime\": %.6f", pass.mVerify     / 1e6);
+    fprintf(fp, ", \"cleanTime\": %.6f", pass.mCleanAst   / 1e6);
+
+    if (pass.mAstNodes >= 0)
+    {
+      if (astNodes >= 0)
+        fprintf(fp, ", \"astNodesBefore\": %d", astNodes);
+
+      fprintf(fp, ", \"astNodesAfter\": %d", pass.mAstNodes);
+      fprintf(fp, ", \"peakRssKb\": %ld", pass.mPeakRssKb);
+
+      astNodes = pass.mAstNodes;
+    }
+
+    fprintf(fp, " }%s\n", (i + 1 < passes.size()) ? "," : "");
+  }
+
+  fprintf(fp, "  ],\n");
+  fprintf(fp, "  \"resolution\": {\n");
+  fprintf(fp, "    \"instantiations\": %d,\n", gNumInstantiations);
+  fprintf(fp, "    \"modules\": [\n");
+
+  for (int i = 0; i < numStats; i++)
+  {
+    const ResolutionModuleStats& stats = gResolutionModuleStats[i];
+
+    fprintf(fp,
+            "      { \"name\": \"%s\", \"time\": %.6f, "
+            "\"instantiations\": %d }%s\n",
+            stats.name,
+            stats.usecs / 1e6,
+            stats.instantiations,
+            (i + 1 < numStats) ? "," : "");
+  }
+
+  fprintf(fp, "    ]\n");
+  fprintf(fp, "  }\n");
+  fprintf(fp, "}\n");
+
+  fclose(fp);
+}
+
+// Peak resident set size of the compiler so far
+static long PeakRssKb()
+{
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return -1;
+
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024; // bytes on Mac OS X
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
 static void PassesSortByTime(std::vector<Pass>& passes)
 {
   std::sort(passes.begin(), passes.end(), SortByTime());
@@ -286,6 +412,8 @@ Phase::Phase(const char*            name,
   mPassId    = passId;
   mSubPhase  = subPhase;
   mStartTime = startTime;
+  mAstNodes  = -1;
+  mPeakRssKb = -1;
 }
 
 Phase::~Phase()
@@ -362,9 +490,11 @@ void Pass::Reset()
   mName     = 0;
   mPassId   = 0;
   mIndex    = 0;
-  mPrimary  = 0;
-  mVerify   = 0;
-  mCleanAst = 0;
+  mPrimary   =  0;
+  mVerify    =  0;
+  mCleanAst  =  0;
+  mAstNodes  = -1;
+  mPeakRssKb = -1;
 }
 
 unsigned long Pass::TotalTime() const
@@ -56,6 +56,10 @@
 * of these passes.  Phases that occur before and after the Passes ignore      *
 * the check and clean phases.                                                 *
 *                                                                             *
+* For --print-passes-json, the size of the AST and the peak memory use are    *
+* also recorded at the end of each pass, and written out along with the       *
+* times and the per-module resolution statistics as a JSON report.            *
+*                                                                             *
 ************************************** | *************************************/
 
 class Phase;
@@ -79,11 +83,15 @@ public:
 
   void                 Stop();
 
+  void                 RecordAstStatistics();
+
   void                 ReportPass  ()                                const;
   void                 ReportTotal ()                                const;
 
   void                 ReportRollup()                                const;
 
+  void                 ReportJson  (const char* fileName)            const;
+
 private:
   void                 PassesCollect(std::vector<Pass>& passes) const;
   
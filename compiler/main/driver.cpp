@@ -27,6 +27,7 @@
 #include "arg.h"
 #include "chpl.h"
 #include "commonFlags.h"
+#include "compileCache.h"
 #include "config.h"
 #include "countTokens.h"
 #include "docsDriver.h"
@@ -132,6 +133,7 @@ bool fStrictErrorHandling = false;
 
 bool  printPasses     = false;
 FILE* printPassesFile = NULL;
+char  printPassesJson[FILENAME_MAX+1] = "";
 
 // flag for llvmWideOpt
 bool fLLVMWideOpt = false;
@@ -151,6 +153,7 @@ bool fNoRemoveEmptyRecords = true;
 bool fRemoveUnreachableBlocks = true;
 bool fMinimalModules = false;
 bool fIncrementalCompilation = false;
+char incrementalCacheDir[FILENAME_MAX+1] = "";
 bool fUseIPE         = false;
 
 int optimize_on_clause_limit = 20;
@@ -842,6 +845,7 @@ static ArgumentDescription arg_desc[] = {
  {"print-commands", ' ', NULL, "[Don't] print system commands", "N", &printSystemCommands, "CHPL_PRINT_COMMANDS", NULL},
  {"print-passes", ' ', NULL, "[Don't] print compiler passes", "N", &printPasses, "CHPL_PRINT_PASSES", NULL},
  {"print-passes-file", ' ', "<filename>", "Print compiler passes to <filename>", "S", NULL, "CHPL_PRINT_PASSES_FILE", setPrintPassesFile},
+ {"print-passes-json", ' ', "<filename>", "Write a JSON report of time, memory and AST size per pass to <filename>", "P", printPassesJson, "CHPL_PRINT_PASSES_JSON", NULL},
 
  {"", ' ', NULL, "Miscellaneous Options", NULL, NULL, NULL, NULL},
 // Support for extern { c-code-here } blocks could be toggled with this
@@ -950,6 +954,7 @@ static ArgumentDescription arg_desc[] = {
  {"remove-unreachable-blocks", ' ', NULL, "[Don't] remove unreachable blocks after resolution", "N", &fRemoveUnreachableBlocks, "CHPL_REMOVE_UNREACHABLE_BLOCKS", NULL},
  {"replace-array-accesses-with-ref-temps", ' ', NULL, "Enable [disable] replacing array accesses with reference temps (experimental)", "N", &fReplaceArrayAccessesWithRefTemps, NULL, NULL },
  {"incremental", ' ', NULL, "Enable [disable] using incremental compilation", "N", &fIncrementalCompilation, "CHPL_INCREMENTAL_COMP", NULL},
+ {"incremental-cache", ' ', "<directory>", "Reuse programs cached in <directory> when their sources are unchanged", "P", incrementalCacheDir, "CHPL_INCREMENTAL_CACHE", NULL},
  {"minimal-modules", ' ', NULL, "Enable [disable] using minimal modules",               "N", &fMinimalModules, "CHPL_MINIMAL_MODULES", NULL},
  {"print-chpl-settings", ' ', NULL, "Print current chapel settings and exit", "F", &fPrintChplSettings, NULL,NULL},
  {"user-constructor-error", ' ', NULL, "Enable [disable] errors for user code constructors", "N", &fNoUserConstructors, NULL, NULL},
@@ -1301,7 +1306,14 @@ int main(int argc, char* argv[]) {
   addSourceFiles(sArgState.nfile_arguments, sArgState.file_argument);
 
   if (fUseIPE == false) {
-    runPasses(tracker, fDocs);
+    // Skip the passes when the cache holds the result of this compile
+    if (fDocs == true || compileCacheLookup(argv[0]) == false) {
+      runPasses(tracker, fDocs);
+
+      if (fDocs == false) {
+        compileCacheStore();
+      }
+    }
   } else {
     ipeRun();
   }
@@ -1322,6 +1334,10 @@ int main(int argc, char* argv[]) {
     fclose(printPassesFile);
   }
 
+  if (printPassesJson[0] != '\0') {
+    tracker.ReportJson(printPassesJson);
+  }
+
   clean_exit(0);
 
   return 0;
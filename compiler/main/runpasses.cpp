@@ -170,6 +170,10 @@ void runPasses(PhaseTracker& tracker, bool isChpldoc) {
     tracker.ReportPass();
   }
 
+  if (printPassesJson[0] != '\0') {
+    tracker.RecordAstStatistics();
+  }
+
   for (size_t i = 0; i < passListSize; i++) {
     runPass(tracker, i, isChpldoc);
 
@@ -234,6 +238,10 @@ static void runPass(PhaseTracker& tracker, size_t passIndex, bool isChpldoc) {
     cleanAst();
   }
 
+  if (printPassesJson[0] != '\0') {
+    tracker.RecordAstStatistics();
+  }
+
   if (printPasses == true || printPassesFile != 0) {
     tracker.ReportPass();
   }
@@ -25,6 +25,8 @@
 #include "stmt.h"
 #include "stlUtil.h"
 
+#include <algorithm>
+
 // 'markPruned' replaced deletion from SymbolMap, which does not work well.
 Symbol*           markPruned      = NULL;
 
@@ -524,12 +526,26 @@ void pruneThisArg(Symbol* parent, SymbolMap& uses) {
 // and the outer variable is replaced with the corresponding formal.
 // For a reduce intent, see the comment for addReduceIntentSupport().
 //
+static bool compareElemIds(SymbolMapElem* e1, SymbolMapElem* e2) {
+  return e1->key->id < e2->key->id;
+}
+
 static void
 addVarsToFormalsActuals(FnSymbol* fn, SymbolMap& vars,
                         CallExpr* call, bool isCoforall)
 {
   Expr *redRef1 = NULL, *redRef2 = NULL;
+  std::vector<SymbolMapElem*> elems;
+
+  // Add the formals in the order the variables were created rather than
+  // in the hash order of their addresses, so the generated code is the
+  // same from one compile to the next.
   form_Map(SymbolMapElem, e, vars) {
+    elems.push_back(e);
+  }
+  std::sort(elems.begin(), elems.end(), compareElemIds);
+
+  for_vector(SymbolMapElem, e, elems) {
       Symbol* sym = e->key;
       if (e->value != markPruned) {
         SET_LINENO(sym);
@@ -36,7 +36,16 @@
 
 //helper datastructures/types
 typedef std::pair<Expr*, Type*> DefCastPair;
-typedef std::map<SymExpr*, DefCastPair> UseDefCastMap;
+
+// Ordering the candidates by id rather than by address keeps which
+// temps are removed the same from one compile to the next.
+struct CompareSymExprIds {
+  bool operator()(SymExpr* a, SymExpr* b) const {
+    return a->id < b->id;
+  }
+};
+
+typedef std::map<SymExpr*, DefCastPair, CompareSymExprIds> UseDefCastMap;
 
 //prototypes
 bool primMoveGeneratesCommCall(CallExpr* ce);
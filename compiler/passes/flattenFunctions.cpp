@@ -26,6 +26,8 @@
 #include "stmt.h"
 #include "stlUtil.h"
 
+#include <algorithm>
+
 static void flattenNestedFunctions(Vec<FnSymbol*>& nestedFunctions);
 
 void flattenFunctions() {
@@ -173,72 +175,97 @@ passByRef(Symbol* sym) {
 }
 
 
+static bool
+compareSymbolIds(Symbol* sym1, Symbol* sym2) {
+  return sym1->id < sym2->id;
+}
+
+
+//
+// The outer vars in the order they were created, which the formals and
+// actuals are added in.  Iterating over 'vars' itself would order them
+// by the hash of their addresses and make the generated code differ
+// from one compile to the next.
+//
 static void
-addVarsToFormals(FnSymbol* fn, SymbolMap* vars) {
+sortedOuterVars(SymbolMap* vars, std::vector<Symbol*>& syms) {
   form_Map(SymbolMapElem, e, *vars) {
-    if (Symbol* sym = e->key) {
-      Type* type = sym->type;
-      IntentTag intent = INTENT_BLANK;
-
-        /* NOTE: This is still conservative.  This avoids passing
-           coforall index vars by reference for non-var iterators.
-           David came up with an example with nested functions and no
-           iterators that would unnecessarily pass coforall index vars
-           by reference.  With further analysis, we could figure out
-           whether this variable is actually going to be returned as
-           an LHS expr. */
-      //
-      // BHARSH: TODO: The arg intent set here can have a large impact on
-      // RVF later on. For RVF to be more effective, this might be a good
-      // place to do some analysis and mark arguments as 'const in' and 
-      // 'const ref', even if the actual is not marked with FLAG_CONST.
-      //
-      // Prior to the QualifiedType changes this section would make the type
-      // something like _ref_int, but the intent would be INTENT_CONST_IN and
-      // RVF would fire in some situations.
-      //
-      if (passByRef(sym)) {
-        // The task function can take in its argument by REF_MAYBE_CONST
-        // no matter the type. This enables e.g. a task function processing
-        // array elements to correctly set array argument intent.
-        IntentTag temp = INTENT_REF_MAYBE_CONST;
-        if (sym->hasFlag(FLAG_CONST)) {
-          temp = INTENT_CONST_REF;
-        }
-        intent = concreteIntent(temp, type);
-        type = type->getValType()->refType;
-      } else {
-        IntentTag temp = INTENT_BLANK;
-        if (sym->hasFlag(FLAG_CONST) && sym->isRef()) {
-          // Allows for RVF later
-          temp = INTENT_CONST_REF;
-        }
-        intent = concreteIntent(temp, type);
-      }
+    if (e->key)
+      syms.push_back(e->key);
+  }
+
+  std::sort(syms.begin(), syms.end(), compareSymbolIds);
+}
 
-      SET_LINENO(sym);
-      //
-      // BLC: TODO: This routine is part of the reason that we aren't
-      // consistent in representing 'ref' argument intents in the AST.
-      // In particular, the code above uses a certain test to decide
-      // to pass something by reference and changes the formal's type
-      // to the corresponding reference type if it believes it should.
-      // But the blankIntentForType() call below (and the INTENT_BLANK
-      // that was used before it) may pass the argument by 'const in'
-      // which seems inconsistent (because most 'ref' formals reflect
-      // INTENT_REF in the current compiler).  My current thought is
-      // to only indicate ref-ness through intents for most of the
-      // compilation (at a Chapel level) and only worry about ref
-      // types very close to code generation, primarily to avoid
-      // inconsistencies like this and keep things more
-      // uniform/simple; but we haven't made this switch yet.
-      //
-      ArgSymbol* arg = new ArgSymbol(intent, sym->name, type);
-      if (sym->hasFlag(FLAG_ARG_THIS))
-        arg->addFlag(FLAG_ARG_THIS);
-      fn->insertFormalAtTail(new DefExpr(arg));
-      vars->put(sym, arg);
+
+static void
+addVarsToFormals(FnSymbol* fn, SymbolMap* vars) {
+  std::vector<Symbol*> syms;
+
+  sortedOuterVars(vars, syms);
+
+  for_vector(Symbol, sym, syms) {
+    Type* type = sym->type;
+    IntentTag intent = INTENT_BLANK;
+
+      /* NOTE: This is still conservative.  This avoids passing
+         coforall index vars by reference for non-var iterators.
+         David came up with an example with nested functions and no
+         iterators that would unnecessarily pass coforall index vars
+         by reference.  With further analysis, we could figure out
+         whether this variable is actually going to be returned as
+         an LHS expr. */
+    //
+    // BHARSH: TODO: The arg intent set here can have a large impact on
+    // RVF later on. For RVF to be more effective, this might be a good
+    // place to do some analysis and mark arguments as 'const in' and 
+    // 'const ref', even if the actual is not marked with FLAG_CONST.
+    //
+    // Prior to the QualifiedType changes this section would make the type
+    // something like _ref_int, but the intent would be INTENT_CONST_IN and
+    // RVF would fire in some situations.
+    //
+    if (passByRef(sym)) {
+      // The task function can take in its argument by REF_MAYBE_CONST
+      // no matter the type. This enables e.g. a task function processing
+      // array elements to correctly set array argument intent.
+      IntentTag temp = INTENT_REF_MAYBE_CONST;
+      if (sym->hasFlag(FLAG_CONST)) {
+        temp = INTENT_CONST_REF;
+      }
+      intent = concreteIntent(temp, type);
+      type = type->getValType()->refType;
+    } else {
+      IntentTag temp = INTENT_BLANK;
+      if (sym->hasFlag(FLAG_CONST) && sym->isRef()) {
+        // Allows for RVF later
+        temp = INTENT_CONST_REF;
+      }
+      intent = concreteIntent(temp, type);
     }
+
+    SET_LINENO(sym);
+    //
+    // BLC: TODO: This routine is part of the reason that we aren't
+    // consistent in representing 'ref' argument intents in the AST.
+    // In particular, the code above uses a certain test to decide
+    // to pass something by reference and changes the formal's type
+    // to the corresponding reference type if it believes it should.
+    // But the blankIntentForType() call below (and the INTENT_BLANK
+    // that was used before it) may pass the argument by 'const in'
+    // which seems inconsistent (because most 'ref' formals reflect
+    // INTENT_REF in the current compiler).  My current thought is
+    // to only indicate ref-ness through intents for most of the
+    // compilation (at a Chapel level) and only worry about ref
+    // types very close to code generation, primarily to avoid
+    // inconsistencies like this and keep things more
+    // uniform/simple; but we haven't made this switch yet.
+    //
+    ArgSymbol* arg = new ArgSymbol(intent, sym->name, type);
+    if (sym->hasFlag(FLAG_ARG_THIS))
+      arg->addFlag(FLAG_ARG_THIS);
+    fn->insertFormalAtTail(new DefExpr(arg));
+    vars->put(sym, arg);
   }
 }
 
@@ -323,20 +350,22 @@ replaceVarUsesWithFormals(FnSymbol* fn, SymbolMap* vars) {
 
 static void
 addVarsToActuals(CallExpr* call, SymbolMap* vars, bool outerCall) {
-  form_Map(SymbolMapElem, e, *vars) {
-    if (Symbol* sym = e->key) {
-      SET_LINENO(sym);
-      if (!outerCall && passByRef(sym)) {
-        // This is only a performance issue.
-        INT_ASSERT(!sym->hasFlag(FLAG_SHOULD_NOT_PASS_BY_REF));
-        /* NOTE: See note above in addVarsToFormals() */
-        VarSymbol* tmp = newTemp(sym->type->getValType()->refType);
-        call->getStmtExpr()->insertBefore(new DefExpr(tmp));
-        call->getStmtExpr()->insertBefore(new CallExpr(PRIM_MOVE, tmp, new CallExpr(PRIM_ADDR_OF, sym)));
-        call->insertAtTail(tmp);
-      } else {
-        call->insertAtTail(sym);
-      }
+  std::vector<Symbol*> syms;
+
+  sortedOuterVars(vars, syms);
+
+  for_vector(Symbol, sym, syms) {
+    SET_LINENO(sym);
+    if (!outerCall && passByRef(sym)) {
+      // This is only a performance issue.
+      INT_ASSERT(!sym->hasFlag(FLAG_SHOULD_NOT_PASS_BY_REF));
+      /* NOTE: See note above in addVarsToFormals() */
+      VarSymbol* tmp = newTemp(sym->type->getValType()->refType);
+      call->getStmtExpr()->insertBefore(new DefExpr(tmp));
+      call->getStmtExpr()->insertBefore(new CallExpr(PRIM_MOVE, tmp, new CallExpr(PRIM_ADDR_OF, sym)));
+      call->insertAtTail(tmp);
+    } else {
+      call->insertAtTail(sym);
     }
   }
 }
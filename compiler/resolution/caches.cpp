@@ -23,8 +23,26 @@
 #include "stringutil.h"
 
 
+//
+// Sum the hashes of the pairs so that the order of the map does not
+// matter.  Pairs with a NULL value are left out, since checkCache
+// treats them the same as a missing key.
+//
+static uintptr_t
+hashSymbolMap(SymbolMap* map) {
+  uintptr_t hash = 0;
+  form_Map(SymbolMapElem, e, *map) {
+    if (e->value) {
+      uintptr_t pair = ((uintptr_t)e->key * 31) ^ (uintptr_t)e->value;
+      hash += pair * (uintptr_t)0x9E3779B97F4A7C15ULL;
+    }
+  }
+  return hash;
+}
+
+
 SymbolMapCacheEntry::SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap) :
-  fn(ifn), map(*imap) { }
+  fn(ifn), map(*imap), hash(hashSymbolMap(imap)) { }
 
 
 void
@@ -56,8 +74,9 @@ isCacheEntryMatch(SymbolMap* s1, SymbolMap* s2) {
 FnSymbol*
 checkCache(SymbolMapCache& cache, FnSymbol* oldFn, SymbolMap* map) {
   if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+    uintptr_t hash = hashSymbolMap(map);
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map))
+      if (entry->hash == hash && isCacheEntryMatch(map, &entry->map))
         return entry->fn;
     }
   }
@@ -68,8 +87,9 @@ checkCache(SymbolMapCache& cache, FnSymbol* oldFn, SymbolMap* map) {
 void
 replaceCache(SymbolMapCache& cache, FnSymbol* oldFn, FnSymbol* fn, SymbolMap* map) {
   if (Vec<SymbolMapCacheEntry*>* entries = cache.get(oldFn)) {
+    uintptr_t hash = hashSymbolMap(map);
     forv_Vec(SymbolMapCacheEntry, entry, *entries) {
-      if (isCacheEntryMatch(map, &entry->map)) {
+      if (entry->hash == hash && isCacheEntryMatch(map, &entry->map)) {
         entry->fn = fn;
         return;
       }
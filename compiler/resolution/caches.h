@@ -35,11 +35,16 @@
 //
 //   freeCache(cache): frees memory associated with cache
 //
+//   Each entry keeps a hash of its map that does not depend on the
+//   order of the key-value pairs, so checkCache only compares the
+//   maps of entries whose hashes match.
+//
 class SymbolMapCacheEntry {
  public:
   SymbolMapCacheEntry(FnSymbol* ifn, SymbolMap* imap);
   FnSymbol* fn;
   SymbolMap map;
+  uintptr_t hash;
 };
 typedef Map<FnSymbol*,Vec<SymbolMapCacheEntry*>*> SymbolMapCache;
 typedef MapElem<FnSymbol*,Vec<SymbolMapCacheEntry*>*> SymbolMapCacheElem;
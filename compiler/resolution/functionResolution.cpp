@@ -52,6 +52,7 @@
 #include "stmt.h"
 #include "stringutil.h"
 #include "symbol.h"
+#include "timer.h"
 #include "TryStmt.h"
 #include "typeSpecifier.h"
 #include "view.h"
@@ -138,6 +139,8 @@ Vec<CondStmt*>  tryStack;
 
 Vec<BlockStmt*> standardModuleSet;
 
+std::vector<ResolutionModuleStats> gResolutionModuleStats;
+
 
 //#
 //# Static Variables
@@ -6336,6 +6339,11 @@ static void resolveUses(ModuleSymbol* mod)
             module_resolution_depth, mod->name);
   }
 
+  Timer timer;
+  int   numInstantiations = gNumInstantiations;
+
+  timer.start();
+
   FnSymbol* fn = mod->initFn;
   resolveFormals(fn);
   resolveFns(fn);
@@ -6345,6 +6353,18 @@ static void resolveUses(ModuleSymbol* mod)
     resolveFns(defn);
   }
 
+  if (printPassesJson[0] != '\0') {
+    ResolutionModuleStats stats;
+
+    timer.stop();
+
+    stats.name           = mod->name;
+    stats.usecs          = timer.elapsedUsecs();
+    stats.instantiations = gNumInstantiations - numInstantiations;
+
+    gResolutionModuleStats.push_back(stats);
+  }
+
   if (fPrintModuleResolution) {
     AstCount visitor = AstCount();
     mod->accept(&visitor);
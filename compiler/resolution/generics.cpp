@@ -39,6 +39,8 @@
 
 #include <cstdlib>
 
+int                    gNumInstantiations         = 0;
+
 static int             explainInstantiationLine   = -2;
 static ModuleSymbol*   explainInstantiationModule = NULL;
 static Vec<FnSymbol*>  whereStack;
@@ -582,6 +584,8 @@ FnSymbol* instantiateFunction(FnSymbol*  fn,
                               SymbolMap& map) {
   FnSymbol* newFn = fn->partialCopy(&map);
 
+  gNumInstantiations++;
+
   addCache(genericsCache, root, newFn, &allSubs);
 
   newFn->removeFlag(FLAG_GENERIC);
@@ -50,9 +50,11 @@ static child type could end up calling something in the parent.
 #include "expr.h"
 #include "iterator.h"
 #include "resolution.h"
+#include "stlUtil.h"
 #include "stmt.h"
 #include "symbol.h"
 
+#include <algorithm>
 #include <set>
 #include <vector>
 
@@ -91,6 +93,8 @@ static bool isVirtualChild(FnSymbol* child, FnSymbol* parent);
 static bool signatureMatch(FnSymbol* fn, FnSymbol* gn);
 static bool possibleSignatureMatch(FnSymbol* fn, FnSymbol* gn);
 
+static bool compareFnIds(FnSymbol* fn1, FnSymbol* fn2);
+
 void resolveDynamicDispatches() {
   int numTypes = 0;
 
@@ -127,16 +131,25 @@ void resolveDynamicDispatches() {
 
   } while (numTypes != gTypeSymbols.n);
 
+  // Add the roots in the order they were created, not the hash order of
+  // their addresses, so that the table is the same from one compile to
+  // the next.
+  std::vector<FnSymbol*> roots;
+
   for (int i = 0; i < virtualRootsMap.n; i++) {
     if (virtualRootsMap.v[i].key) {
       for (int j = 0; j < virtualRootsMap.v[i].value->n; j++) {
-        FnSymbol* root = virtualRootsMap.v[i].value->v[j];
-
-        addVirtualMethodTableEntry(root->_this->type, root, true);
+        roots.push_back(virtualRootsMap.v[i].value->v[j]);
       }
     }
   }
 
+  std::sort(roots.begin(), roots.end(), compareFnIds);
+
+  for_vector(FnSymbol, root, roots) {
+    addVirtualMethodTableEntry(root->_this->type, root, true);
+  }
+
   Vec<Type*> ctq;
 
   ctq.add(dtObject);
@@ -495,6 +508,10 @@ static void collectInstantiatedAggregateTypes(std::vector<AggregateType*>& icts,
   }
 }
 
+static bool compareFnIds(FnSymbol* fn1, FnSymbol* fn2) {
+  return fn1->id < fn2->id;
+}
+
 // if exclusive=true, check for fn already existing in the virtual method
 // table and do not add it a second time if it is already present.
 static void addVirtualMethodTableEntry(Type*     type,
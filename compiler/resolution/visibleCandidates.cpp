@@ -47,6 +47,9 @@ static void gatherCandidates(CallInfo&                  info,
                              bool                       generated,
                              Vec<ResolutionCandidate*>& candidates);
 
+static bool isArityMatch    (CallInfo&                  info,
+                             FnSymbol*                  fn);
+
 static void filterCandidate (CallInfo&                  info,
                              FnSymbol*                  fn,
                              Vec<ResolutionCandidate*>& candidates);
@@ -75,7 +78,8 @@ static void gatherCandidates(CallInfo&                  info,
   forv_Vec(FnSymbol, fn, visibleFns) {
     // Consider either the user-defined functions or the compiler-generated
     // functions based on the input 'compilerGenerated'.
-    if (fn->hasFlag(FLAG_COMPILER_GENERATED) == compilerGenerated) {
+    if (fn->hasFlag(FLAG_COMPILER_GENERATED) == compilerGenerated &&
+        isArityMatch(info, fn)               == true) {
 
       // Consider
       //
@@ -116,6 +120,34 @@ static void gatherCandidates(CallInfo&                  info,
   }
 }
 
+//
+// A cheap test that rejects functions that cannot accept the number of
+// actuals in the call before building a ResolutionCandidate for them.
+// Each actual needs its own formal and each formal without a default
+// needs an actual.  Variable argument functions and generic tuple
+// functions, which can take any number of actuals, are always accepted.
+//
+static bool isArityMatch(CallInfo& info, FnSymbol* fn) {
+  int numActuals  = info.actuals.n;
+  int numRequired = 0;
+
+  if (fn->hasFlag(FLAG_GENERIC) && fn->hasFlag(FLAG_TUPLE)) {
+    return true;
+  }
+
+  for_formals(formal, fn) {
+    if (formal->variableExpr != NULL) {
+      return true;
+    }
+
+    if (formal->defaultExpr == NULL) {
+      numRequired++;
+    }
+  }
+
+  return numRequired <= numActuals && numActuals <= fn->numFormals();
+}
+
 static void filterCandidate(CallInfo&                  info,
                             FnSymbol*                  fn,
                             Vec<ResolutionCandidate*>& candidates) {
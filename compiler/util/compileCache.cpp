@@ -0,0 +1,616 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "compileCache.h"
+
+#include "driver.h"
+#include "files.h"
+#include "insertLineNumbers.h"
+#include "misc.h"
+#include "stringutil.h"
+
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <dirent.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern char** environ;
+
+//
+// The cache directory holds one subdirectory per configuration hash.
+// Each contains the cached outputs (output.0, output.1, ...) and a
+// manifest naming where each output goes and the hash of every input.
+// The manifest is written last, so an entry without one is ignored.
+//
+static const char* manifestHeader = "chpl compile cache 1";
+
+// The entry for this compile, set by compileCacheLookup()
+static const char* sEntryDir = NULL;
+
+// Set by compileCacheLookup() for compileCacheReuseObjects()
+static unsigned long long sObjectConfiguration = 0;
+
+// The generated objects and where each one goes in the cache
+static std::vector<std::pair<const char*, const char*> > sObjects;
+
+static const unsigned long long fnvOffset = 14695981039346656037ULL;
+static const unsigned long long fnvPrime  = 1099511628211ULL;
+
+static unsigned long long hashBytes(unsigned long long hash,
+                                    const void*        data,
+                                    size_t             len) {
+  const unsigned char* bytes = (const unsigned char*) data;
+
+  for (size_t i = 0; i < len; i++) {
+    hash ^= bytes[i];
+    hash *= fnvPrime;
+  }
+
+  return hash;
+}
+
+// Hashes the terminating NUL too, so that ("ab", "c") != ("a", "bc")
+static unsigned long long hashString(unsigned long long hash, const char* s) {
+  return hashBytes(hash, s, strlen(s) + 1);
+}
+
+static bool hashFile(const char* path, unsigned long long* result) {
+  FILE*              fp   = fopen(path, "rb");
+  unsigned long long hash = fnvOffset;
+  char               buf[64 * 1024];
+  size_t             len  = 0;
+  bool               ok   = false;
+
+  if (fp != NULL) {
+    while ((len = fread(buf, 1, sizeof(buf), fp)) > 0) {
+      hash = hashBytes(hash, buf, len);
+    }
+
+    ok = (ferror(fp) == 0);
+
+    fclose(fp);
+  }
+
+  *result = hash;
+
+  return ok;
+}
+
+//
+// The files under a directory, by name, size and modification time.
+// This stands in for their content, which is too much to read on every
+// compile, in directories that are only changed by a rebuild or an
+// install.  When byContent is set the content is hashed instead, for
+// small trees where a stale match would be costly.
+//
+static unsigned long long hashTree(unsigned long long hash,
+                                   const char*        dir,
+                                   bool               byContent) {
+  std::vector<std::string> names;
+
+  if (DIR* dp = opendir(dir)) {
+    while (struct dirent* ent = readdir(dp)) {
+      if (strcmp(ent->d_name, ".") != 0 && strcmp(ent->d_name, "..") != 0) {
+        names.push_back(ent->d_name);
+      }
+    }
+
+    closedir(dp);
+  }
+
+  std::sort(names.begin(), names.end());
+
+  for (size_t i = 0; i < names.size(); i++) {
+    const char* path = astr(dir, "/", names[i].c_str());
+    struct stat st;
+
+    // Don't follow links to directories, which may form a cycle
+    if (lstat(path, &st) == 0 && S_ISDIR(st.st_mode)) {
+      hash = hashString(hash, names[i].c_str());
+      hash = hashTree(hash, path, byContent);
+
+    } else if (byContent == true) {
+      unsigned long long content = 0;
+
+      if (hashFile(path, &content) == true) {
+        hash = hashString(hash, names[i].c_str());
+        hash = hashBytes(hash, &content, sizeof(content));
+      }
+
+    } else if (stat(path, &st) == 0) {
+      hash = hashString(hash, names[i].c_str());
+      hash = hashBytes(hash, &st.st_ino,   sizeof(st.st_ino));
+      hash = hashBytes(hash, &st.st_mtime, sizeof(st.st_mtime));
+      hash = hashBytes(hash, &st.st_size,  sizeof(st.st_size));
+    }
+  }
+
+  // Separates this directory from whatever is hashed next
+  return hashString(hash, "");
+}
+
+// The output and exit status of a shell command
+static unsigned long long hashCommand(unsigned long long hash,
+                                      const char*        command) {
+  FILE*  pipe = popen(command, "r");
+  char   buf[4096];
+  size_t len  = 0;
+  int    rc   = -1;
+
+  hash = hashString(hash, command);
+
+  if (pipe != NULL) {
+    while ((len = fread(buf, 1, sizeof(buf), pipe)) > 0) {
+      hash = hashBytes(hash, buf, len);
+    }
+
+    rc = pclose(pipe);
+  }
+
+  return hashBytes(hash, &rc, sizeof(rc));
+}
+
+//
+// The back-end compiler: the runtime's compile line, which names it
+// along with the runtime and third-party include paths, and the version
+// it reports, which changes when it is upgraded in place.
+//
+static unsigned long long backendCompilerHash(unsigned long long hash) {
+  std::string compileline = std::string(CHPL_HOME) +
+                            "/util/config/compileline --compile 2> /dev/null";
+  std::string line;
+  char        buf[4096];
+
+  if (FILE* pipe = popen(compileline.c_str(), "r")) {
+    while (fgets(buf, sizeof(buf), pipe) != NULL) {
+      line += buf;
+    }
+
+    pclose(pipe);
+  }
+
+  hash = hashString(hash, line.c_str());
+
+  // The compiler is the first word of the compile line
+  size_t start = line.find_first_not_of(" \t\n");
+  size_t end   = line.find_first_of(" \t\n", start);
+
+  if (start != std::string::npos) {
+    std::string version = line.substr(start, end - start) +
+                          " --version 2>&1";
+
+    hash = hashCommand(hash, version.c_str());
+  }
+
+  return hash;
+}
+
+// The compiler and the settings, which both kinds of entry depend on
+static unsigned long long toolchainHash(const char* argv0) {
+  unsigned long long       hash = fnvOffset;
+  std::vector<std::string> chplVars;
+
+  hash = hashString(hash, compileVersion);
+
+  // A rebuilt compiler may generate different code for the same sources
+  if (char* exe = findProgramPath(argv0)) {
+    struct stat st;
+
+    hash = hashString(hash, exe);
+
+    if (stat(exe, &st) == 0) {
+      hash = hashBytes(hash, &st.st_mtime, sizeof(st.st_mtime));
+      hash = hashBytes(hash, &st.st_size,  sizeof(st.st_size));
+    }
+
+    free(exe);
+  }
+
+  // The printchplenv settings, including the inferred ones
+  for (std::map<std::string, const char*>::iterator env = envMap.begin();
+       env != envMap.end();
+       ++env) {
+    hash = hashString(hash, env->first.c_str());
+    hash = hashString(hash, env->second);
+  }
+
+  // CHPL_* variables can also stand in for command line flags
+  for (char** env = environ; *env != NULL; env++) {
+    if (strncmp(*env, "CHPL_", 5) == 0) {
+      chplVars.push_back(*env);
+    }
+  }
+
+  std::sort(chplVars.begin(), chplVars.end());
+
+  for (size_t i = 0; i < chplVars.size(); i++) {
+    hash = hashString(hash, chplVars[i].c_str());
+  }
+
+  //
+  // What the generated code is compiled and linked against: the runtime
+  // libraries and headers, the installed third-party packages, the -I
+  // directories and the back-end compiler.  Rebuilding or upgrading any
+  // of them changes the program even when its sources are unchanged.
+  //
+  hash = hashTree(hash, CHPL_RUNTIME_LIB,  false);
+  hash = hashTree(hash, CHPL_RUNTIME_INCL, false);
+
+  if (DIR* dp = opendir(CHPL_THIRD_PARTY)) {
+    std::vector<std::string> packages;
+
+    while (struct dirent* ent = readdir(dp)) {
+      if (ent->d_name[0] != '.') {
+        packages.push_back(ent->d_name);
+      }
+    }
+
+    closedir(dp);
+
+    std::sort(packages.begin(), packages.end());
+
+    for (size_t i = 0; i < packages.size(); i++) {
+      hash = hashTree(hash, astr(CHPL_THIRD_PARTY, "/",
+                                 packages[i].c_str(), "/install"),
+                      false);
+    }
+  }
+
+  forv_Vec(const char*, dirName, incDirs) {
+    hash = hashString(hash, dirName);
+    hash = hashTree(hash, dirName, false);
+  }
+
+  return backendCompilerHash(hash);
+}
+
+static unsigned long long configurationHash(unsigned long long toolchain) {
+  unsigned long long hash = fnvOffset;
+
+  hash = hashString(hash, compileCommand);
+  hash = hashString(hash, getCwd());
+
+  return hashBytes(hash, &toolchain, sizeof(toolchain));
+}
+
+//
+// Generated objects only depend on the C they were compiled from and
+// on how the back-end compiler is invoked, not on the command line as
+// a whole, so that they can be shared between compiles.
+//
+static unsigned long long objectConfigurationHash(unsigned long long toolchain) {
+  unsigned long long hash = fnvOffset;
+
+  hash = hashString(hash, ccflags.c_str());
+  hash = hashBytes(hash, &optimizeCCode,   sizeof(optimizeCCode));
+  hash = hashBytes(hash, &debugCCode,      sizeof(debugCCode));
+  hash = hashBytes(hash, &specializeCCode, sizeof(specializeCCode));
+  hash = hashBytes(hash, &ffloatOpt,       sizeof(ffloatOpt));
+  hash = hashBytes(hash, &fLibraryCompile, sizeof(fLibraryCompile));
+  hash = hashBytes(hash, &fLinkStyle,      sizeof(fLinkStyle));
+
+  return hashBytes(hash, &toolchain, sizeof(toolchain));
+}
+
+//
+// Copy via a temporary file and rename, so that an executable that is
+// running, or a copy that is interrupted, is never overwritten in place.
+//
+static bool copyFile(const char* src, const char* dst) {
+  const char* tmp    = astr(dst, ".chpl-cache-tmp");
+  FILE*       in     = fopen(src, "rb");
+  FILE*       out    = NULL;
+  char        buf[64 * 1024];
+  size_t      len    = 0;
+  bool        ok     = false;
+  struct stat st;
+
+  if (in == NULL) {
+    return false;
+  }
+
+  if (fstat(fileno(in), &st) == 0 && (out = fopen(tmp, "wb")) != NULL) {
+    ok = true;
+
+    while (ok && (len = fread(buf, 1, sizeof(buf), in)) > 0) {
+      ok = (fwrite(buf, 1, len, out) == len);
+    }
+
+    ok = (fclose(out) == 0) && ok && ferror(in) == 0;
+    ok = ok && chmod(tmp, st.st_mode & 07777) == 0;
+    ok = ok && rename(tmp, dst) == 0;
+
+    if (ok == false) {
+      unlink(tmp);
+    }
+  }
+
+  fclose(in);
+
+  return ok;
+}
+
+static void stripNewline(char* line) {
+  size_t len = strlen(line);
+
+  while (len > 0 && (line[len - 1] == '\n' || line[len - 1] == '\r')) {
+    line[--len] = '\0';
+  }
+}
+
+//
+// Read the manifest of an entry, checking each input against its
+// recorded hash.  Returns false as soon as anything differs.
+//
+static bool readManifest(FILE* manifest, std::vector<std::string>& outputs) {
+  char line[FILENAME_MAX + 64];
+
+  if (fgets(line, sizeof(line), manifest) == NULL) {
+    return false;
+  }
+
+  stripNewline(line);
+
+  if (strcmp(line, manifestHeader) != 0) {
+    return false;
+  }
+
+  while (fgets(line, sizeof(line), manifest) != NULL) {
+    stripNewline(line);
+
+    if (strncmp(line, "output ", 7) == 0) {
+      outputs.push_back(line + 7);
+
+    } else if (strncmp(line, "input ", 6) == 0) {
+      unsigned long long expected = 0;
+      unsigned long long actual   = 0;
+      int                pathPos  = 0;
+
+      if (sscanf(line + 6, "%llx %n", &expected, &pathPos) != 1 ||
+          pathPos                                         == 0) {
+        return false;
+      }
+
+      if (hashFile(line + 6 + pathPos, &actual) == false ||
+          actual                                != expected) {
+        return false;
+      }
+
+    } else {
+      return false;
+    }
+  }
+
+  return outputs.size() > 0;
+}
+
+bool compileCacheLookup(const char* argv0) {
+  std::vector<std::string> outputs;
+  unsigned long long       toolchain = 0;
+  FILE*                    manifest  = NULL;
+  bool                     valid     = false;
+  char                     key[32];
+
+  if (incrementalCacheDir[0] == '\0') {
+    return false;
+  }
+
+  toolchain            = toolchainHash(argv0);
+  sObjectConfiguration = objectConfigurationHash(toolchain);
+
+  if (fLibraryCompile || no_codegen) {
+    return false;
+  }
+
+  snprintf(key, sizeof(key), "%016llx", configurationHash(toolchain));
+
+  sEntryDir = astr(incrementalCacheDir, "/", key);
+
+  manifest  = fopen(astr(sEntryDir, "/manifest"), "r");
+
+  if (manifest == NULL) {
+    return false;
+  }
+
+  valid = readManifest(manifest, outputs);
+
+  fclose(manifest);
+
+  for (size_t i = 0; valid && i < outputs.size(); i++) {
+    const char* cached = astr(sEntryDir, "/output.", istr((int) i));
+
+    valid = copyFile(cached, outputs[i].c_str());
+  }
+
+  if (valid && printPasses) {
+    fprintf(stderr, "Reused the compile cached in %s\n", sEntryDir);
+  }
+
+  return valid;
+}
+
+void compileCacheStore() {
+  std::set<std::string>    inputs;
+  std::vector<const char*> outputs;
+  const char*              manifestName = NULL;
+  const char*              tmpName      = NULL;
+  FILE*                    manifest     = NULL;
+  int                      fileNum      = 0;
+  bool                     ok           = true;
+
+  if (sEntryDir == NULL) {
+    return;
+  }
+
+  // Every module file the parser read, minus pseudo-files like <internal>
+  for (size_t i = 0; i < gFilenameLookup.size(); i++) {
+    if (gFilenameLookup[i].empty() == false && gFilenameLookup[i][0] != '<') {
+      inputs.insert(gFilenameLookup[i]);
+    }
+  }
+
+  // Command line and 'require'd files.  Headers that are not found
+  // relative to the working directory come from the -I directories,
+  // which are part of the configuration, or from the system paths,
+  // which are covered by the back-end compiler version.
+  while (const char* inputFilename = nthFilename(fileNum++)) {
+    if (isCHeader(inputFilename) == false || access(inputFilename, R_OK) == 0) {
+      inputs.insert(inputFilename);
+    }
+  }
+
+  outputs.push_back(executableFilename);
+
+  // Launchers put the program itself in <executable>_real
+  if (access(astr(executableFilename, "_real"), F_OK) == 0) {
+    outputs.push_back(astr(executableFilename, "_real"));
+  }
+
+  manifestName = astr(sEntryDir, "/manifest");
+  tmpName      = astr(sEntryDir, "/manifest.tmp");
+
+  ensureDirExists(sEntryDir, "creating the compile cache directory");
+
+  // Invalidate the old entry before replacing its outputs
+  unlink(manifestName);
+
+  for (size_t i = 0; ok && i < outputs.size(); i++) {
+    ok = copyFile(outputs[i], astr(sEntryDir, "/output.", istr((int) i)));
+  }
+
+  if (ok == false || (manifest = fopen(tmpName, "w")) == NULL) {
+    return;
+  }
+
+  fprintf(manifest, "%s\n", manifestHeader);
+
+  for (size_t i = 0; i < outputs.size(); i++) {
+    fprintf(manifest, "output %s\n", outputs[i]);
+  }
+
+  for (std::set<std::string>::iterator it = inputs.begin();
+       ok && it != inputs.end();
+       ++it) {
+    unsigned long long hash = 0;
+
+    ok = hashFile(it->c_str(), &hash);
+
+    fprintf(manifest, "input %016llx %s\n", hash, it->c_str());
+  }
+
+  ok = (fclose(manifest) == 0) && ok;
+
+  if (ok == false || rename(tmpName, manifestName) != 0) {
+    unlink(tmpName);
+  }
+}
+
+void compileCacheReuseObjects(const std::vector<const char*>& objFiles) {
+  unsigned long long headers = sObjectConfiguration;
+  const char*        objDir  = NULL;
+  int                fileNum = 0;
+  int                reused  = 0;
+
+  if (incrementalCacheDir[0] == '\0') {
+    return;
+  }
+
+  objDir = astr(incrementalCacheDir, "/objects");
+
+  //
+  // Every generated file includes chpl__header.h, which includes the
+  // runtime headers and the command line and 'require'd headers.  An
+  // object built against other runtime headers would link against the
+  // current runtime library without complaint, so those are hashed by
+  // content, on top of the configuration, which already covers the
+  // back-end compiler version.  As for compileCacheStore(), headers
+  // found on the -I paths are covered by the configuration.
+  //
+  if (hashFile(genIntermediateFilename("chpl__header.h"), &headers) == false) {
+    return;
+  }
+
+  headers = hashBytes(headers,
+                      &sObjectConfiguration,
+                      sizeof(sObjectConfiguration));
+
+  headers = hashTree(headers, CHPL_RUNTIME_INCL, true);
+
+  while (const char* inputFilename = nthFilename(fileNum++)) {
+    unsigned long long hash = 0;
+
+    if (isCHeader(inputFilename) && hashFile(inputFilename, &hash)) {
+      headers = hashString(headers, inputFilename);
+      headers = hashBytes(headers, &hash, sizeof(hash));
+    }
+  }
+
+  for (size_t i = 0; i < objFiles.size(); i++) {
+    const char*        objFile = objFiles[i];
+    const char*        srcFile = astr(asubstr(objFile, strrchr(objFile, '.')),
+                                      ".c");
+    unsigned long long hash    = 0;
+    char               key[40];
+
+    if (hashFile(srcFile, &hash) == false) {
+      continue;
+    }
+
+    snprintf(key, sizeof(key), "%016llx%016llx", headers, hash);
+
+    const char* cached = astr(objDir, "/", key, ".o");
+
+    // Copied after the source was written, so make sees it as current
+    if (copyFile(cached, objFile) == true) {
+      reused++;
+    } else {
+      sObjects.push_back(std::make_pair(objFile, cached));
+    }
+  }
+
+  if (printPasses) {
+    fprintf(stderr,
+            "Reused %d of %d generated objects cached in %s\n",
+            reused, (int) objFiles.size(), objDir);
+  }
+}
+
+void compileCacheStoreObjects() {
+  if (sObjects.size() == 0) {
+    return;
+  }
+
+  ensureDirExists(astr(incrementalCacheDir, "/objects"),
+                  "creating the compile cache directory");
+
+  for (size_t i = 0; i < sObjects.size(); i++) {
+    copyFile(sObjects[i].first, sObjects[i].second);
+  }
+
+  sObjects.clear();
+}
@@ -534,6 +534,27 @@ static void genCFileBuildRules(FILE* makefile) {
   fprintf(makefile, "\n");
 }
 
+//
+// Objects for the separately generated files.  Unlike the command line
+// sources these are not forced, so an object that is newer than its
+// source, because it was copied from the compile cache, is not rebuilt.
+//
+static void genObjFileBuildRules(FILE*                           makefile,
+                                 const std::vector<const char*>& objFiles) {
+  for (size_t i = 0; i < objFiles.size(); i++) {
+    const char* objFilename = objFiles[i];
+    const char* srcFilename = astr(asubstr(objFilename,
+                                           strrchr(objFilename, '.')),
+                                   ".c");
+
+    fprintf(makefile, "%s: %s\n", objFilename, srcFilename);
+    fprintf(makefile,
+            "\t$(CC) $(CHPL_MAKE_BASE_CFLAGS) $(GEN_CFLAGS) $(COMP_GEN_CFLAGS)"
+            " -c -o $@ $(CHPL_RT_INC_DIR) $<\n");
+    fprintf(makefile, "\n");
+  }
+}
+
 
 static void genObjFiles(FILE* makefile) {
   int filenum = 0;
@@ -570,7 +591,7 @@ void genIncludeCommandLineHeaders(FILE* outfile) {
 }
 
 
-void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_compile_link, const std::vector<const char*>& splitFiles) {
+void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_compile_link, const std::vector<const char*>& objFiles) {
   fileinfo makefile;
   openCFile(&makefile, "Makefile");
   const char* tmpDirName = intDirName;
@@ -666,8 +687,8 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_com
   fprintf(makefile.fptr, "CHPLSRC = \\\n");
   fprintf(makefile.fptr, "\t%s \\\n\n", mainfile->pathname);
   fprintf(makefile.fptr, "CHPLUSEROBJ = \\\n");
-  for(int i=0; i<(int)splitFiles.size(); i++)
-    fprintf(makefile.fptr, "\t%s \\\n", splitFiles[i]);
+  for(int i=0; i<(int)objFiles.size(); i++)
+    fprintf(makefile.fptr, "\t%s \\\n", objFiles[i]);
   fprintf(makefile.fptr, "\n");
   genCFiles(makefile.fptr);
   genObjFiles(makefile.fptr);
@@ -692,6 +713,7 @@ void codegen_makefile(fileinfo* mainfile, const char** tmpbinname, bool skip_com
   }
   fprintf(makefile.fptr, "\n");
   genCFileBuildRules(makefile.fptr);
+  genObjFileBuildRules(makefile.fptr, objFiles);
   closeCFile(&makefile, false);
 }
 
@@ -830,6 +830,13 @@ proc BlockCyclicArr.dsiPrivatize(privatizeData) {
   return c;
 }
 
+inline proc BlockCyclicArr.dsiLocalAccess(i: rank*idxType) ref {
+  if rank == 1 then
+    return myLocArr.this(i(1));
+  else
+    return myLocArr.this(i);
+}
+
 //
 // the global accessor for the array
 //
@@ -1561,6 +1561,25 @@ proc BlockDom.dsiLocalSubdomain() {
   return myLocDom.myBlock;
 }
 
+//
+// Parallel scan, see ChapelReduce.  Each locale scans its own block,
+// whose elements follow those of the locales before it in targetLocDom
+// (or after, if the domain runs backwards).
+//
+proc BlockArr.dsiScan(op, res) where rank == 1 {
+  const locRange = dom.dist.targetLocDom.dim(1);
+  const backwards = dom.whole.dim(1).stride < 0;
+  var prefixes: [0..#locRange.length] sync op.type;
+
+  coforall locIdx in locRange do on locArr(locIdx) {
+    const part = if backwards then locRange.length - 1 - locRange.indexOrder(locIdx)
+                 else locRange.indexOrder(locIdx);
+    chpl__scanPart(op, locArr(locIdx).myElems._value,
+                   res.locArr(locIdx).myElems._value,
+                   locArr(locIdx).locDom.myBlock.dim(1), part, prefixes);
+  }
+}
+
 iter ConsecutiveChunks(LView, RDomClass, RView, len, in start) {
   var elemsToGet = len;
   const offset   = RView.low - LView.low;
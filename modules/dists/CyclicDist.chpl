@@ -789,6 +789,10 @@ inline proc _remoteAccessData.getDataIndex(
   }
 }
 
+inline proc CyclicArr.dsiLocalAccess(i: rank*idxType) ref {
+  return myLocArr.this(i);
+}
+
 proc CyclicArr.dsiAccess(i:rank*idxType) ref {
   local {
     if myLocArr != nil && myLocArr.locDom.member(i) then
@@ -1212,3 +1216,34 @@ proc CyclicDom.dsiLocalSubdomain() {
   }
   return myLocDom.myBlock;
 }
+
+//
+// Parallel scan, see ChapelReduce.  A locale's elements are spread out
+// over the whole array, so instead of scanning those, each locale scans
+// a run of consecutive elements, copying them in from and the results
+// out to the locales that own them.
+//
+proc CyclicArr.dsiScan(op, res) where rank == 1 {
+  const inds = dom.whole.dim(1);
+  const locRange = dom.dist.targetLocDom.dim(1);
+  var prefixes: [0..#locRange.length] sync op.type;
+
+  coforall locIdx in locRange do on dom.dist.targetLocs(locIdx) {
+    const part = locRange.indexOrder(locIdx);
+    const myInds = chpl__scanBlockInds(inds, locRange.length, part);
+    var myData: [myInds] eltType;
+    var myRes: [myInds] res.eltType;
+
+    for srcIdx in locRange {
+      const sect = myInds[locArr(srcIdx).locDom.myBlock.dim(1)];
+      myData[sect] = locArr(srcIdx).myElems[sect];
+    }
+
+    chpl__scanPart(op, myData._value, myRes._value, myInds, part, prefixes);
+
+    for dstIdx in locRange {
+      const sect = myInds[res.locArr(dstIdx).locDom.myBlock.dim(1)];
+      res.locArr(dstIdx).myElems[sect] = myRes[sect];
+    }
+  }
+}
@@ -30,7 +30,15 @@ module ChapelReduce {
     delete op;
   }
 
-  iter chpl__scanIterator(op, data) {
+  proc chpl__scanIterator(op, data) {
+    if chpl__scanIsParallel(op, data) {
+      return chpl__scanParallel(op, data);
+    } else {
+      return chpl__scanIteratorSerial(op, data);
+    }
+  }
+
+  iter chpl__scanIteratorSerial(op, data) {
     for e in data {
       op.accumulate(e);
       yield op.generate();
@@ -38,6 +46,122 @@ module ChapelReduce {
     delete op;
   }
 
+  //
+  // Scans of 1-D arrays whose domain map provides dsiScan() are done in
+  // parallel, and return an array over the same domain.  The data is
+  // split into blocks, one per task.  The first pass accumulates each
+  // block into its own clone of the op.  Combining those in order
+  // gives the state before each block, and the second pass starts from
+  // that and accumulates the block again, storing the scanned values.
+  // This only needs clone() and combine() on top of what a serial scan
+  // needs, and gives the same results as long as combining two ops
+  // matches accumulating the second one's elements onto the first.
+  //
+  proc chpl__scanIsParallel(op, data) param {
+    use Reflection;
+    if !isArray(data) then
+      return false;
+    else if data.rank != 1 then
+      return false;
+    else
+      return canResolveMethod(op, "clone") &&
+             canResolveMethod(op, "combine", op) &&
+             canResolveMethod(data._value, "dsiScan", op, data._value);
+  }
+
+  proc chpl__scanParallel(op, data) {
+    type resType = op.generate().type;
+    var res: [data.domain] resType;
+    data._value.dsiScan(op, res._value);
+    delete op;
+    return res;
+  }
+
+  // The first pass over the elements 'inds' of the local array 'data'.
+  proc chpl__scanBlockOps(op, data, inds: range(?)) {
+    use DSIUtil;
+    const numTasks = if __primitive("task_get_serial") then 1
+                     else _computeNumChunks(inds.length);
+    var blockOps: [0..#numTasks] op.type;
+
+    coforall t in 0..#numTasks {
+      const blockOp = op.clone();
+      for i in chpl__scanBlockInds(inds, numTasks, t) do
+        blockOp.accumulate(data.dsiAccess(i));
+      blockOps[t] = blockOp;
+    }
+    return blockOps;
+  }
+
+  // The second pass, storing into the local array 'res'.  'pre' holds
+  // the state before the first element of 'inds'.
+  proc chpl__scanBlocks(pre, blockOps, data, res, inds: range(?)) {
+    const numTasks = blockOps.numElements;
+    var blockPres: [0..#numTasks] pre.type;
+
+    for t in 0..#numTasks {
+      blockPres[t] = pre.clone();
+      blockPres[t].combine(pre);
+      pre.combine(blockOps[t]);
+    }
+
+    coforall t in 0..#numTasks {
+      const blockPre = blockPres[t];
+      const blockInds = chpl__scanBlockInds(inds, numTasks, t);
+      if chpl__testParFlag then
+        chpl__testPar("scan block invoked on ", blockInds);
+      for i in blockInds {
+        blockPre.accumulate(data.dsiAccess(i));
+        res.dsiAccess(i) = blockPre.generate();
+      }
+      delete blockPre;
+    }
+  }
+
+  // Scan all of a local array.
+  proc chpl__scanLocal(op, data, res, inds: range(?)) {
+    const blockOps = chpl__scanBlockOps(op, data, inds);
+    const pre = op.clone();
+    chpl__scanBlocks(pre, blockOps, data, res, inds);
+    delete pre;
+    for blockOp in blockOps do delete blockOp;
+  }
+
+  //
+  // Scan the local arrays holding one part of a distributed scan, on
+  // the locale they are on.  'part' is this part's position in the
+  // order of the scan, and 'prefixes' hands each part's end state on
+  // to the next part.
+  //
+  proc chpl__scanPart(op, data, res, inds: range(?), part, prefixes) {
+    const blockOps = chpl__scanBlockOps(op, data, inds);
+    const pre = op.clone();
+
+    if part > prefixes.domain.low {
+      const prev = prefixes[part-1].readFE();
+      pre.combine(prev);
+      delete prev;
+    }
+    if part < prefixes.domain.high {
+      const next = op.clone();
+      next.combine(pre);
+      for blockOp in blockOps do next.combine(blockOp);
+      prefixes[part].writeEF(next);
+    }
+
+    chpl__scanBlocks(pre, blockOps, data, res, inds);
+    delete pre;
+    for blockOp in blockOps do delete blockOp;
+  }
+
+  // The indices of 'inds' that block 'b' of 'numBlocks' covers.
+  proc chpl__scanBlockInds(inds: range(?), numBlocks, b) {
+    use DSIUtil;
+    const (lo, hi) = _computeBlock(inds.length, numBlocks, b,
+                                   inds.length-1, 0, 0);
+    return inds#(hi+1)#-(hi-lo+1);
+  }
+
   proc chpl__reduceCombine(globalOp, localOp) {
     on globalOp {
       globalOp.lock();
@@ -51,6 +51,13 @@ module DefaultAssociative {
    27021597764222939, 54043195528445869, 108086391056891903, 216172782113783773,
    432345564227567561, 864691128455135207);
 
+  // Parallel-safe domains split their table into up to this many
+  // independently locked stripes (a power of two). The number of stripes
+  // only grows once each stripe would have at least
+  // chpl__assocMinStripeSize slots, so small domains use a single stripe.
+  config param defaultAssocMaxStripes = 64;
+  param chpl__assocMinStripeSize = 383;
+
   class DefaultAssociativeDom: BaseAssociativeDom {
     type idxType;
     param parSafe: bool;
@@ -59,22 +66,63 @@ module DefaultAssociative {
   
     // The guts of the associative domain
   
+    // The table is divided into numStripes stripes of stripeSize slots
+    // each. An index hashes to one stripe and is only ever probed for
+    // within it, so in a parSafe domain, adds, removes and lookups in
+    // different stripes can run in parallel, each holding only its
+    // stripe's lock. Anything that changes the layout of the whole table
+    // (resizing or clearing it) holds tableLock exclusively instead.
+    // Non-parSafe domains always use a single stripe.
+    //
     // We explicitly use processor atomics here since this is not
     // by design a distributed data structure
     var numEntries: atomic_int64;
-    var tableLock: atomicbool; // do not access directly, use function below
-    var tableSizeNum = 1;
-    var tableSize = chpl__primes(tableSizeNum);
+    var tableLock: atomicbool; // do not access directly, use functions below
+    var tableUsers: atomic_int64; // tasks between enter/leaveTableShared
+    var tableSizeNum = 1; // stripeSize == chpl__primes(tableSizeNum)
+    var stripeBits = 0; // numStripes == 1 << stripeBits
+    var numStripes = 1;
+    var stripeSize = chpl__primes(tableSizeNum);
+    var tableSize = stripeSize;
     var tableDom = {0..tableSize-1};
     var table: [tableDom] chpl_TableEntry(idxType);
-  
+    var stripeDom = {0..#(if parSafe then numStripes else 0)};
+    var stripeLocks: [stripeDom] atomicbool;
+    var stripeCounts: [stripeDom] int; // entries in each stripe
+
+    // Take the table for exclusive use, waiting for any tasks using it in
+    // shared mode to finish.
     inline proc lockTable() {
       while tableLock.testAndSet() do chpl_task_yield();
+      while tableUsers.read() != 0 do chpl_task_yield();
     }
   
     inline proc unlockTable() {
       tableLock.clear();
     }
+
+    // Use the table in shared mode, which keeps its layout from changing.
+    // Tasks in shared mode must lock a stripe before touching it.
+    inline proc enterTableShared() {
+      while true {
+        while tableLock.read() do chpl_task_yield();
+        tableUsers.add(1);
+        if !tableLock.read() then return;
+        tableUsers.sub(1);
+      }
+    }
+
+    inline proc leaveTableShared() {
+      tableUsers.sub(1);
+    }
+
+    inline proc lockStripe(stripe: int) {
+      while stripeLocks[stripe].testAndSet() do chpl_task_yield();
+    }
+
+    inline proc unlockStripe(stripe: int) {
+      stripeLocks[stripe].clear();
+    }
   
     // TODO: An ugly [0..-1] domain appears several times in the code --
     //       replace with a named constant/param?
@@ -129,9 +177,9 @@ module DefaultAssociative {
         yield i;
       on this {
         postponeResize = false;
-        if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+        if _shouldShrink() {
           if parSafe then lockTable();
-          if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
+          if _shouldShrink() {
             _resize(grow=false);
           }
           if parSafe then unlockTable();
@@ -273,6 +321,7 @@ module DefaultAssociative {
           table[slot].status = chpl__hash_status.empty;
         }
         numEntries.write(0);
+        if parSafe then stripeCounts = 0;
         if parSafe then unlockTable();
       }
     }
@@ -305,40 +354,65 @@ module DefaultAssociative {
       const inSlot = slotNum;
       var retVal = 0;
       on this {
-        const shouldLock = needLock && parSafe;
-        if shouldLock then lockTable();
-        var findAgain = shouldLock;
-        if ((numEntries.read()+1)*2 > tableSize) {
-          _resize(grow=true);
-          findAgain = true;
+        const h = chpl__defaultHashWrapper(idx):uint;
+        if needLock && parSafe {
+          // Usually the index's stripe has room and we only need to
+          // lock that stripe.
+          enterTableShared();
+          const stripe = _stripeFor(h);
+          lockStripe(stripe);
+          const hasRoom = _stripeHasRoom(stripe);
+          if hasRoom then
+            (slotNum, retVal) = _add(idx, h, -1);
+          unlockStripe(stripe);
+          leaveTableShared();
+
+          // Otherwise grow the table (unless another task beat us to it)
+          // and add the index while we have it to ourselves.
+          if !hasRoom {
+            lockTable();
+            if !_stripeHasRoom(_stripeFor(h)) then
+              _resize(grow=true);
+            (slotNum, retVal) = _add(idx, h, -1);
+            unlockTable();
+          }
+        } else {
+          var findAgain = false;
+          if !_stripeHasRoom(_stripeFor(h)) {
+            _resize(grow=true);
+            findAgain = true;
+          }
+          if findAgain then
+            (slotNum, retVal) = _add(idx, h, -1);
+          else
+            (slotNum, retVal) = _add(idx, h, inSlot);
         }
-        if findAgain then
-          (slotNum, retVal) = _add(idx, -1);
-        else
-          (_, retVal) = _add(idx, inSlot);
-        if shouldLock then unlockTable();
+        if slotNum == -1 then
+          halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
       }
       return (slotNum, retVal);
     }
 
     // This routine adds new indices without checking the table size and
-    //  is thus appropriate for use by routines like _resize().
+    //  is thus appropriate for use by routines like _resize(). h is the
+    //  index's hash. Returns -1 for the slot if there was no room.
     //
-    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    // NOTE: Calls to this routine assume that the tableLock has been
+    // acquired, or (if parSafe) that the index's stripe has been locked
+    // after entering the table in shared mode.
     //
-    proc _add(idx: idxType, in slotNum : index(tableDom) = -1) {
+    proc _add(idx: idxType, h: uint, in slotNum : index(tableDom) = -1) {
       var foundSlot : bool = (slotNum != -1);
       if !foundSlot then
-        (foundSlot, slotNum) = _findEmptySlot(idx);
+        (foundSlot, slotNum) = _findEmptySlot(idx, h);
       if foundSlot {
         table[slotNum].status = chpl__hash_status.full;
         table[slotNum].idx = idx;
         numEntries.add(1);
+        if parSafe then stripeCounts[_stripeFor(h)] += 1;
       } else {
-        if (slotNum < 0) {
-          halt("couldn't add ", idx, " -- ", numEntries.read(), " / ", tableSize, " taken");
+        if (slotNum < 0) then
           return (-1, 0);
-        }
         // otherwise, re-adding an index that's already in there
         return (slotNum, 0);
       }
@@ -348,20 +422,31 @@ module DefaultAssociative {
     proc dsiRemove(idx: idxType) {
       var retval = 1;
       on this {
-        if parSafe then lockTable();
-        const (foundSlot, slotNum) = _findFilledSlot(idx, needLock=!parSafe);
+        const h = chpl__defaultHashWrapper(idx):uint;
+        if parSafe then enterTableShared();
+        const stripe = _stripeFor(h);
+        if parSafe then lockStripe(stripe);
+        const (foundSlot, slotNum) = _findFilledSlotHashed(idx, h);
         if (foundSlot) {
           for a in _arrs do
             a.clearEntry(idx);
           table[slotNum].status = chpl__hash_status.deleted;
           numEntries.sub(1);
+          if parSafe then stripeCounts[stripe] -= 1;
         } else {
           retval = 0;
         }
-        if (numEntries.read()*8 < tableSize && tableSizeNum > 1) {
-          _resize(grow=false);
+        if parSafe {
+          unlockStripe(stripe);
+          leaveTableShared();
+        }
+        if _shouldShrink() {
+          if parSafe then lockTable();
+          if _shouldShrink() {
+            _resize(grow=false);
+          }
+          if parSafe then unlockTable();
         }
-        if parSafe then unlockTable();
       }
       return retval;
     }
@@ -371,12 +456,24 @@ module DefaultAssociative {
 
       if entries < numKeys {
 
-        //Find the first suitable prime
         var threshold = (numKeys + 1) * 2;
+
+        // Use as many stripes as we would have grown to, leaving some
+        // slack for the entries not spreading evenly over them.
+        var stripes = 1;
+        if parSafe {
+          while stripes < defaultAssocMaxStripes &&
+                threshold / (stripes*2) >= chpl__assocMinStripeSize do
+            stripes *= 2;
+          if stripes > 1 then
+            threshold += threshold / 4;
+        }
+
+        //Find the first suitable prime
         var prime = 0;
         var primeLoc = 0;
         for i in 1..chpl__primes.size {
-            if chpl__primes(i) > threshold {
+            if chpl__primes(i) * stripes > threshold {
               prime = chpl__primes(i);
               primeLoc = i;
               break;
@@ -398,28 +495,17 @@ module DefaultAssociative {
           var copyDom = tableDom;
           var copyTable: [copyDom] chpl_TableEntry(idxType) = table;
 
-          // Do not preserve entries
-          tableDom = {0..-1};
-
-          tableSizeNum = primeLoc;
-          tableSize = prime;
-          tableDom = {0..tableSize-1};
-
-          //numEntries will be reconstructed as keys are readded
-          numEntries.write(0);
-
           // insert old data into newly resized table
-          for slot in _fullSlots(copyTable) {
-            const (newslot, _) = _add(copyTable[slot].idx);
-            _preserveArrayElements(oldslot=slot, newslot=newslot);
+          while !_rehash(copyTable, primeLoc, stripes) {
+            primeLoc += 1;
+            if primeLoc > chpl__primes.size then
+              halt("Requested capacity (", numKeys, ") exceeds maximum size");
           }
             
           _removeArrayBackups();
         } else {
           //Fast path, nothing to backup
-          tableSizeNum=primeLoc;
-          tableSize=prime;
-          tableDom = {0..tableSize-1};
+          _setTableSize(primeLoc, stripes);
         }
 
         //Unlock the table
@@ -445,6 +531,88 @@ module DefaultAssociative {
   
     //
     // Internal interface (private)
+    //
+
+    // Which stripe an index with hash h lives in. This uses Fibonacci
+    // hashing so that it depends on the high bits of h, while the probe
+    // within the stripe (h % stripeSize) mostly depends on the low ones.
+    inline proc _stripeFor(h: uint): int {
+      if stripeBits == 0 then return 0;
+      return ((h * 0x9E3779B97F4A7C15) >> (64 - stripeBits):uint):int;
+    }
+
+    // Can we add another index to this stripe and keep it at most half
+    // full? Quadratic probing needs that to be sure to find an open slot.
+    inline proc _stripeHasRoom(stripe: int) {
+      const count = if parSafe then stripeCounts[stripe]
+                    else numEntries.read();
+      return (count+1)*2 <= stripeSize;
+    }
+
+    inline proc _shouldShrink() {
+      return numEntries.read()*8 < tableSize &&
+             (tableSizeNum > 1 || numStripes > 1);
+    }
+
+    //
+    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    //
+    proc _setTableSize(sizeNum: int, stripes: int) {
+      tableDom = {0..(-1:chpl_table_index_type)}; // non-preserving resize
+      tableSizeNum = sizeNum;
+      numStripes = stripes;
+      stripeBits = 0;
+      while (1 << stripeBits) < stripes do
+        stripeBits += 1;
+      stripeSize = chpl__primes(tableSizeNum);
+      tableSize = numStripes * stripeSize;
+      tableDom = {0..tableSize-1};
+      numEntries.write(0);
+      if parSafe {
+        stripeDom = {0..#numStripes};
+        stripeCounts = 0;
+      }
+    }
+
+    // Resize the table and insert the entries of copyTable into it.
+    // Returns false if some stripe ran out of room, which can happen
+    // when entries spread unevenly over the stripes.
+    //
+    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    //
+    proc _rehash(copyTable, sizeNum: int, stripes: int): bool {
+      _setTableSize(sizeNum, stripes);
+
+      if parSafe && numStripes > 1 {
+        // Rehash in parallel; tasks adding to the same stripe take turns.
+        var failed: atomicbool;
+        forall slot in copyTable.domain {
+          if copyTable[slot].status == chpl__hash_status.full {
+            const idx = copyTable[slot].idx;
+            const h = chpl__defaultHashWrapper(idx):uint;
+            const stripe = _stripeFor(h);
+            lockStripe(stripe);
+            const (newslot, _) = _add(idx, h);
+            unlockStripe(stripe);
+            if newslot == -1 then
+              failed.write(true);
+            else
+              _preserveArrayElements(oldslot=slot, newslot=newslot);
+          }
+        }
+        return !failed.read();
+      } else {
+        for slot in _fullSlots(copyTable) {
+          const idx = copyTable[slot].idx;
+          const (newslot, _) = _add(idx, chpl__defaultHashWrapper(idx):uint);
+          if newslot == -1 then
+            return false;
+          _preserveArrayElements(oldslot=slot, newslot=newslot);
+        }
+        return true;
+      }
+    }
+
     //
     // NOTE: Calls to this routine assume that the tableLock has been acquired.
     //
@@ -457,18 +625,29 @@ module DefaultAssociative {
       var copyDom = tableDom;
       var copyTable: [copyDom] chpl_TableEntry(idxType) = table;
   
-      // grow original table
-      tableDom = {0..(-1:chpl_table_index_type)}; // non-preserving resize
-      numEntries.write(0); // reset, because the adds below will re-set this
-      tableSizeNum += if grow then 1 else -1;
-      if tableSizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
-      tableSize = chpl__primes(tableSizeNum);
-      tableDom = {0..tableSize-1};
-  
+      // Growing a parSafe table adds stripes until there are enough of
+      // them, and after that makes the stripes bigger. Shrinking undoes
+      // that in the opposite order.
+      var sizeNum = tableSizeNum;
+      var stripes = numStripes;
+      if grow {
+        if parSafe && stripes < defaultAssocMaxStripes &&
+           stripeSize >= chpl__assocMinStripeSize then
+          stripes *= 2;
+        else
+          sizeNum += 1;
+      } else {
+        if stripes > 1 then
+          stripes /= 2;
+        else
+          sizeNum -= 1;
+      }
+
       // insert old data into newly resized table
-      for slot in _fullSlots(copyTable) {
-        const (newslot, _) = _add(copyTable[slot].idx);
-        _preserveArrayElements(oldslot=slot, newslot=newslot);
+      while true {
+        if sizeNum > chpl__primes.size then halt("associative array exceeds maximum size");
+        if _rehash(copyTable, sizeNum, stripes) then break;
+        sizeNum += 1;
       }
       
       _removeArrayBackups();
@@ -479,34 +658,49 @@ module DefaultAssociative {
     // Returns true if found, along with the first open slot that may be
     // re-used for faster addition to the domain
     proc _findFilledSlot(idx: idxType, needLock = true) : (bool, index(tableDom)) {
-      if parSafe && needLock then lockTable();
+      const h = chpl__defaultHashWrapper(idx):uint;
+      if parSafe && needLock {
+        enterTableShared();
+        const stripe = _stripeFor(h);
+        lockStripe(stripe);
+        const ret = _findFilledSlotHashed(idx, h);
+        unlockStripe(stripe);
+        leaveTableShared();
+        return ret;
+      }
+      return _findFilledSlotHashed(idx, h);
+    }
+
+    //
+    // NOTE: Calls to this routine assume that the table or the index's
+    // stripe is locked, if that's needed.
+    //
+    proc _findFilledSlotHashed(idx: idxType, h: uint) : (bool, index(tableDom)) {
       var firstOpen = -1;
-      for slotNum in _lookForSlots(idx, table.domain.high+1) {
+      for slotNum in _lookForSlots(h) {
         const slotStatus = table[slotNum].status;
         // if we encounter a slot that's empty, our element could not
         // be found past this point.
         if (slotStatus == chpl__hash_status.empty) {
           if firstOpen == -1 then firstOpen = slotNum;
-          if parSafe && needLock then unlockTable();
           return (false, firstOpen);
         } else if (slotStatus == chpl__hash_status.full) {
           if (table[slotNum].idx == idx) {
-            if parSafe && needLock then unlockTable();
             return (true, slotNum);
           }
         } else { // this entry was removed, but is the first slot we could use
           if firstOpen == -1 then firstOpen = slotNum;
         }
       }
-      if parSafe && needLock then unlockTable();
       return (false, -1);
     }
 
     //
-    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    // NOTE: Calls to this routine assume that the tableLock has been
+    // acquired, or that the index's stripe has been locked.
     //
-    proc _findEmptySlot(idx: idxType): (bool, index(tableDom)) {
-      for slotNum in _lookForSlots(idx) {
+    proc _findEmptySlot(idx: idxType, h: uint): (bool, index(tableDom)) {
+      for slotNum in _lookForSlots(h) {
         const slotStatus = table[slotNum].status;
         if (slotStatus == chpl__hash_status.empty ||
             slotStatus == chpl__hash_status.deleted) {
@@ -519,18 +713,20 @@ module DefaultAssociative {
     }
       
     //
-    // NOTE: Calls to this routine assume that the tableLock has been acquired.
+    // NOTE: Calls to this routine assume that the tableLock has been
+    // acquired, or that the index's stripe has been locked.
     //
-    // NOTE: A copy of this routine is tested in
+    // NOTE: A copy of the probing within a stripe is tested in
     //    test/associative/ferguson/check-look-for-slots.chpl
     // So, when updating this routine, either refactor so the test
     // can use the below code - or update the test in a corresponding manner.
-    iter _lookForSlots(idx: idxType, numSlots = tableSize) {
-      const baseSlot = chpl__defaultHashWrapper(idx):uint;
-      for probe in 0..numSlots/2 {
+    iter _lookForSlots(h: uint) {
+      const stripeStart = _stripeFor(h) * stripeSize;
+      const baseSlot = h;
+      for probe in 0..stripeSize/2 {
         var uprobe = probe:uint;
-        var n = numSlots:uint;
-        yield ((baseSlot + uprobe**2)%n):int;
+        var n = stripeSize:uint;
+        yield stripeStart + ((baseSlot + uprobe**2)%n):int;
       }
     }
   
@@ -1547,7 +1547,17 @@ module DefaultRectangular {
       const size = blk(1) * dom.dsiDim(1).length;
 
       if defRectSimpleDData {
-        data = _ddata_allocate(eltType, size);
+        //
+        // With sublocales, bind each one's share of the data to it up
+        // front.  Foralls over the array divide it among the sublocales
+        // the same way, and unlike relying on first touch this also
+        // holds when the allocator hands back pages touched earlier.
+        //
+        data = _ddata_allocate(eltType, size,
+                               locStyle = if !localeModelHasSublocales
+                                             || here.maxTaskPar < 2
+                                          then localizationStyle_t.locNone
+                                          else localizationStyle_t.locSubchunks);
       } else {
         //
         // Checking the size first (and having a large-ish size hurdle)
@@ -1598,19 +1608,29 @@ module DefaultRectangular {
                                        else localizationStyle_t.locSubchunks);
         } else {
           var dataOff: idxType = 0;
-          for i in 0..#mdNumChunks do local on here.getChild(i) {
+          for i in 0..#mdNumChunks {
             mData(i).dataOff = dataOff;
             const (lo, hi) = mdChunk2Ind(i);
             if stridable then
               mData(i).pdr = lo..hi by dom.dsiDim(mdParDim).stride align dom.dsiDim(mdParDim).alignment;
             else
               mData(i).pdr = lo..hi;
+            dataOff += size / mdRLen * mData(i).pdr.length;
+          }
+
+          //
+          // Allocate and initialize the chunks concurrently, each from
+          // its own sublocale, so that the element initialization also
+          // touches each chunk's pages from the NUMA domain they belong
+          // to.
+          //
+          coforall i in 0..#mdNumChunks do local on here.getChild(i) {
             const chunkSize = size / mdRLen * mData(i).pdr.length;
             const dd = _ddata_allocate(eltType, chunkSize,
                                        locStyle = localizationStyle_t.locWhole,
                                        subloc = i:chpl_sublocID_t);
-            mData(i).data = _ddata_shift(eltType, dd, -dataOff:idxSignedType);
-            dataOff += chunkSize;
+            mData(i).data = _ddata_shift(eltType, dd,
+                                         -mData(i).dataOff:idxSignedType);
           }
         }
       }
@@ -1764,6 +1784,11 @@ module DefaultRectangular {
     where shouldReturnRvalueByConstRef(eltType)
       return dsiAccess(i);
 
+    // parallel scan, see ChapelReduce
+    proc dsiScan(op, res) where rank == 1 {
+      chpl__scanLocal(op, this, res, dom.dsiDim(1));
+    }
+
     proc adjustBlkOffStrForNewDomain(d: DefaultRectangularDom,
                                      alias: DefaultRectangularArr)
     {
@@ -30,7 +30,13 @@ module MemTracking
     memLeaks: bool = false,
     memMax: uint = 0,
     memThreshold: uint = 0,
-    memLog: string;
+    memLog: string,
+    memSampleRate: uint = 0,
+    memSampleInterval: uint = 0;
+
+  pragma "no auto destroy"
+  config const
+    memSampleLog: string;
 
   pragma "no auto destroy"
   config const
@@ -55,7 +61,9 @@ module MemTracking
 
   // Safely cast to size_t instances of memMax and memThreshold.
   const cMemMax = memMax.safeCast(size_t),
-    cMemThreshold = memThreshold.safeCast(size_t);
+    cMemThreshold = memThreshold.safeCast(size_t),
+    cMemSampleRate = memSampleRate.safeCast(size_t),
+    cMemSampleInterval = memSampleInterval.safeCast(size_t);
 
   //
   // This communicates the settings of the various memory tracking
@@ -66,8 +74,8 @@ module MemTracking
   // locale from the runtime.  Recall that c_string is considered a
   // local-only data type, so we must use some tricks to copy the
   // c_string from locale 0 to the remote locales.  We use the globals
-  // s_memLog and s_memLeaksLog to create global Chapel strings to
-  // make them available to all locales.
+  // s_memLog, s_memLeaksLog and s_memSampleLog to create global Chapel
+  // strings to make them available to all locales.
   //
   export
   proc chpl_memTracking_returnConfigVals(ref ret_memTrack: bool,
@@ -78,13 +86,18 @@ module MemTracking
                                          ref ret_memMax: size_t,
                                          ref ret_memThreshold: size_t,
                                          ref ret_memLog: c_string,
-                                         ref ret_memLeaksLog: c_string) {
+                                         ref ret_memLeaksLog: c_string,
+                                         ref ret_memSampleRate: size_t,
+                                         ref ret_memSampleInterval: size_t,
+                                         ref ret_memSampleLog: c_string) {
     ret_memTrack = memTrack;
     ret_memStats = memStats;
     ret_memLeaksByType = memLeaksByType;
     ret_memLeaks = memLeaks;
     ret_memMax = cMemMax;
     ret_memThreshold = cMemThreshold;
+    ret_memSampleRate = cMemSampleRate;
+    ret_memSampleInterval = cMemSampleInterval;
 
     if (here.id != 0) {
       if memLeaksByDesc.length != 0 {
@@ -114,10 +127,20 @@ module MemTracking
         ret_memLeaksLog = nil;
       }
 
+      if memSampleLog.length != 0 {
+        var local_memSampleLog = memSampleLog;
+        // Intentionally leak the string to persist the underlying buffer
+        local_memSampleLog.owned = false;
+        ret_memSampleLog = local_memSampleLog.c_str();
+      } else {
+        ret_memSampleLog = nil;
+      }
+
      } else {
       ret_memLeaksByDesc = memLeaksByDesc.c_str();
       ret_memLog = memLog.c_str();
       ret_memLeaksLog = memLeaksLog.c_str();
+      ret_memSampleLog = memSampleLog.c_str();
     }
   }
 }
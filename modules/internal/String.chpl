@@ -22,6 +22,12 @@
  *
  * - An empty string is represented by len == 0 and buff == nil.
  *
+ * - A string shorter than chpl_string_small_size bytes is usually kept in
+ *   the record itself, in _small, and then also has buff == nil.  Such a
+ *   string isn't tied to any locale: its bytes go wherever the record is
+ *   copied.  stringBuff() returns a pointer to the bytes of a local string
+ *   either way, and getStringBytes() copies them out of any string.
+ *
  * - It is assumed the bufferType is a local-only type, so we never
  *   make a remote copy of one passed in by the user, though remote
  *   copies are made of internal bufferType variables.
@@ -68,7 +74,9 @@ module String {
   // Externs and constants used to implement strings
   //
 
-  private        param chpl_string_min_alloc_size: int = 16;
+  // Strings shorter than this are kept in the record, with a terminating
+  // NUL, so that making or copying them never allocates.
+  private        param chpl_string_small_size: int = 16;
 
   // TODO (EJR: 02/25/16): see if we can remove this explicit type declaration.
   // chpl_mem_descInt_t is really a well known compiler type since the compiler
@@ -95,6 +103,53 @@ module String {
       return dest;
   }
 
+  private extern proc string_find_bytes(haystack: bufferType, hLen: int,
+                                        needle: bufferType, nLen: int): int;
+  private extern proc string_rfind_bytes(haystack: bufferType, hLen: int,
+                                         needle: bufferType, nLen: int): int;
+
+  // Returns a pointer to the bytes of s, which must be a string record on
+  // this locale whose bytes are too (see localize()).  The pointer is only
+  // good for as long as s is.
+  pragma "suppress lvalue error"
+  private inline proc stringBuff(const ref s: string): bufferType {
+    if s.buff == nil then
+      return c_ptrTo(s._small): bufferType;
+    return s.buff;
+  }
+
+  // Copies len bytes of s, starting at offset, to the local buffer dest.
+  // s can be any string: a remote one, or a copy of one.
+  private inline proc getStringBytes(dest: bufferType, const ref s: string,
+                                     offset: int, len: int) {
+    if s.buff == nil {
+      var small = s._small;
+      c_memcpy(dest, c_ptrTo(small): bufferType + offset, len);
+    } else if _local || s.locale_id == chpl_nodeID {
+      c_memcpy(dest, s.buff + offset, len);
+    } else {
+      chpl_string_comm_get(dest, s.locale_id, s.buff + offset, len);
+    }
+  }
+
+  // Makes ret, a new local string, len bytes long and returns a pointer to
+  // where its bytes go.  The terminating NUL is already there.
+  private inline proc allocStringBuff(ref ret: string, len: int): bufferType {
+    ret.len = len;
+    if len < chpl_string_small_size {
+      const p = c_ptrTo(ret._small): bufferType;
+      p[len] = 0;
+      return p;
+    }
+    const allocSize = chpl_here_good_alloc_size(len+1);
+    ret._size = allocSize;
+    ret.buff = chpl_here_alloc(allocSize,
+                               CHPL_RT_MD_STR_COPY_DATA): bufferType;
+    ret.buff[len] = 0;
+    ret.owned = true;
+    return ret.buff;
+  }
+
   private config param debugStrings = false;
 
   //
@@ -115,6 +170,8 @@ module String {
     pragma "no doc"
     var owned: bool = true;
     pragma "no doc"
+    var _small: (chpl_string_small_size/8)*uint(64); // bytes of short strings
+    pragma "no doc"
     // We use chpl_nodeID as a shortcut to get at here.id without actually constructing
     // a locale object. Used when determining if we should make a remote transfer.
     var locale_id = chpl_nodeID; // : chpl_nodeID_t
@@ -134,7 +191,14 @@ module String {
       // Don't need to do anything if s is an empty string
       if sLen != 0 {
         this.len = sLen;
-        if !_local && sRemote {
+        if s.buff == nil || (sLen < chpl_string_small_size &&
+                             (this.owned || (!_local && sRemote))) {
+          // short strings are always copied into the record
+          this.owned = true;
+          var small: this._small.type;
+          getStringBytes(c_ptrTo(small): bufferType, s, 0, sLen);
+          this._small = small;
+        } else if !_local && sRemote {
           // ignore supplied value of owned for remote strings so we don't leak
           this.owned = true;
           this.buff = copyRemoteBuffer(s.locale_id, s.buff, sLen);
@@ -189,7 +253,7 @@ module String {
 
     pragma "no doc"
     proc ref deinit() {
-      if owned && !this.isEmptyString() {
+      if owned && this.buff != nil {
         on __primitive("chpl_on_locale_num",
                        chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
           chpl_here_free(this.buff);
@@ -208,31 +272,42 @@ module String {
       // If the this.buff is longer than buf, then reuse the buffer if we are
       // allowed to (this.owned == true)
       if s_len != 0 {
-        if needToCopy {
+        if needToCopy && s_len < chpl_string_small_size {
+          // Short strings go in the record.  buf may be our own buffer,
+          // so copy it before freeing that.
+          var small: this._small.type;
+          c_memcpy(c_ptrTo(small): bufferType, buf, s_len);
+          if this.owned && this.buff != nil then
+            chpl_here_free(this.buff);
+          this.buff = nil;
+          this._size = 0;
+          this._small = small;
+          this.owned = true;
+        } else if needToCopy {
           if !this.owned || s_len+1 > this._size {
             // If the new string is too big for our current buffer or we dont
             // own our current buffer then we need a new one.
-            if this.owned && !this.isEmptyString() then
+            if this.owned && this.buff != nil then
               chpl_here_free(this.buff);
             // TODO: should I just allocate 'size' bytes?
             const allocSize = chpl_here_good_alloc_size(s_len+1);
             this.buff = chpl_here_alloc(allocSize,
                                        CHPL_RT_MD_STR_COPY_DATA):bufferType;
-            this.buff[s_len] = 0;
             this._size = allocSize;
             // We just allocated a buffer, make sure to free it later
             this.owned = true;
           }
           c_memmove(this.buff, buf, s_len);
+          this.buff[s_len] = 0;
         } else {
-          if this.owned && !this.isEmptyString() then
+          if this.owned && this.buff != nil then
             chpl_here_free(this.buff);
           this.buff = buf;
           this._size = size;
         }
       } else {
         // free the old buffer
-        if this.owned && !this.isEmptyString() then chpl_here_free(this.buff);
+        if this.owned && this.buff != nil then chpl_here_free(this.buff);
         this.buff = nil;
         this._size = 0;
       }
@@ -253,7 +328,7 @@ module String {
                  current locale, otherwise a deep copy is performed.
     */
     inline proc localize() : string {
-      if _local || this.locale_id == chpl_nodeID {
+      if _local || this.locale_id == chpl_nodeID || this.buff == nil {
         return new string(this, owned=false);
       } else {
         const x:string = this; // assignment makes it local
@@ -290,6 +365,9 @@ module String {
         return __primitive("cast", t, x);
       }
 
+      if this.buff == nil && this.len != 0 then
+        return stringBuff(this):c_string;
+
       if this.locale_id != chpl_nodeID then
         halt("Cannot call .c_str() on a remote string");
 
@@ -325,8 +403,7 @@ module String {
      */
     iter these() : string {
       for i in 1..this.len {
-        // This is pretty painful from a performance perspective right now,
-        // allocates w/ every yield
+        // Each character is a short string, so this doesn't allocate
         yield this[i];
       }
     }
@@ -342,21 +419,7 @@ module String {
         then halt("index out of bounds of string: ", i);
 
       var ret: string;
-      const newSize = chpl_here_good_alloc_size(2);
-      ret._size = max(chpl_string_min_alloc_size, newSize);
-      ret.len = 1;
-      ret.buff = chpl_here_alloc(ret._size,
-                                CHPL_RT_MD_STR_COPY_DATA): bufferType;
-      ret.owned = true;
-
-      const remoteThis = this.locale_id != chpl_nodeID;
-      if remoteThis {
-        chpl_string_comm_get(ret.buff, this.locale_id, this.buff + i - 1, 1);
-      } else {
-        ret.buff[0] = this.buff[i-1];
-      }
-      ret.buff[1] = 0;
-
+      getStringBytes(allocStringBuff(ret, 1), this, i-1, 1);
       return ret;
     }
 
@@ -401,32 +464,20 @@ module String {
         // TODO: I can't just return "" (ret var gets freed for some reason)
         ret = "";
       } else {
-        ret.len = r2.size:int;
-        const newSize = chpl_here_good_alloc_size(ret.len+1);
-        ret._size = max(chpl_string_min_alloc_size, newSize);
-        // FIXME: I was dumb here, just copy the correct region over in
-        // multi-locale and use that as the string buffer. No need to copy stuff
-        // about after pulling it across.
-        ret.buff = chpl_here_alloc(ret._size,
-                                  CHPL_RT_MD_STR_COPY_DATA): bufferType;
-
-        var thisBuff: bufferType;
-        const remoteThis = this.locale_id != chpl_nodeID;
-        if remoteThis {
-          // TODO: Could do an optimization here and only pull down the data
-          // between r2.low and r2.high. Indexing for the copy below gets a bit
-          // more complex when that is performed though.
-          thisBuff = copyRemoteBuffer(this.locale_id, this.buff, this.len);
+        const retBuff = allocStringBuff(ret, r2.size:int);
+
+        if !r2.stridable {
+          getStringBytes(retBuff, this, r2.low:int-1, ret.len);
         } else {
-          thisBuff = this.buff;
-        }
+          // TODO: Could do an optimization here and only pull down the data
+          // between r2.low and r2.high for remote strings.
+          const localThis: string = this.localize();
+          const thisBuff = stringBuff(localThis);
 
-        for (r2_i, i) in zip(r2, 0..) {
-          ret.buff[i] = thisBuff[r2_i-1];
+          for (r2_i, i) in zip(r2, 0..) {
+            retBuff[i] = thisBuff[r2_i-1];
+          }
         }
-        ret.buff[ret.len] = 0;
-
-        if remoteThis then chpl_here_free(thisBuff);
       }
 
       return ret;
@@ -468,23 +519,24 @@ module String {
       var ret: bool = false;
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
         for needle in needles {
           if needle.isEmptyString() {
             ret = true;
             break;
           }
-          if needle.len > this.len then continue;
+          if needle.len > localThis.len then continue;
 
           const localNeedle: string = needle.localize();
 
-          const needleR = 0:int..#localNeedle.len;
           if fromLeft {
-            const result = c_memcmp(this.buff, localNeedle.buff,
+            const result = c_memcmp(thisBuff, stringBuff(localNeedle),
                                     localNeedle.len);
             ret = result == 0;
           } else {
-            var offset = this.len-localNeedle.len;
-            const result = c_memcmp(this.buff+offset, localNeedle.buff,
+            var offset = localThis.len-localNeedle.len;
+            const result = c_memcmp(thisBuff+offset, stringBuff(localNeedle),
                                     localNeedle.len);
             ret = result == 0;
           }
@@ -516,8 +568,9 @@ module String {
 
 
     // Helper function that uses a param bool to toggle between count and find
-    //TODO: this could be a much better string search
-    //      (Boyer-Moore-Horspool|any thing other than brute force)
+    // Searches of unstrided regions are done by string_find_bytes() and
+    // string_rfind_bytes() in the runtime, which use memchr() to skip ahead
+    // to the candidate positions.
     //
     pragma "no doc"
     inline proc _search_helper(needle: string, region: range(?),
@@ -555,29 +608,54 @@ module String {
 
         if localRet == -1 {
           localRet = 0;
+          const localThis: string = this.localize();
           const localNeedle: string = needle.localize();
-
-          // i *is not* an index into anything, it is the order of the element
-          // of view we are searching from.
-          const numPossible = thisLen - nLen + 1;
-          const searchSpace = if fromLeft
-              then 0..#(numPossible)
-              else 0..#(numPossible) by -1;
-          for i in searchSpace {
-            // j *is* the index into the localNeedle's buffer
-            for j in 0..#nLen {
-              const idx = view.orderToIndex(i+j); // 1s based idx
-              if this.buff[idx-1] != localNeedle.buff[j] then break;
-
-              if j == nLen-1 {
-                if count {
-                  localRet += 1;
-                } else { // find
-                  localRet = view.orderToIndex(i);
+          const thisBuff = stringBuff(localThis);
+          const needleBuff = stringBuff(localNeedle);
+
+          if !view.stridable {
+            const viewBuff = thisBuff + view.low:int - 1;
+            const viewLen = thisLen:int;
+            if count {
+              // Matches may overlap, so resume just past the last one
+              var start = 0;
+              while true {
+                const pos = string_find_bytes(viewBuff + start, viewLen - start,
+                                              needleBuff, nLen);
+                if pos < 0 then break;
+                localRet += 1;
+                start += pos + 1;
+              }
+            } else {
+              const pos = if fromLeft
+                then string_find_bytes(viewBuff, viewLen, needleBuff, nLen)
+                else string_rfind_bytes(viewBuff, viewLen, needleBuff, nLen);
+              if pos >= 0 then
+                localRet = view.orderToIndex(pos);
+            }
+          } else {
+            // i *is not* an index into anything, it is the order of the
+            // element of view we are searching from.
+            const numPossible = thisLen - nLen + 1;
+            const searchSpace = if fromLeft
+                then 0..#(numPossible)
+                else 0..#(numPossible) by -1;
+            for i in searchSpace {
+              // j *is* the index into the localNeedle's buffer
+              for j in 0..#nLen {
+                const idx = view.orderToIndex(i+j); // 1s based idx
+                if thisBuff[idx-1] != needleBuff[j] then break;
+
+                if j == nLen-1 {
+                  if count {
+                    localRet += 1;
+                  } else { // find
+                    localRet = view.orderToIndex(i);
+                  }
                 }
               }
+              if !count && localRet != 0 then break;
             }
-            if !count && localRet != 0 then break;
           }
         }
         ret = localRet;
@@ -633,23 +711,44 @@ module String {
       :returns: a copy of the string where `needle` replaces `replacement` up
                 to `count` times
      */
-    // TODO: not ideal - count and single allocation probably faster
-    //                 - can special case on replacement|needle.length (0, 1)
     proc replace(needle: string, replacement: string, count: int = -1) : string {
-      var result: string = this;
-      var found: int = 0;
-      var startIdx: int = 1;
+      const localThis: string = this.localize();
       const localNeedle: string = needle.localize();
       const localReplacement: string = replacement.localize();
+      const thisLen = localThis.len;
+      const nLen = localNeedle.len;
+      const rLen = localReplacement.len;
+      if nLen == 0 || count == 0 then return this;
 
-      while (count < 0) || (found < count) {
-        const idx = result.find(localNeedle, startIdx..);
-        if !idx then break;
+      const thisBuff = stringBuff(localThis);
+      const needleBuff = stringBuff(localNeedle);
+      const replacementBuff = stringBuff(localReplacement);
 
+      // Count the matches first so the result is allocated only once
+      var found: int = 0;
+      var start: int = 0;
+      while (count < 0) || (found < count) {
+        const pos = string_find_bytes(thisBuff + start, thisLen - start,
+                                      needleBuff, nLen);
+        if pos < 0 then break;
         found += 1;
-        result = result[..idx-1] + localReplacement + result[(idx + localNeedle.length)..];
-        startIdx = idx + localReplacement.length;
+        start += pos + nLen;
       }
+      if found == 0 then return this;
+
+      var result: string;
+      const resultBuff = allocStringBuff(result, thisLen + found*(rLen-nLen));
+      var src: int = 0;
+      var dst: int = 0;
+      for 1..found {
+        const pos = string_find_bytes(thisBuff + src, thisLen - src,
+                                      needleBuff, nLen);
+        c_memcpy(resultBuff + dst, thisBuff + src, pos);
+        c_memcpy(resultBuff + dst + pos, replacementBuff, rLen);
+        src += pos + nLen;
+        dst += pos + rLen;
+      }
+      c_memcpy(resultBuff + dst, thisBuff + src, thisLen - src);
       return result;
     }
 
@@ -722,6 +821,7 @@ module String {
     iter split(maxsplit: int = -1) /* : string */ {
       if !this.isEmptyString() {
         const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
         var done : bool = false;
         var yieldChunk : bool = false;
         var chunk : string;
@@ -743,7 +843,7 @@ module String {
               yieldChunk = true;
             }
           } else {
-            var b = localThis.buff[i];
+            var b = thisBuff[i];
             var bSpace = byte_isWhitespace(b);
             // first char of a chunk
             if !(inChunk || bSpace) {
@@ -845,12 +945,7 @@ module String {
         for s in S do joinedSize += s.length;
 
         var joined: string;
-        joined.len = joinedSize;
-        const allocSize = chpl_here_good_alloc_size(joined.len + 1);
-        joined._size = allocSize;
-        joined.buff = chpl_here_alloc(
-          allocSize,
-          CHPL_RT_MD_STR_COPY_DATA): bufferType;
+        const joinedBuff = allocStringBuff(joined, joinedSize);
 
         var first = true;
         var offset = 0;
@@ -858,18 +953,13 @@ module String {
           if first {
             first = false;
           } else if this.len != 0 {
-            c_memcpy(joined.buff + offset, this.buff, this.len);
+            getStringBytes(joinedBuff + offset, this, 0, this.len);
             offset += this.len;
           }
 
           var sLen = s.len;
           if sLen != 0 {
-            var cpyStart = joined.buff + offset;
-            if _local || s.locale_id == chpl_nodeID {
-              c_memcpy(cpyStart, s.buff, sLen);
-            } else {
-              chpl_string_comm_get(cpyStart, s.locale_id, s.buff, sLen);
-            }
+            getStringBytes(joinedBuff + offset, s, 0, sLen);
             offset += sLen;
           }
         }
@@ -894,6 +984,8 @@ module String {
 
       const localThis: string = this.localize();
       const localChars: string = chars.localize();
+      const thisBuff = stringBuff(localThis);
+      const charsBuff = stringBuff(localChars);
 
       var start = 1;
       var end = localThis.len;
@@ -901,7 +993,7 @@ module String {
       if leading {
         label outer for i in 0..#localThis.len {
           for j in 0..#localChars.len {
-            if localThis.buff[i] == localChars.buff[j] {
+            if thisBuff[i] == charsBuff[j] {
               start += 1;
               continue outer;
             }
@@ -913,7 +1005,7 @@ module String {
       if trailing {
         label outer for i in 0..#localThis.len by -1 {
           for j in 0..#localChars.len {
-            if localThis.buff[i] == localChars.buff[j] {
+            if thisBuff[i] == charsBuff[j] {
               end -= 1;
               continue outer;
             }
@@ -957,9 +1049,11 @@ module String {
       var result: bool;
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
         var locale_result = false;
-        for i in 0..#this.len {
-          const b = buff[i];
+        for i in 0..#localThis.len {
+          const b = thisBuff[i];
           if byte_isLower(b) {
             locale_result = false;
             break;
@@ -985,8 +1079,10 @@ module String {
 
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
-        for i in 0..#this.len {
-          const b = buff[i];
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
+        for i in 0..#localThis.len {
+          const b = thisBuff[i];
           if byte_isUpper(b) {
             result = false;
             break;
@@ -1011,8 +1107,10 @@ module String {
 
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
-        for i in 0..#this.len {
-          const b = buff[i];
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
+        for i in 0..#localThis.len {
+          const b = thisBuff[i];
           if !(byte_isWhitespace(b)) {
             result = false;
             break;
@@ -1034,8 +1132,10 @@ module String {
 
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
-        for i in 0..#this.len {
-          const b = buff[i];
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
+        for i in 0..#localThis.len {
+          const b = thisBuff[i];
           if !byte_isAlpha(b) {
             result = false;
             break;
@@ -1057,8 +1157,10 @@ module String {
 
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
-        for i in 0..#this.len {
-          const b = buff[i];
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
+        for i in 0..#localThis.len {
+          const b = thisBuff[i];
           if !byte_isDigit(b) {
             result = false;
             break;
@@ -1080,8 +1182,10 @@ module String {
 
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
-        for i in 0..#this.len {
-          const b = buff[i];
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
+        for i in 0..#localThis.len {
+          const b = thisBuff[i];
           if !(byte_isAlpha(b) || byte_isDigit(b)) {
             result = false;
             break;
@@ -1105,8 +1209,10 @@ module String {
 
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
-        for i in 0..#this.len {
-          const char = buff[i];
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
+        for i in 0..#localThis.len {
+          const char = thisBuff[i];
           if char <= 0x1f  || char == 0x7f {
             result = false;
             break;
@@ -1129,10 +1235,12 @@ module String {
 
       on __primitive("chpl_on_locale_num",
                      chpl_buildLocaleID(this.locale_id, c_sublocid_any)) {
+        const localThis: string = this.localize();
+        const thisBuff = stringBuff(localThis);
         param UN = 0, UPPER = 1, LOWER = 2;
         var last = UN;
-        for i in 0..#this.len {
-          const b = buff[i];
+        for i in 0..#localThis.len {
+          const b = thisBuff[i];
           if byte_isLower(b) {
             if last == UPPER || last == LOWER {
               last = LOWER;
@@ -1164,12 +1272,13 @@ module String {
     proc toLower() : string {
       var result: string = this;
       if result.isEmptyString() then return result;
+      const resultBuff = stringBuff(result);
 
       for i in 0..#result.len {
-        const b = result.buff[i];
+        const b = resultBuff[i];
         if byte_isUpper(b) {
           // We can just add or subtract 0x20 to change between upper and lower
-          result.buff[i] = b + 0x20;
+          resultBuff[i] = b + 0x20;
         }
       }
       return result;
@@ -1182,11 +1291,12 @@ module String {
     proc toUpper() : string {
       var result: string = this;
       if result.isEmptyString() then return result;
+      const resultBuff = stringBuff(result);
 
       for i in 0..#result.len {
-        const b = result.buff[i];
+        const b = resultBuff[i];
         if byte_isLower(b) {
-          result.buff[i] = b - 0x20;
+          resultBuff[i] = b - 0x20;
         }
       }
       return result;
@@ -1200,20 +1310,21 @@ module String {
     proc toTitle() : string {
       var result: string = this;
       if result.isEmptyString() then return result;
+      const resultBuff = stringBuff(result);
 
       param UN = 0, LETTER = 1;
       var last = UN;
       for i in 0..#result.len {
-        const b = result.buff[i];
+        const b = resultBuff[i];
         if byte_isAlpha(b) {
           if last == UN {
             last = LETTER;
             if byte_isLower(b) {
-              result.buff[i] = b - 0x20;
+              resultBuff[i] = b - 0x20;
             }
           } else { // last == LETTER
             if byte_isUpper(b) {
-              result.buff[i] = b + 0x20;
+              resultBuff[i] = b + 0x20;
             }
           }
         } else {
@@ -1233,10 +1344,11 @@ module String {
     proc capitalize() : string {
       var result: string = this.toLower();
       if result.isEmptyString() then return result;
+      const resultBuff = stringBuff(result);
 
-      var b = result.buff[0];
+      var b = resultBuff[0];
       if byte_isLower(b) {
-        result.buff[0] = b - 0x20;
+        resultBuff[0] = b - 0x20;
       }
       return result;
     }
@@ -1255,7 +1367,10 @@ module String {
     pragma "no auto destroy"
     var ret: string;
     const slen = s.len; // cache the remote copy of len
-    if slen != 0 {
+    if slen != 0 && slen < chpl_string_small_size {
+      // short strings are copied into the record, even from remote ones
+      getStringBytes(allocStringBuff(ret, slen), s, 0, slen);
+    } else if slen != 0 {
       if _local || s.locale_id == chpl_nodeID {
         if s.owned {
           ret.buff = chpl_here_alloc(s._size,
@@ -1295,7 +1410,10 @@ module String {
     pragma "no auto destroy"
     var ret: string;
     const slen = s.len; // cache the remote copy of len
-    if slen != 0 {
+    if slen != 0 && slen < chpl_string_small_size {
+      // short strings are copied into the record, even from remote ones
+      getStringBytes(allocStringBuff(ret, slen), s, 0, slen);
+    } else if slen != 0 {
       if _local || s.locale_id == chpl_nodeID {
         if s.owned {
           ret.buff = chpl_here_alloc(s._size,
@@ -1324,7 +1442,14 @@ module String {
   */
   proc =(ref lhs: string, rhs: string) {
     inline proc helpMe(ref lhs: string, rhs: string) {
-      if _local || rhs.locale_id == chpl_nodeID {
+      if rhs.len < chpl_string_small_size {
+        // rhs may be remote, or its bytes may be in the record
+        const len = rhs.len; // cache the remote copy of len
+        var small: lhs._small.type;
+        getStringBytes(c_ptrTo(small): bufferType, rhs, 0, len);
+        lhs.reinitString(c_ptrTo(small): bufferType, len, len+1,
+                         needToCopy=true);
+      } else if _local || rhs.locale_id == chpl_nodeID {
         lhs.reinitString(rhs.buff, rhs.len, rhs._size, needToCopy=true);
       } else {
         const len = rhs.len; // cache the remote copy of len
@@ -1375,27 +1500,9 @@ module String {
     if s1len == 0 then return s0;
 
     var ret: string;
-    ret.len = s0len + s1len;
-    const allocSize = chpl_here_good_alloc_size(ret.len+1);
-    ret._size = allocSize;
-    ret.buff = chpl_here_alloc(allocSize,
-                              CHPL_RT_MD_STR_COPY_DATA): bufferType;
-    ret.owned = true;
-
-    const s0remote = s0.locale_id != chpl_nodeID;
-    if s0remote {
-      chpl_string_comm_get(ret.buff, s0.locale_id, s0.buff, s0len);
-    } else {
-      c_memcpy(ret.buff, s0.buff, s0len);
-    }
-
-    const s1remote = s1.locale_id != chpl_nodeID;
-    if s1remote {
-      chpl_string_comm_get(ret.buff+s0len, s1.locale_id, s1.buff, s1len);
-    } else {
-      c_memcpy(ret.buff+s0len, s1.buff, s1len);
-    }
-    ret.buff[ret.len] = 0;
+    const retBuff = allocStringBuff(ret, s0len + s1len);
+    getStringBytes(retBuff, s0, 0, s0len);
+    getStringBytes(retBuff+s0len, s1, 0, s1len);
 
     return ret;
   }
@@ -1421,27 +1528,15 @@ module String {
     if sLen == 0 then return "";
 
     var ret: string;
-    ret.len = sLen * n; // TODO: check for overflow
-    const allocSize = chpl_here_good_alloc_size(ret.len+1);
-    ret._size = allocSize;
-    ret.buff = chpl_here_alloc(allocSize,
-                              CHPL_RT_MD_STR_COPY_DATA): bufferType;
-    ret.owned = true;
-
-    const sRemote = s.locale_id != chpl_nodeID;
-    if sRemote {
-      chpl_string_comm_get(ret.buff, s.locale_id, s.buff, sLen);
-    } else {
-      c_memcpy(ret.buff, s.buff, sLen);
-    }
+    const retBuff = allocStringBuff(ret, sLen * n); // TODO: check for overflow
+    getStringBytes(retBuff, s, 0, sLen);
 
     var iterations = n-1;
     var offset = sLen;
     for i in 1..iterations {
-      c_memcpy(ret.buff+offset, ret.buff, sLen);
+      c_memcpy(retBuff+offset, retBuff, sLen);
       offset += sLen;
     }
-    ret.buff[ret.len] = 0;
 
     return ret;
   }
@@ -1559,31 +1654,36 @@ module String {
                    chpl_buildLocaleID(lhs.locale_id, c_sublocid_any)) {
       const rhsLen = rhs.len;
       const newLength = lhs.len+rhsLen; //TODO: check for overflow
-      if lhs._size <= newLength {
-        const newSize = chpl_here_good_alloc_size(
-            max(newLength+1, lhs.len*chpl_stringGrowthFactor):int);
+      if lhs.buff == nil && newLength < chpl_string_small_size {
+        // Still short enough to keep in the record
+        var small = lhs._small;
+        const smallBuff = c_ptrTo(small): bufferType;
+        getStringBytes(smallBuff+lhs.len, rhs, 0, rhsLen);
+        smallBuff[newLength] = 0;
+        lhs._small = small;
+        lhs.len = newLength;
+      } else {
+        if lhs._size <= newLength {
+          const newSize = chpl_here_good_alloc_size(
+              max(newLength+1, lhs.len*chpl_stringGrowthFactor):int);
 
-        if lhs.owned {
-          lhs.buff = chpl_here_realloc(lhs.buff, newSize,
-                                      CHPL_RT_MD_STR_COPY_DATA):bufferType;
-        } else {
-          var newBuff = chpl_here_alloc(newSize,
-                                       CHPL_RT_MD_STR_COPY_DATA):bufferType;
-          c_memcpy(newBuff, lhs.buff, lhs.len);
-          lhs.buff = newBuff;
-          lhs.owned = true;
-        }
+          if lhs.owned && lhs.buff != nil {
+            lhs.buff = chpl_here_realloc(lhs.buff, newSize,
+                                        CHPL_RT_MD_STR_COPY_DATA):bufferType;
+          } else {
+            var newBuff = chpl_here_alloc(newSize,
+                                         CHPL_RT_MD_STR_COPY_DATA):bufferType;
+            getStringBytes(newBuff, lhs, 0, lhs.len);
+            lhs.buff = newBuff;
+            lhs.owned = true;
+          }
 
-        lhs._size = newSize;
-      }
-      const rhsRemote = rhs.locale_id != chpl_nodeID;
-      if rhsRemote {
-        chpl_string_comm_get(lhs.buff+lhs.len, rhs.locale_id, rhs.buff, rhsLen);
-      } else {
-        c_memcpy(lhs.buff+lhs.len, rhs.buff, rhsLen);
+          lhs._size = newSize;
+        }
+        getStringBytes(lhs.buff+lhs.len, rhs, 0, rhsLen);
+        lhs.len = newLength;
+        lhs.buff[newLength] = 0;
       }
-      lhs.len = newLength;
-      lhs.buff[newLength] = 0;
     }
   }
 
@@ -1606,7 +1706,7 @@ module String {
   private inline proc _strcmp(a: string, b:string) : int {
     // Assumes a and b are on same locale and not empty.
     const size = min(a.len, b.len);
-    const result =  c_memcmp(a.buff, b.buff, size);
+    const result =  c_memcmp(stringBuff(a), stringBuff(b), size);
 
     if (result == 0) {
       // Handle cases where one string is the beginning of the other
@@ -1732,23 +1832,17 @@ module String {
   inline proc ascii(a: string) : uint(8) {
     if a.isEmptyString() then return 0;
 
-    if _local || a.locale_id == chpl_nodeID {
-      // the string must be local so we can index into buff
-      return a.buff[0];
-    } else {
-      // a[1] grabs the first character as a string (making it local)
-      return a[1].buff[0];
-    }
+    var b: uint(8);
+    getStringBytes(c_ptrTo(b), a, 0, 1);
+    return b;
   }
 
   /*
      :returns: A string with the single character with the ASCII value `i`.
   */
   inline proc asciiToString(i: uint(8)) {
-    var buffer = chpl_here_alloc(2, CHPL_RT_MD_STR_COPY_DATA): bufferType;
-    buffer[0] = i;
-    buffer[1] = 0;
-    var s = new string(buffer, 1, 2, owned=true, needToCopy=false);
+    var s: string;
+    allocStringBuff(s, 1)[0] = i;
     return s;
   }
 
@@ -1771,12 +1865,9 @@ module String {
   pragma "no doc"
   proc _cast(type t, cs: c_string) where t == string {
     var ret: string;
-    ret.len = cs.length;
-    ret._size = ret.len+1;
-    ret.buff = if ret.len > 0
-      then __primitive("string_copy", cs): bufferType
-      else nil;
-    ret.owned = true;
+    const len = cs.length;
+    if len > 0 then
+      c_memcpy(allocStringBuff(ret, len), cs: bufferType, len);
 
     return ret;
   }
@@ -1789,8 +1880,9 @@ module String {
   inline proc chpl__defaultHash(x : string): uint {
     // Use djb2 (Dan Bernstein in comp.lang.c), XOR version
     var hash: int(64) = 5381;
+    const xBuff = stringBuff(x);
     for c in 0..#(x.length) {
-      hash = ((hash << 5) + hash) ^ x.buff[c];
+      hash = ((hash << 5) + hash) ^ xBuff[c];
     }
     return hash;
   }
@@ -35,7 +35,10 @@ module MemTracking
                                          ref ret_memMax: uint(64),       // **
                                          ref ret_memThreshold: uint(64), // **
                                          ref ret_memLog: c_string,
-                                         ref ret_memLeaksLog: c_string) {
+                                         ref ret_memLeaksLog: c_string,
+                                         ref ret_memSampleRate: uint(64),     // **
+                                         ref ret_memSampleInterval: uint(64), // **
+                                         ref ret_memSampleLog: c_string) {
 
     // ** In minimal-modules mode, I've hard-coded these size_t
     // arguments to uint(64) rather than using the size_t aliases
@@ -0,0 +1,151 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ * 
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ * 
+ * You may obtain a copy of the License at
+ * 
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ * 
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+   Reads elements of distributed arrays in bulk.
+
+   Reading an element of a distributed array that is stored on another
+   locale takes a round trip to that locale, so a loop like
+
+   .. code-block:: chapel
+
+     forall i in D do
+       x[i] = A[idx[i]];
+
+   makes one round trip for each element of ``A`` it reads remotely.
+   :proc:`gather` reads the same elements with a few bulk transfers
+   instead.  The indices to read are grouped by the locale that owns
+   them.  Each group is sent to its locale in one transfer, and the
+   elements are read there and sent back in one more.
+
+   .. code-block:: chapel
+
+     use Gather;
+
+     x = gather(A, idx);
+
+   Elements can be gathered from arrays that are not distributed, and
+   from arrays distributed with :mod:`BlockDist`, :mod:`CyclicDist`,
+   :mod:`BlockCycDist` or :mod:`StencilDist`.  The indices can be
+   stored in any rectangular array, distributed or not.  When they are
+   distributed, each locale gathers the elements for the indices it
+   stores, and the result is distributed the same way.
+
+   The indices and the values read are buffered on the locales that
+   store the indices, so gathering takes extra memory roughly the size
+   of the index and result arrays.
+*/
+module Gather {
+
+  /*
+     Returns an array over ``inds.domain`` holding ``A[inds[i]]`` for each
+     index ``i`` of ``inds``.
+  */
+  proc gather(A: [], inds: []) {
+    var res: [inds.domain] A.eltType;
+    gather(res, A, inds);
+    return res;
+  }
+
+  /*
+     Stores ``A[inds[i]]`` into ``res[i]`` for each index ``i`` of
+     ``inds``.  ``res`` must be declared over ``inds.domain``.
+  */
+  proc gather(ref res: [], A: [], inds: []) {
+    if res.domain.rank != inds.domain.rank then
+      compilerError("gather() result and index arrays differ in rank");
+
+    // With one locale, or with 'A' all on one locale, there is nothing
+    // to group by owner, so read the elements directly.
+    if numLocales == 1 || A._value.isDefaultRectangular() {
+      forall i in inds.domain do
+        res[i] = A[inds[i]];
+      return;
+    }
+
+    coforall loc in inds.targetLocales() do on loc {
+      for myInds in inds.localSubdomains() do
+        gatherLocal(res, A, inds, myInds);
+    }
+  }
+
+  //
+  // Gather the elements for the indices of 'inds' in 'myInds', which
+  // are all stored on this locale.
+  //
+  private proc gatherLocal(ref res, A, inds, myInds) {
+    const n = myInds.numIndices;
+    if n == 0 then return;
+
+    type idxType = inds.eltType;
+    type resIdxType = myInds.low.type;
+
+    // Find the locale that owns each index.  Elements on this locale
+    // are read right away, and the rest are counted by owner.
+    var owner: [0..#n] int;
+    var counts: [LocaleSpace] int;
+    const hereId = here.id;
+    forall (p, i) in zip(0..#n, myInds) {
+      const ind = inds[i];
+      const o = A.domain.dist.idxToLocale(ind).id;
+      if o == hereId {
+        res.localAccess(i) = A.localAccess(ind);
+        owner[p] = -1;
+      } else {
+        owner[p] = o;
+      }
+    }
+    for o in owner do
+      if o >= 0 then
+        counts[o] += 1;
+    const numRemote = + reduce counts;
+    if numRemote == 0 then return;
+
+    // Sort the indices by their owners, remembering where each goes
+    var starts: [LocaleSpace] int;
+    for l in 1..LocaleSpace.high do
+      starts[l] = starts[l-1] + counts[l-1];
+    var next = starts;
+    var sortedInds: [0..#numRemote] idxType;
+    var sortedDsts: [0..#numRemote] resIdxType;
+    for (p, i) in zip(0..#n, myInds) {
+      if owner[p] < 0 then continue;
+      const q = next[owner[p]];
+      next[owner[p]] += 1;
+      sortedInds[q] = inds[i];
+      sortedDsts[q] = i;
+    }
+
+    // Read each owner's elements on that owner
+    var vals: [0..#numRemote] A.eltType;
+    coforall l in LocaleSpace do if counts[l] > 0 then on Locales[l] {
+      const lo = starts[l],
+            cnt = counts[l];
+      const theirInds: [0..#cnt] idxType = sortedInds[lo..#cnt];
+      var theirVals: [0..#cnt] A.eltType;
+      forall (v, i) in zip(theirVals, theirInds) do
+        v = A.localAccess(i);
+      vals[lo..#cnt] = theirVals;
+    }
+
+    forall (v, i) in zip(vals, sortedDsts) do
+      res.localAccess(i) = v;
+  }
+
+}
@@ -60,6 +60,12 @@ unless otherwise specified.
 This function supports any combination of scalars, vectors (1D arrays), and
 matrices (2D arrays). See the :proc:`dot` documentation for more information.
 
+For element types that BLAS supports, matrix multiplication of local
+matrices is done by BLAS.  Other element types use a cache-blocked native
+implementation.  When both matrices are :mod:`BlockDist`-distributed, the
+multiplication is done in parallel across locales, and the result is
+distributed over the same locales as the first matrix.
+
 The :proc:`dot` function, along with others may be given a matrix-specific
 operator in future releases.
 
@@ -120,6 +126,7 @@ module LinearAlgebra {
 
  use Norm; // TODO -- merge Norm into LinearAlgebra
  use BLAS;
+ use BlockDist;
 // use LAPACK; // TODO -- Use LAPACK routines
 
 
@@ -449,9 +456,13 @@ private proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
   if Adom.shape(2) != Bdom.shape(1) then
     halt("Mismatched shape in matrix-matrix multiplication");
 
-  var C: [Adom.dim(1), Bdom.dim(2)] eltType;
-  gemm(A, B, C, 1:eltType, 0:eltType);
-  return C;
+  if _isBlockArr(A) && _isBlockArr(B) {
+    return _matmatMultBlock(A, B);
+  } else {
+    var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+    gemm(A, B, C, 1:eltType, 0:eltType);
+    return C;
+  }
 }
 
 
@@ -478,6 +489,159 @@ proc outer(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
 }
 
 
+//
+// Native matrix multiplication
+//
+// The local multiply works on square tiles of C, one task per tile.  For
+// each tile the matching tiles of A and B are copied into contiguous
+// buffers, so that the kernel only deals with unit-stride, 0-based data
+// no matter how the matrices are laid out or indexed, and the tile of C
+// is accumulated in a buffer of its own and added into C at the end.
+// The kernel updates four rows of the C tile at a time, so each element
+// of B that is loaded is used four times, and its innermost loop runs
+// along rows of the B and C tiles so that it can be vectorized.
+//
+// Block-distributed matrices are multiplied with SUMMA.  Each locale
+// computes its own block of C as a sum of products of panels: the part
+// of a column panel of A covering its rows, times the part of the
+// matching row panel of B covering its columns.  The locales in a row
+// of the locale grid all use the same panels of A, and those in a
+// column all use the same panels of B.  Each locale fetches its parts
+// of a panel with a bulk copy and then multiplies them locally.
+//
+
+pragma "no doc"
+/* Width of the tiles used by the native local multiply */
+private param _matmatTileSize = 64;
+
+pragma "no doc"
+/* Width of the panels that locales exchange in the distributed multiply */
+private param _matmatPanelSize = 4 * _matmatTileSize;
+
+pragma "no doc"
+private proc _isBlockArr(A: []) param {
+  return _isBlockDom(A.domain._value);
+}
+
+pragma "no doc"
+private proc _isBlockDom(dom: BlockDom) param return true;
+
+pragma "no doc"
+private proc _isBlockDom(dom) param return false;
+
+pragma "no doc"
+/* The 'n' indices of range 'r' starting at the 'lo'th (counting from 0) */
+private inline proc _panel(r: range(?), lo, n) {
+  return r#(lo+n)#-n;
+}
+
+pragma "no doc"
+/* C += A*B for matrices with any layout and indices */
+private proc _matmatMultLocal(A: [?Adom] ?eltType, B: [?Bdom] eltType,
+                              C: [?Cdom] eltType) {
+  param T = _matmatTileSize;
+  const m = Cdom.dim(1).size,
+        n = Cdom.dim(2).size,
+        p = Adom.dim(2).size;
+
+  forall (it, jt) in {0..#m by T, 0..#n by T} {
+    const im = min(T, m-it),
+          jn = min(T, n-jt);
+    var At, Bt, Ct: [0..#T*T] eltType;
+
+    for kt in 0..#p by T {
+      const kn = min(T, p-kt);
+
+      for (i, ai) in zip(0..#im, _panel(Adom.dim(1), it, im)) do
+        for (k, ak) in zip(0..#kn, _panel(Adom.dim(2), kt, kn)) do
+          At[i*T+k] = A[ai, ak];
+      for (k, bk) in zip(0..#kn, _panel(Bdom.dim(1), kt, kn)) do
+        for (j, bj) in zip(0..#jn, _panel(Bdom.dim(2), jt, jn)) do
+          Bt[k*T+j] = B[bk, bj];
+
+      _matmatKernel(c_ptrTo(At), c_ptrTo(Bt), c_ptrTo(Ct), im, jn, kn);
+    }
+
+    for (i, ci) in zip(0..#im, _panel(Cdom.dim(1), it, im)) do
+      for (j, cj) in zip(0..#jn, _panel(Cdom.dim(2), jt, jn)) do
+        C[ci, cj] += Ct[i*T+j];
+  }
+}
+
+pragma "no doc"
+/* c += a*b for the leading im x kn, kn x jn and im x jn parts of tiles */
+private proc _matmatKernel(a: c_ptr, b: c_ptr, c: c_ptr, im, jn, kn) {
+  param T = _matmatTileSize;
+  var i = 0;
+
+  while i+4 <= im {
+    const c0 = i*T, c1 = c0+T, c2 = c1+T, c3 = c2+T;
+    for k in 0..#kn {
+      const a0 = a[c0+k], a1 = a[c1+k], a2 = a[c2+k], a3 = a[c3+k];
+      const bk = k*T;
+      for j in vectorizeOnly(0..#jn) {
+        const bkj = b[bk+j];
+        c[c0+j] += a0*bkj;
+        c[c1+j] += a1*bkj;
+        c[c2+j] += a2*bkj;
+        c[c3+j] += a3*bkj;
+      }
+    }
+    i += 4;
+  }
+
+  while i < im {
+    const c0 = i*T;
+    for k in 0..#kn {
+      const a0 = a[c0+k];
+      const bk = k*T;
+      for j in vectorizeOnly(0..#jn) do
+        c[c0+j] += a0*b[bk+j];
+    }
+    i += 1;
+  }
+}
+
+pragma "no doc"
+/* SUMMA multiplication of Block-distributed matrices */
+private proc _matmatMultBlock(A: [?Adom] ?eltType, B: [?Bdom] eltType) {
+  param P = _matmatPanelSize;
+  const rows = Adom.dim(1),
+        cols = Bdom.dim(2),
+        p = Adom.dim(2).size;
+  const Cdom = {rows, cols} dmapped Block(boundingBox={rows, cols},
+                                          targetLocales=A.targetLocales());
+  var C: [Cdom] eltType;
+
+  coforall loc in C.targetLocales() do on loc {
+    const myInds = C.localSubdomain();
+    const myRows = myInds.dim(1),
+          myCols = myInds.dim(2);
+
+    if myInds.numIndices > 0 {
+      var Cl: [0..#myRows.size, 0..#myCols.size] eltType;
+
+      for kt in 0..#p by P {
+        const kn = min(P, p-kt);
+        var Ap: [0..#myRows.size, 0..#kn] eltType =
+          A[myRows, _panel(Adom.dim(2), kt, kn)];
+        var Bp: [0..#kn, 0..#myCols.size] eltType =
+          B[_panel(Bdom.dim(1), kt, kn), myCols];
+
+        if isBLASType(eltType) then
+          gemm(Ap, Bp, Cl, 1:eltType, 1:eltType);
+        else
+          _matmatMultLocal(Ap, Bp, Cl);
+      }
+
+      C[myInds] = Cl;
+    }
+  }
+
+  return C;
+}
+
+
 pragma "no doc"
 /* Generic matrix-vector multiplication */
 proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
@@ -491,17 +655,30 @@ proc _matvecMult(A: [?Adom] ?eltType, X: [?Xdom] eltType, trans=false)
 
   var Y: [Ydom] eltType;
 
-  // naive algorithm
   if !trans {
     if Adom.shape(2) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[i,..]*X[..]);
+    forall i in Ydom {
+      var y: eltType;
+      for (k, xk) in zip(Adom.dim(2), Xdom.dim(1)) do
+        y += A[i, k]*X[xk];
+      Y[i] = y;
+    }
   } else {
     if Adom.shape(1) != Xdom.shape(1) then
       halt("Mismatched shape in matrix-vector multiplication");
-    forall i in Ydom do
-      Y[i] = + reduce (A[.., i]*X[..]);
+    // Each task owns a block of Y and walks down the rows of A, so that
+    // A is read along its rows rather than its columns
+    param T = _matmatTileSize;
+    const n = Adom.dim(2).size;
+    forall jt in 0..#n by T {
+      const js = _panel(Adom.dim(2), jt, min(T, n-jt));
+      for (k, xk) in zip(Adom.dim(1), Xdom.dim(1)) {
+        const x = X[xk];
+        for j in js do
+          Y[j] += A[k, j]*x;
+      }
+    }
   }
 
   return Y;
@@ -516,13 +693,16 @@ proc _matmatMult(A: [?Adom] ?eltType, B: [?Bdom] eltType)
   if Adom.rank != 2 || Bdom.rank != 2 then
     compilerError("Rank sizes are not 2 and 2");
 
-  var C: [Adom.dim(1), Bdom.dim(2)] eltType;
-
-  // naive algorithm
-  forall (i,j) in C.domain do
-    C[i,j] = + reduce (A[i,..]*B[..,j]);
+  if Adom.shape(2) != Bdom.shape(1) then
+    halt("Mismatched shape in matrix-matrix multiplication");
 
-  return C;
+  if _isBlockArr(A) && _isBlockArr(B) {
+    return _matmatMultBlock(A, B);
+  } else {
+    var C: [Adom.dim(1), Bdom.dim(2)] eltType;
+    _matmatMultLocal(A, B, C);
+    return C;
+  }
 }
 
 
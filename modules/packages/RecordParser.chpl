@@ -196,6 +196,80 @@ class RecordReader {
     } while(once);
   }
 
+  /* Yield the records read, in parallel.
+
+     The rest of the channel's region is split into byte ranges that are
+     read by separate channels, possibly on several locales, as for
+     :record:`~IO.ItemReader`. A record belongs to the range that holds the
+     first non-space character of its match, so the regular expression
+     should begin each record with text that cannot occur inside one.
+
+     In a zippered ``forall``, a region that is split into ranges can
+     only be zippered with this same reader's ``stream()``, and the loop
+     halts otherwise.
+   */
+  iter stream(param tag: iterKind) where tag == iterKind.standalone {
+    const (fl, start, end) = myReader._parallelReadRegion();
+    const style = myReader._style();
+
+    forall (rangeStart, rangeEnd, rf) in _parallelReadRanges(fl, start, end,
+                                                             true) do
+      for rec in _stream_range(rf, end, rangeStart, rangeEnd, style) do
+        yield rec;
+  }
+
+  pragma "no doc"
+  iter stream(param tag: iterKind) where tag == iterKind.leader {
+    const (fl, start, end) = myReader._parallelReadRegion();
+    const style = myReader._style();
+
+    forall (rangeStart, rangeEnd, rf) in _parallelReadRanges(fl, start, end,
+                                                             true) do
+      yield (this:object, start, end, rangeStart, rangeEnd, rf, style);
+  }
+
+  pragma "no doc"
+  // As for ItemReader's follower, a region read as a single range can be
+  // followed by any RecordReader.  A region split into ranges can only
+  // be followed by the RecordReader that is leading.
+  iter stream(param tag: iterKind, followThis) where tag == iterKind.follower {
+    const (leader, leadStart, leadEnd, rangeStart, rangeEnd, rf,
+           leadStyle) = followThis;
+
+    if rangeStart == leadStart && rangeEnd == leadEnd {
+      const (fl, start, end) = myReader._parallelReadRegion();
+      for rec in _stream_range(fl, end, start, end, myReader._style()) do
+        yield rec;
+    } else {
+      if leader != this:object then
+        halt("a parallel stream() can only be zippered with itself");
+
+      for rec in _stream_range(rf, leadEnd, rangeStart, rangeEnd, leadStyle) do
+        yield rec;
+    }
+  }
+
+  pragma "no doc"
+  // Yield the records that start in rangeStart..rangeEnd-1 of rf, reading
+  // no further than end
+  iter _stream_range(rf: file, end: int(64), rangeStart: int(64),
+                     rangeEnd: int(64), style: iostyle) {
+    var rdr = rf.reader(locking=false, start=rangeStart, end=end,
+                        style=style);
+    var re: regexp;
+
+    // This compiles a copy of matchRegexp if it is on another locale
+    re = matchRegexp;
+
+    while true {
+      var (rec, once, recStart) = _get_next(rdr, re);
+      if !once || recStart >= rangeEnd then break;
+      yield rec;
+    }
+
+    rdr.close();
+  }
+
   /*
 
      An internal function that we use with all our user visible code.  When
@@ -216,19 +290,47 @@ class RecordReader {
         // Then break and dont return any record
         return (rec, false);
       }
-      for param n in 1..num_fields {
-        var tmp = __primitive("field by num", rec, n);
-        var s: string;
-        myReader.extractMatch(m(n + 1), s);
-        if(s == "") 
-          then __primitive("field by num", rec, n) = tmp;
-        else __primitive("field by num", rec, n) = s:tmp.type;
-        once = true;
-      }
+      once = _fill_fields(myReader, m, rec);
     } 
     return (rec, once);
   }
 
+  /* Read the next match of re from rdr into a record. Returns the record,
+     whether it was populated, and the offset of the first non-space
+     character of the match, which is where a parallel reader considers
+     the record to start.
+   */
+  pragma "no doc"
+  proc _get_next(rdr, re: regexp) {
+    var rec: t;
+    var once = false;
+    var recStart: int(64);
+    for m in rdr.matches(re, num_fields, 1) {
+      var matched: string;
+      rdr.extractMatch(m(1), matched);
+      recStart = m(1).offset + matched.length -
+                 matched.strip(trailing=false).length;
+      once = _fill_fields(rdr, m, rec);
+    }
+    return (rec, once, recStart);
+  }
+
+  pragma "no doc"
+  // Assign the captures in the match m to the fields of rec
+  proc _fill_fields(rdr, m, ref rec: t): bool {
+    var once = false;
+    for param n in 1..num_fields {
+      var tmp = __primitive("field by num", rec, n);
+      var s: string;
+      rdr.extractMatch(m(n + 1), s);
+      if(s == "") 
+        then __primitive("field by num", rec, n) = tmp;
+      else __primitive("field by num", rec, n) = s:tmp.type;
+      once = true;
+    }
+    return once;
+  }
+
 }
 
 }
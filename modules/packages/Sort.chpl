@@ -269,13 +269,316 @@ proc chpl_check_comparator(comparator, type eltType) {
 }
 
 
+pragma "no doc"
+/*
+   The type of the key that the data is sorted on: the element type for the
+   default comparator, or the return type of the comparator's ``key(a)``
+   method. ``void`` if the comparator only has a ``compare(a, b)`` method.
+ */
+proc chpl_sortKeyType(comparator, type eltType) type {
+  use Reflection;
+
+  const data: eltType;
+
+  if canResolveMethod(comparator, "chpl_unreversed") then
+    return chpl_sortKeyType(comparator.chpl_unreversed(), eltType);
+  else if comparator.type == DefaultComparator then
+    return eltType;
+  else if canResolveMethod(comparator, "key", data) then
+    return comparator.key(data).type;
+  else
+    return void;
+}
+
+
+pragma "no doc"
+/* Can :proc:`radixSort` sort this data with this comparator? */
+proc chpl_radixSortable(comparator, type eltType) param {
+  type keyType = chpl_sortKeyType(comparator, eltType);
+  return isIntegralType(keyType) || isRealType(keyType);
+}
+
+
+pragma "no doc"
+/*
+   The key of `a` as an unsigned integer with the same number of bits, such
+   that comparing those integers orders the elements the way the comparator
+   would.
+ */
+inline proc chpl_radixKey(a, comparator) {
+  use Reflection;
+
+  if canResolveMethod(comparator, "chpl_unreversed") then
+    return ~chpl_radixKey(a, comparator.chpl_unreversed());
+  else if comparator.type == DefaultComparator then
+    return chpl_radixBits(a);
+  else
+    return chpl_radixBits(comparator.key(a));
+}
+
+
+pragma "no doc"
+/* Order-preserving map from an integral or real value to a uint */
+inline proc chpl_radixBits(k) {
+  type t = k.type;
+  param bits = numBits(t);
+  const signBit = 1:uint(bits) << (bits-1);
+
+  if isUintType(t) {
+    return k;
+  } else if isIntType(t) {
+    return k:uint(bits) ^ signBit;
+  } else {
+    // Flip negative numbers entirely so larger magnitudes sort first, and
+    // set the sign bit of positive ones so they sort after the negatives.
+    var kBits: uint(bits);
+    var kCopy = k;
+    c_memcpy(c_ptrTo(kBits), c_ptrTo(kCopy), bits/8);
+    return if kBits & signBit then ~kBits else kBits | signBit;
+  }
+}
+
+
+pragma "no doc"
+/*
+   Number of pieces to split `Data` into for the parallel sorts: one per
+   task on each locale the array is distributed over, as long as each piece
+   gets at least `minlen` elements.
+ */
+proc chpl_sortNumChunks(Data: [?Dom], minlen: int) {
+  const tasksPerLocale = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                         else dataParTasksPerLocale;
+  const maxChunks = Data.targetLocales().size * tasksPerLocale;
+  return max(1, min(maxChunks, Dom.size / minlen));
+}
+
+
+pragma "no doc"
+/* Positions (0-based, in index order) belonging to piece `chunk` */
+inline proc chpl_sortChunk(n: int, numChunks: int, chunk: int) {
+  return (chunk*n/numChunks)..((chunk+1)*n/numChunks - 1);
+}
+
+
+pragma "no doc"
+/* The index of `Dom` at 0-based position `pos`, in increasing order */
+inline proc chpl_sortIndex(Dom, pos: int) {
+  if Dom.stridable then
+    return Dom.dim(1).alignedLow + pos*abs(Dom.stride);
+  else
+    return Dom.low + pos;
+}
+
+
+pragma "no doc"
+/* The 0-based position of index `idx` of `Dom`, inverting chpl_sortIndex */
+inline proc chpl_sortPosition(Dom, idx): int {
+  if Dom.stridable then
+    return ((idx - Dom.dim(1).alignedLow) / abs(Dom.stride)):int;
+  else
+    return (idx - Dom.low):int;
+}
+
+
+pragma "no doc"
+/* The indices of `Dom` at the 0-based positions `positions` */
+inline proc chpl_sortIndices(Dom, positions: range) {
+  const low = chpl_sortIndex(Dom, positions.low),
+        high = chpl_sortIndex(Dom, positions.high);
+  if Dom.stridable then
+    return low..high by abs(Dom.stride);
+  else
+    return low..high;
+}
+
+
+pragma "no doc"
+/*
+   Whether chpl_sortScatter can find which of `Dst`'s elements each locale
+   holds and copy into them with localSlice()
+ */
+proc chpl_sortCanCopyRuns(Dst) param {
+  use Reflection;
+  return canResolveMethod(Dst._value, "dsiHasSingleLocalSubdomain") &&
+         canResolveMethod(Dst._value, "dsiLocalSlice", (0..1,));
+}
+
+
+pragma "no doc"
+/*
+   Shared by the parallel sorts: each piece of `Src` counts how many of its
+   elements fall in each of `numBuckets` buckets (as computed by `bucketOf`)
+   and those elements are then copied into `Dst` so that the buckets are
+   laid out one after another, keeping elements in their original order
+   within each bucket. The copy is where elements move between locales for
+   distributed arrays.
+
+   Returns the 0-based position each bucket starts at in `Dst`, with an
+   extra entry at the end holding the number of elements. If every element
+   falls in the same bucket, `Dst` is not touched.
+
+   When `Dst` is spread over several locales that each hold consecutive
+   positions of it, as with a Block distribution, each piece first orders
+   its elements by bucket in a local buffer, and then copies each bucket's
+   run into every locale it lands on with one bulk transfer, from one `on`
+   per destination locale. Otherwise elements are written to `Dst` one at
+   a time.
+ */
+proc chpl_sortScatter(Src: [?Dom], Dst: [Dom], numChunks: int, numBuckets: int,
+                      bucketOf) {
+  const n = Dom.size;
+
+  // counts[b*numChunks + c] is the number of elements piece c has in
+  // bucket b, so an exclusive scan over it gives where each piece starts
+  // copying its elements in each bucket.
+  var counts: [0..#numBuckets*numChunks] int;
+
+  coforall chunk in 0..#numChunks with (ref counts) {
+    const positions = chpl_sortChunk(n, numChunks, chunk);
+    on Src[chpl_sortIndex(Dom, positions.low)] {
+      const myBucketOf = bucketOf;
+      var myCounts: [0..#numBuckets] int;
+      for i in chpl_sortIndices(Dom, positions) do
+        myCounts[myBucketOf(Src[i])] += 1;
+      for b in 0..#numBuckets do
+        counts[b*numChunks + chunk] = myCounts[b];
+    }
+  }
+
+  var bucketStarts: [0..numBuckets] int;
+  var total = 0;
+  for b in 0..#numBuckets {
+    bucketStarts[b] = total;
+    for chunk in 0..#numChunks {
+      const count = counts[b*numChunks + chunk];
+      counts[b*numChunks + chunk] = total;
+      total += count;
+    }
+  }
+  bucketStarts[numBuckets] = total;
+
+  // Nothing would move
+  for b in 0..#numBuckets do
+    if bucketStarts[b+1] - bucketStarts[b] == n then
+      return bucketStarts;
+
+  if chpl_sortCanCopyRuns(Dst) {
+    const dstLocales = Dst.targetLocales();
+    if dstLocales.size > 1 {
+      // The positions of Dst each locale holds
+      var dstPositions: [dstLocales.domain] range;
+      var consecutive: [dstLocales.domain] bool;
+      coforall (loc, locPositions, locConsecutive)
+          in zip(dstLocales, dstPositions, consecutive) do on loc {
+        const mine = Dst.localSubdomain();
+        if mine.size == 0 {
+          locConsecutive = true;
+        } else {
+          const first = chpl_sortPosition(Dom, mine.first),
+                last = chpl_sortPosition(Dom, mine.last);
+          locPositions = min(first, last)..max(first, last);
+          locConsecutive = locPositions.size == mine.size;
+        }
+      }
+
+      if && reduce consecutive {
+        chpl_sortScatterRuns(Src, Dst, numChunks, numBuckets, bucketOf,
+                             counts, dstLocales, dstPositions);
+        return bucketStarts;
+      }
+    }
+  }
+
+  coforall chunk in 0..#numChunks with (ref Dst) {
+    const positions = chpl_sortChunk(n, numChunks, chunk);
+    on Src[chpl_sortIndex(Dom, positions.low)] {
+      const myBucketOf = bucketOf;
+      var offsets: [0..#numBuckets] int;
+      for b in 0..#numBuckets do
+        offsets[b] = counts[b*numChunks + chunk];
+      for i in chpl_sortIndices(Dom, positions) {
+        const b = myBucketOf(Src[i]);
+        Dst[chpl_sortIndex(Dom, offsets[b])] = Src[i];
+        offsets[b] += 1;
+      }
+    }
+  }
+
+  return bucketStarts;
+}
+
+
+pragma "no doc"
+/*
+   The copy of chpl_sortScatter for a `Dst` in which locale l holds the
+   positions `dstPositions[l]`. `counts` is the scanned counts, giving
+   where each piece's run of each bucket starts in `Dst`.
+ */
+proc chpl_sortScatterRuns(Src: [?Dom], Dst: [Dom], numChunks: int,
+                          numBuckets: int, bucketOf, counts, dstLocales,
+                          dstPositions) {
+  const n = Dom.size;
+
+  coforall chunk in 0..#numChunks with (ref Dst) {
+    const positions = chpl_sortChunk(n, numChunks, chunk);
+    on Src[chpl_sortIndex(Dom, positions.low)] {
+      const myBucketOf = bucketOf;
+
+      // Where this piece's run of each bucket goes in Dst, and where it
+      // is in Buf. A run ends where the next one in the scan starts.
+      var dstStarts, bufStarts, runSizes: [0..#numBuckets] int;
+      var bufStart = 0;
+      for b in 0..#numBuckets {
+        const k = b*numChunks + chunk;
+        dstStarts[b] = counts[k];
+        runSizes[b] = (if k+1 < counts.size then counts[k+1] else n)
+                      - counts[k];
+        bufStarts[b] = bufStart;
+        bufStart += runSizes[b];
+      }
+
+      var Buf: [0..#positions.size] Src.eltType;
+      var next = bufStarts;
+      for i in chpl_sortIndices(Dom, positions) {
+        const b = myBucketOf(Src[i]);
+        Buf[next[b]] = Src[i];
+        next[b] += 1;
+      }
+
+      coforall (loc, locPositions) in zip(dstLocales, dstPositions)
+          with (ref Dst) do on loc {
+        const myDstStarts = dstStarts,
+              myBufStarts = bufStarts,
+              myRunSizes = runSizes;
+        for b in 0..#numBuckets {
+          const run = myDstStarts[b]..#myRunSizes[b],
+                mine = run[locPositions];
+          if mine.size > 0 {
+            const bufPositions = myBufStarts[b] + mine.low - run.low
+                                 ..#mine.size;
+            Dst.localSlice(chpl_sortIndices(Dom, mine)) = Buf[bufPositions];
+          }
+        }
+      }
+    }
+  }
+}
+
+
+pragma "no doc"
+/* Arrays smaller than this are always sorted with quickSort by sort() */
+param chpl_sortParallelMinSize = 1 << 14;
+
+
 /* Basic Functions */
 
 /*
    General purpose sorting interface.
 
-   .. note:: Currently this method calls a sequential :proc:`quickSort`, but
-             this may change the future as other algorithms are implemented.
+   Small arrays are sorted with a sequential :proc:`quickSort`. Larger ones
+   are sorted with the parallel :proc:`radixSort` when the data is sorted on
+   integral or real keys, and with the parallel :proc:`sampleSort`
+   otherwise.
 
    :arg Data: The array to be sorted
    :type Data: [] `eltType`
@@ -284,7 +587,12 @@ proc chpl_check_comparator(comparator, type eltType) {
 
  */
 proc sort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
-  quickSort(Data, comparator=comparator);
+  if Dom.size < chpl_sortParallelMinSize then
+    quickSort(Data, comparator=comparator);
+  else if chpl_radixSortable(comparator, eltType) then
+    radixSort(Data, comparator=comparator);
+  else
+    sampleSort(Data, comparator=comparator);
 }
 
 
@@ -358,7 +666,7 @@ proc isSorted(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
  */
 iter sorted(x, comparator:?rec=defaultComparator) {
   var y = x;
-  quickSort(y, comparator=comparator);
+  sort(y, comparator=comparator);
   for i in y do
     yield i;
 }
@@ -700,6 +1008,194 @@ proc quickSort(Data: [?Dom] ?eltType, minlen=16, comparator:?rec=defaultComparat
 }
 
 
+/*
+   Sort the 1D array `Data` in-place using a parallel LSD radix sort
+   algorithm. The sort is stable.
+
+   Each pass sorts on 8 bits of the key, starting from the least significant
+   ones, and passes in which every element has the same 8 bits are skipped.
+   The array is split into one piece per task on each locale it is
+   distributed over; each pass counts the digits in every piece in
+   parallel and then copies each piece's elements to their place in a
+   scratch array with the same distribution, which is where elements are
+   exchanged between locales.
+
+   The data must be sorted on integral or real keys: either the elements
+   themselves (with the default comparator) or the return value of the
+   comparator's ``key(a)`` method. A :record:`ReverseComparator` built from
+   such a comparator can be used as well.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.
+
+ */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  chpl_check_comparator(comparator, eltType);
+  if !chpl_radixSortable(comparator, eltType) then
+    compilerError("radixSort() requires the data to be sorted on integral or real keys");
+
+  param keyBits = numBits(chpl_sortKeyType(comparator, eltType)),
+        radixBits = 8,
+        numBuckets = 1 << radixBits;
+
+  if Dom.size <= 1 then return;
+
+  const numChunks = chpl_sortNumChunks(Data, minlen=numBuckets);
+  var Scratch: [Dom] eltType;
+  var sortedIntoScratch = false;
+
+  for shift in 0..#keyBits by radixBits {
+    const bucketOf = new chpl_radixDigit(comparator, shift, numBuckets-1);
+    var bucketStarts: [0..numBuckets] int;
+    if sortedIntoScratch then
+      bucketStarts = chpl_sortScatter(Scratch, Data, numChunks, numBuckets,
+                                      bucketOf);
+    else
+      bucketStarts = chpl_sortScatter(Data, Scratch, numChunks, numBuckets,
+                                      bucketOf);
+
+    // Skipped passes leave the data where it is
+    if max reduce (bucketStarts[1..] - bucketStarts[..numBuckets-1]) != Dom.size then
+      sortedIntoScratch = !sortedIntoScratch;
+  }
+
+  if sortedIntoScratch then
+    Data = Scratch;
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc radixSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("radixSort() requires 1-D array");
+}
+
+
+pragma "no doc"
+/* Which bucket an element goes in for one pass of radixSort */
+record chpl_radixDigit {
+  var comparator;
+  const shift: int;
+  const mask: int;
+
+  inline proc this(a) {
+    return ((chpl_radixKey(a, comparator) >> shift) & mask:uint):int;
+  }
+}
+
+
+/*
+   Sort the 1D array `Data` in-place using a parallel sample sort algorithm.
+
+   The array is split into one piece per task on each locale it is
+   distributed over, and a sorted sample of its elements is used to choose
+   splitters dividing the data into as many buckets. Each piece copies its
+   elements into their buckets in parallel, which is where elements are
+   exchanged between locales for distributed arrays, and then each bucket
+   is sorted with :proc:`quickSort` on the locale where it starts.
+
+   Unlike :proc:`radixSort`, this works with any comparator.
+
+   :arg Data: The array to be sorted
+   :type Data: [] `eltType`
+   :arg comparator: :ref:`Comparator <comparators>` record that defines how the
+      data is sorted.
+
+ */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator) {
+  chpl_check_comparator(comparator, eltType);
+
+  // Samples taken per bucket
+  param oversample = 16;
+
+  const n = Dom.size,
+        numBuckets = chpl_sortNumChunks(Data, minlen=oversample*16);
+
+  if numBuckets == 1 {
+    quickSort(Data, comparator=comparator);
+    return;
+  }
+
+  // Take the samples from pseudo-random positions so that regular
+  // patterns in the data don't skew them, and pick every oversample'th
+  // one as a splitter.
+  const numSamples = numBuckets*oversample,
+        sampleSpacing = n / numSamples;
+  var Samples: [0..#numSamples] eltType;
+  for i in 0..#numSamples {
+    const offset = ((i:uint * 0x9E3779B97F4A7C15) % sampleSpacing:uint):int;
+    Samples[i] = Data[chpl_sortIndex(Dom, i*sampleSpacing + offset)];
+  }
+  quickSort(Samples, comparator=comparator);
+  var Splitters: [0..#numBuckets-1] eltType;
+  for b in 0..#numBuckets-1 do
+    Splitters[b] = Samples[(b+1)*oversample];
+
+  const bucketOf = new chpl_sampleBucket(eltType, numBuckets-1, Splitters,
+                                         comparator);
+  var Scratch: [Dom] eltType;
+  const bucketStarts = chpl_sortScatter(Data, Scratch, numBuckets, numBuckets,
+                                        bucketOf);
+
+  // Everything landed in one bucket, which can happen when most of the
+  // elements are equal.
+  if max reduce (bucketStarts[1..] - bucketStarts[..numBuckets-1]) == n {
+    quickSort(Data, comparator=comparator);
+    return;
+  }
+
+  coforall b in 0..#numBuckets with (ref Data) {
+    const positions = bucketStarts[b]..bucketStarts[b+1]-1;
+    if positions.size > 0 {
+      const indices = chpl_sortIndices(Dom, positions);
+      on Scratch[indices.low] {
+        var Bucket: [0..#positions.size] eltType = Scratch[indices];
+        quickSort(Bucket, comparator=comparator);
+        Data[indices] = Bucket;
+      }
+    }
+  }
+}
+
+
+pragma "no doc"
+/* Error message for multi-dimension arrays */
+proc sampleSort(Data: [?Dom] ?eltType, comparator:?rec=defaultComparator)
+  where Dom.rank != 1 {
+    compilerError("sampleSort() requires 1-D array");
+}
+
+
+pragma "no doc"
+/*
+   Which bucket an element goes in for sampleSort: the number of splitters
+   less than or equal to it. Copying the record copies the splitters, so
+   each locale gets its own.
+ */
+record chpl_sampleBucket {
+  type eltType;
+  const numSplitters: int;
+  var splitters: [0..#numSplitters] eltType;
+  var comparator;
+
+  inline proc this(a) {
+    var lo = 0,
+        hi = numSplitters;
+    while lo < hi {
+      const mid = lo + (hi - lo) / 2;
+      if chpl_compare(a, splitters[mid], comparator) < 0 then
+        hi = mid;
+      else
+        lo = mid + 1;
+    }
+    return lo;
+  }
+}
+
+
 /*
    Sort the 1D array `Data` in-place using a sequential selection sort
    algorithm.
@@ -775,6 +1271,12 @@ record ReverseComparator {
    */
   proc ReverseComparator(comparator:?rec=defaultComparator) {}
 
+  pragma "no doc"
+  /* The comparator this one reverses */
+  proc chpl_unreversed() {
+    return comparator;
+  }
+
   /*
    Reversed compare method defined based on ``comparator.key`` if defined,
    otherwise ``comparator.compare``.
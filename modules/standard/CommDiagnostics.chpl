@@ -137,6 +137,30 @@
   was executed on locale 0, and a remote get and a remote put were
   executed on locale 1.
 
+  **Remote Data Cache Counts**
+
+  When a program is compiled with ``--cache-remote``, each locale also
+  counts how its remote data cache handled the GETs and PUTs that went
+  through it.  These counts are always being collected, so they need no
+  start/stop calls.  They can be reset and retrieved across all locales
+  or for just the calling locale::
+
+    resetCacheDiagnostics();
+    // ... do some remote accesses ...
+    writeln(getCacheDiagnostics());
+
+  or::
+
+    resetCacheDiagnosticsHere();
+    // ... do some remote accesses ...
+    writeln(getCacheDiagnosticsHere());
+
+  Comparing ``get_hits`` against ``get_misses`` and ``get_partial_hits``
+  shows how often the cache avoided communication, and
+  ``prefetch_hits`` against ``prefetch_unused`` shows whether read ahead
+  is paying off.  When the cache is not in use all of these counts are
+  zero.
+
   **Studying Communication During Module Initialization**
 
   It is hard for a programmer to determine exactly what happens during
@@ -222,6 +246,60 @@ module CommDiagnostics
    */
   type commDiagnostics = chpl_commDiagnostics;
 
+  /* Aggregated remote data cache counts.  As for
+     :record:`chpl_commDiagnostics`, this duplicates the runtime's
+     definition of the record.  Most counts are in units of cache pages.
+   */
+  extern record chpl_cacheDiagnostics {
+    /*
+      GETs satisfied entirely from the cache
+     */
+    var get_hits: uint(64);
+    /*
+      GETs for which the cache held some but not all of the data
+     */
+    var get_partial_hits: uint(64);
+    /*
+      GETs for which the cache held none of the data
+     */
+    var get_misses: uint(64);
+    /*
+      pages requested by read ahead or explicit prefetches
+     */
+    var prefetches: uint(64);
+    /*
+      GETs satisfied by data that was prefetched
+     */
+    var prefetch_hits: uint(64);
+    /*
+      prefetched pages evicted before they were used
+     */
+    var prefetch_unused: uint(64);
+    /*
+      PUTs issued to write dirty data back to remote locales
+     */
+    var dirty_flushes: uint(64);
+    /*
+      pages that were used again soon after leaving the cache's
+      first-use queue and so were moved to its frequently-used queue
+     */
+    var promotions: uint(64);
+    /*
+      pages evicted to make room for other data
+     */
+    var evictions: uint(64);
+    /*
+      pages discarded because an acquire fence (for example, the start
+      of an ``on`` statement) made their contents stale
+     */
+    var acquire_invalidations: uint(64);
+  };
+
+  /*
+    The Chapel record type inherits the runtime definition of it.
+   */
+  type cacheDiagnostics = chpl_cacheDiagnostics;
+
   private extern proc chpl_startVerboseComm();
 
   private extern proc chpl_stopVerboseComm();
@@ -242,6 +320,10 @@ module CommDiagnostics
 
   private extern proc chpl_getCommDiagnosticsHere(out cd: commDiagnostics);
 
+  private extern proc chpl_resetCacheDiagnosticsHere();
+
+  private extern proc chpl_getCacheDiagnosticsHere(out cd: cacheDiagnostics);
+
   /*
     Start on-the-fly reporting of communication initiated on any locale.
    */
@@ -331,6 +413,47 @@ module CommDiagnostics
     return cd;
   }
 
+  /*
+    Reset remote data cache counts across the whole program.
+   */
+  proc resetCacheDiagnostics() {
+    for loc in Locales do on loc do
+      resetCacheDiagnosticsHere();
+  }
+
+  /*
+    Reset remote data cache counts on the calling locale.
+   */
+  inline proc resetCacheDiagnosticsHere() {
+    chpl_resetCacheDiagnosticsHere();
+  }
+
+  /*
+    Retrieve remote data cache counts for the whole program.
+
+    :returns: array of cache counts for each locale
+    :rtype: `[LocaleSpace] cacheDiagnostics`
+   */
+  proc getCacheDiagnostics() {
+    var D: [LocaleSpace] cacheDiagnostics;
+    for loc in Locales do on loc {
+      D(loc.id) = getCacheDiagnosticsHere();
+    }
+    return D;
+  }
+
+  /*
+    Retrieve remote data cache counts for this locale.
+
+    :returns: cache counts for this locale
+    :rtype: `cacheDiagnostics`
+   */
+  proc getCacheDiagnosticsHere() {
+    var cd: cacheDiagnostics;
+    chpl_getCacheDiagnosticsHere(cd);
+    return cd;
+  }
+
   /*
     If this is set, on-the-fly reporting of communication operations
     will be turned on before any module initialization begins and
@@ -431,9 +431,10 @@ module IO {
       NFS), we should open a local copy of that file and use that in the
       channel. (not sure how to avoid opening # channels copies of these files
       -- seems that we'd want some way to cache that...).
-    - Create leader/follower iterators for ItemReader/ItemWriter so that these
-      are as efficient as possible when working with fixed-size data types
-      (ie, they can open up channels that are not shared).
+    - Create leader/follower iterators for ItemWriter, and let ItemReader
+      split its region for fixed-size data types too (it only does so for
+      lines now), so that these are as efficient as possible (ie, they can
+      open up channels that are not shared).
 */
 
 use SysBasic;
@@ -668,6 +669,8 @@ extern const QIO_METHOD_FREADFWRITE:c_int;
 pragma "no doc"
 extern const QIO_METHOD_MMAP:c_int;
 pragma "no doc"
+extern const QIO_METHOD_URING:c_int;
+pragma "no doc"
 extern const QIO_METHODMASK:c_int;
 pragma "no doc"
 extern const QIO_HINT_RANDOM:c_int;
@@ -896,6 +899,7 @@ private extern proc qio_file_unlock(f:qio_file_ptr_t);
 private extern proc qio_file_sync(f:qio_file_ptr_t):syserr;
 
 private extern proc qio_channel_end_offset_unlocked(ch:qio_channel_ptr_t):int(64);
+private extern proc qio_channel_get_file(ch:qio_channel_ptr_t):qio_file_ptr_t;
 private extern proc qio_file_get_style(f:qio_file_ptr_t, ref style:iostyle);
 private extern proc qio_file_length(f:qio_file_ptr_t, ref len:int(64)):syserr;
 
@@ -942,6 +946,8 @@ private extern proc qio_channel_write_amt(threadsafe:c_int, ch:qio_channel_ptr_t
 pragma "no doc"
 // A specialization is needed for _ddata as the value is the pointer its memory
 private extern proc qio_channel_write_amt(threadsafe:c_int, ch:qio_channel_ptr_t, const ptr:_ddata, len:ssize_t):syserr;
+// and for c_ptr
+private extern proc qio_channel_write_amt(threadsafe:c_int, ch:qio_channel_ptr_t, const ptr:c_ptr, len:ssize_t):syserr;
 private extern proc qio_channel_write_byte(threadsafe:c_int, ch:qio_channel_ptr_t, byte:uint(8)):syserr;
 
 private extern proc qio_channel_offset_unlocked(ch:qio_channel_ptr_t):int(64);
@@ -2545,6 +2551,9 @@ proc file.reader(param kind=iokind.dynamic, param locking=true, start:int(64) =
 
 /* Iterate over all of the lines in a file.
 
+   The returned object can also be used in a ``forall`` loop, which reads
+   the lines in parallel (see :record:`ItemReader`).
+
    :arg error: optional argument to capture an error code. If this argument
                is not provided and an error is encountered, this function
                will halt with an error message.
@@ -4107,6 +4116,154 @@ proc channel.modifyStyle(f:func(iostyle, iostyle))
 }
 */
 
+/*
+   Support for reading the rest of a channel's region in parallel, used by
+   :record:`ItemReader` and by the RecordParser module. The region is split
+   into byte ranges that are each read by a separate channel. Readers start
+   each range at the first item that begins in it, so that an item
+   spanning two ranges is read by the range it starts in.
+ */
+
+pragma "no doc"
+// Regions are not split into byte ranges smaller than this
+const _parallelReadMinRange:int(64) = 64 * 1024;
+
+pragma "no doc"
+// Returns the file a reading channel uses, the channel's offset and the
+// end of the channel's region in that file
+proc channel._parallelReadRegion():(file, int(64), int(64)) {
+  var f:file;
+  var start:int(64);
+  var end:int(64);
+
+  on this.home {
+    var ret:file;
+    this.lock();
+    ret.home = here;
+    ret._file_internal = qio_channel_get_file(_channel_internal);
+    qio_file_retain(ret._file_internal);
+    start = qio_channel_offset_unlocked(_channel_internal);
+    end = qio_channel_end_offset_unlocked(_channel_internal);
+    this.unlock();
+    f = ret;
+  }
+
+  return (f, start, min(end, f.length()));
+}
+
+pragma "no doc"
+// Whether a and b are the same open file, so that a byte range of a
+// region of one is the same byte range of the other
+proc _parallelReadSameFile(a:file, b:file):bool {
+  return a.home == b.home &&
+         __primitive("==", a._file_internal, b._file_internal);
+}
+
+pragma "no doc"
+// Serially, the region is a single range
+iter _parallelReadRanges(f:file, start:int(64), end:int(64), split:bool) {
+  if start < end then
+    yield (start, end, f);
+}
+
+pragma "no doc"
+// Yields (range start, range end, file) for each byte range of
+// start..end-1, on the locale that should read that range. The follower
+// passes these on, so that forall loops that yield can use it.
+//
+// Ranges are a multiple of the file system's chunk size (see
+// file.getchunk), and each is read on one of the locales that
+// file.localesForRegion suggests for it. Locales other than f.home read
+// the file by opening its path, so the file must be available at the
+// same path there. If the file has no path, every range is read on
+// f.home. If split is false, the whole region is one range.
+iter _parallelReadRanges(param tag:iterKind, f:file, start:int(64),
+                         end:int(64), split:bool)
+  where tag == iterKind.leader {
+
+  const tasksPerLocale = if dataParTasksPerLocale == 0 then here.maxTaskPar
+                         else dataParTasksPerLocale;
+  const len = end - start;
+  var path:string;
+  var chunk:int(64) = 1;
+
+  if len <= 0 then return;
+
+  on f.home {
+    var tmp:c_string_copy;
+    var chunkLen:int(64);
+    if !qio_file_path(f._file_internal, tmp) then
+      path = new string(tmp, needToCopy=false);
+    if !qio_get_chunk(f._file_internal, chunkLen) && chunkLen > 0 then
+      chunk = chunkLen;
+  }
+
+  const useLocales = if path == "" then 1 else numLocales;
+
+  // A few ranges per task, handed out as tasks become free below
+  var rangeSize = len;
+  if split {
+    rangeSize = max(_parallelReadMinRange,
+                    divceil(len, 4 * useLocales * tasksPerLocale));
+    rangeSize = divceil(rangeSize, chunk) * chunk;
+  }
+
+  const numRanges = divceil(len, rangeSize):int;
+
+  // Range boundaries other than start and end fall on chunk boundaries
+  proc bound(i:int):int(64) {
+    if i == 0 then return start;
+    if i == numRanges then return end;
+    return (start / chunk) * chunk + i * rangeSize;
+  }
+
+  var owner:[0..#numRanges] int = f.home.id;
+
+  if useLocales > 1 {
+    for i in 0..#numRanges {
+      // Spread the ranges over the locales suggested for them
+      const locs = f.localesForRegion(bound(i), bound(i+1));
+      var pick = i % locs.numIndices;
+      for loc in locs {
+        if pick == 0 {
+          owner[i] = loc.id;
+          break;
+        }
+        pick -= 1;
+      }
+    }
+  }
+
+  coforall loc in Locales do on loc {
+    const myOwner = owner;
+
+    const myNumRanges = + reduce (myOwner == here.id);
+
+    if myNumRanges > 0 {
+      const rf = if here == f.home then f else open(path, iomode.r);
+
+      // Each task takes the next range when it finishes one, so that
+      // faster tasks take on more of the region
+      var next: atomic int;
+      coforall tid in 0..#min(tasksPerLocale, myNumRanges) {
+        var i = next.fetchAdd(1);
+        while i < numRanges {
+          if myOwner[i] == here.id then
+            yield (bound(i), bound(i+1), rf);
+          i = next.fetchAdd(1);
+        }
+      }
+    }
+  }
+}
+
+pragma "no doc"
+iter _parallelReadRanges(param tag:iterKind, f:file, start:int(64),
+                         end:int(64), split:bool, followThis)
+  where tag == iterKind.follower {
+  yield followThis;
+}
+
 /* Wrapper class on a channel to make it only read values
    of a single type. Also supports an iterator yielding
    the read values.
@@ -4139,6 +4296,104 @@ record ItemReader {
     }
   }
 
+  /* Iterate in parallel through the items read from the rest of the
+     channel's region.
+
+     When the items are lines, as for :proc:`file.lines`, the region is
+     split into byte ranges that are read by separate channels, possibly
+     on several locales. Other items are read by a single task.
+
+     Each range is read with the style the channel has when the iteration
+     starts. The channel itself is not advanced.
+
+     When this leads a zippered ``forall``, other readers of the same
+     lines of the same file follow it range by range. Any other reader
+     can only follow it when the region is small enough to be read as
+     one range, and the loop halts otherwise.
+   */
+  iter these(param tag:iterKind) where tag == iterKind.standalone {
+    const (fl, start, end) = ch._parallelReadRegion();
+    const style = ch._style();
+    const split = _readsLines(style);
+
+    forall (rangeStart, rangeEnd, rf) in _parallelReadRanges(fl, start, end,
+                                                             split) do
+      for x in _readRange(rf, start, end, rangeStart, rangeEnd, style) do
+        yield x;
+  }
+
+  pragma "no doc"
+  // Lines are not aligned with anything else, so zippering this with
+  // other iterators does not make sense.
+  iter these(param tag:iterKind) where tag == iterKind.leader {
+    const (fl, start, end) = ch._parallelReadRegion();
+    const style = ch._style();
+    const split = _readsLines(style);
+
+    forall (rangeStart, rangeEnd, rf) in _parallelReadRanges(fl, start, end,
+                                                             split) do
+      yield (fl, start, end, rangeStart, rangeEnd, rf, style);
+  }
+
+  pragma "no doc"
+  // When the leader reads its region as a single range, this reads all
+  // of its own region.  Otherwise the leader's byte ranges only hold the
+  // same lines for a reader of the same lines of the same file, so
+  // following any other reader halts.
+  iter these(param tag:iterKind, followThis) where tag == iterKind.follower {
+    const (leadFile, leadStart, leadEnd, rangeStart, rangeEnd, rf,
+           leadStyle) = followThis;
+    const (fl, start, end) = ch._parallelReadRegion();
+    const style = ch._style();
+
+    if rangeStart == leadStart && rangeEnd == leadEnd {
+      for x in _readRange(fl, start, end, start, end, style) do
+        yield x;
+    } else {
+      if !_parallelReadSameFile(fl, leadFile) || start != leadStart ||
+         end != leadEnd || style != leadStyle || !_readsLines(style) then
+        halt("a parallel read of lines can only be zippered with the ",
+             "lines of the same region of the same file");
+
+      for x in _readRange(rf, start, end, rangeStart, rangeEnd, style) do
+        yield x;
+    }
+  }
+
+  pragma "no doc"
+  // A reader can find where the next line starts from anywhere in the
+  // file, so lines can be split into byte ranges
+  proc _readsLines(style:iostyle):bool {
+    if ItemType != string then return false;
+    return style.string_format == QIO_STRING_FORMAT_TOEND &&
+           style.string_end == 0x0a;
+  }
+
+  pragma "no doc"
+  // Yields the items that start in rangeStart..rangeEnd-1 of the region
+  // start..end-1 of rf. Unless the range starts the region, the line
+  // before the range's first complete line belongs to the previous range.
+  iter _readRange(rf:file, start:int(64), end:int(64),
+                  rangeStart:int(64), rangeEnd:int(64), style:iostyle) {
+    const skip = rangeStart != start;
+    var r = rf.reader(kind=kind, locking=false,
+                      start=if skip then rangeStart - 1 else rangeStart,
+                      end=end, style=style);
+
+    if skip {
+      var partial:ItemType;
+      r.read(partial);
+    }
+
+    while r.offset() < rangeEnd {
+      var x:ItemType;
+      if !r.read(x) then break;
+      yield x;
+    }
+
+    r.close();
+  }
+
   /* It would be nice to be able to handle errors
      when reading with these()
      but it's not clear how to get the error argument
@@ -4358,7 +4613,7 @@ proc file.localesForRegion(start:int(64), end:int(64)) {
 
   proc findloc(loc:string, locs:c_ptr(c_string), end:int) {
     for i in 0..end-1 {
-      if (loc == locs[i]) then
+      if (loc == locs[i]:string) then
         return true;
     }
     return false;
@@ -19,13 +19,14 @@
 
 /*
   The :mod:`Memory` module provides procedures which report information
-  about memory usage.  With one exception, to use these procedures you
+  about memory usage.  With two exceptions, to use these procedures you
   must enable memory tracking.  Do this by setting one or more of the
   config vars below, using appropriate ``--configVarName=value`` or
   ``-sconfigVarName=value`` command line options when you run the
   program.  If memory tracking is not enabled, calling any procedure
-  described here, other than :proc:`locale.physicalMemory`, will cause
-  the program to halt with an error message.
+  described here, other than :proc:`locale.physicalMemory` and
+  :proc:`useTaskArena`, will cause the program to halt with an error
+  message.
 
   ``memTrack``: `bool`:
     Enable memory tracking.  This causes memory allocations and
@@ -81,6 +82,30 @@
     In multilocale executions each top-level locale produces output
     to its own file, with a dot ('.') and the locale ID appended to
     this path.
+
+  The following config variables control the sampling allocation
+  profiler.  It is independent of memory tracking and cheap enough to
+  leave on in long runs.
+
+  ``memSampleRate``: `uint`:
+    If this is set to a value greater than 0 (zero), sample one
+    allocation per this many bytes allocated, on average, and charge
+    each sample to its allocation type and source location.  The
+    resulting heap profile estimates the live and total allocated
+    memory and number of allocations for each of these, and is printed
+    when the program terminates normally.  A value of 1 samples every
+    allocation, which makes the profile exact.  A value around 512K
+    costs little and still finds the main consumers of memory.
+
+  ``memSampleInterval``: `uint`:
+    If this is set to a value greater than 0 (zero), also print the
+    heap profile each time about this many more bytes have been
+    allocated.
+
+  ``memSampleLog``: `c_string`:
+    Heap profiles are written to this file rather than to the memory
+    reporting file set by ``memLog``, with the locale ID appended in
+    multilocale executions as for ``memLog``.
  */
 module Memory {
 
@@ -239,4 +264,28 @@ proc stopVerboseMemHere() {
   chpl_stopVerboseMemHere();
 }
 
+/*
+  Have the calling task allocate its small objects (up to 4 KiB) from
+  an arena of its own until it ends, instead of from the shared heap.
+  Allocating from the arena just bumps a pointer, and its memory is
+  given back in 64 KiB chunks once the task has ended and everything
+  in a chunk has been freed.  Objects that outlive the task remain
+  valid.  This suits tasks that make many short-lived allocations,
+  like the string temporaries in the body of a ``forall`` loop::
+
+    forall i in 1..n {
+      useTaskArena();
+      const s = "item " + i:string;
+      ...
+    }
+
+  Calling this again in a task that already has an arena does nothing.
+  Arenas are only used in single-locale runs, because their memory
+  can't take part in communication; elsewhere this call has no effect.
+ */
+proc useTaskArena() {
+  extern proc chpl_mem_arena_use();
+  chpl_mem_arena_use();
+}
+
 }
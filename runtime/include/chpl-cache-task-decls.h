@@ -20,9 +20,13 @@
 #ifndef _chpl_cache_task_decls_h_
 #define _chpl_cache_task_decls_h_
 
+struct rdcache_s;
+
 // This is the type of the task private data used by the cache
 typedef struct {
   int64_t last_acquire; // cache acquire barrier sets this
+  struct rdcache_s* cache; // pthread cache last_acquire refers to
+  int in_cache_op; // nonzero while this task is inside the cache
 } chpl_cache_taskPrvData_t;
 
 #endif
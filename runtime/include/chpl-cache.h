@@ -60,6 +60,32 @@ void chpl_cache_release(int ln, int32_t fn)
   if (chpl_cache_enabled()) chpl_cache_fence(0, 1, ln, fn);
 }
 
+// The tasking layer calls these around any point where the running task
+// could resume on a different pthread (a yield under a scheduler that can
+// move tasks between workers, or an explicit migration).  It may also call
+// chpl_cache_migrate_end() alone after a point where the task should
+// resume on the same pthread, to catch a move it did not expect.
+// chpl_cache_migrate_begin() completes this thread's pending PUTs and
+// returns nonzero if the task may move. It returns 0 if the task is in
+// the middle of a cache operation (a comm wait inside the cache can
+// yield), in which case the tasking layer must keep it on this pthread.
+// chpl_cache_migrate_end() discards stale GET values if the task now
+// runs against a different pthread's cache.
+int chpl_cache_migrate_begin(void);
+void chpl_cache_migrate_end(void);
+
+static inline
+int chpl_cache_task_may_migrate(void)
+{
+  if (chpl_cache_enabled()) return chpl_cache_migrate_begin();
+  return 1;
+}
+static inline
+void chpl_cache_task_resumed(void)
+{
+  if (chpl_cache_enabled()) chpl_cache_migrate_end();
+}
+
 
 // These are the functions that the generated code should be eventually
 // calling on a put or a get.
@@ -87,6 +113,20 @@ void  chpl_cache_comm_put_strd(
 void chpl_cache_print(void);
 void chpl_cache_assert_released(void);
 
+#else
+// ifdef HAS_CHPL_CACHE_FNS
+
+// Without a cache, tasks are always free to move.
+static inline
+int chpl_cache_task_may_migrate(void)
+{
+  return 1;
+}
+static inline
+void chpl_cache_task_resumed(void)
+{
+}
+
 #endif
 // ifdef HAS_CHPL_CACHE_FNS
 
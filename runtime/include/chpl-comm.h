@@ -350,6 +350,16 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode,
                      int32_t stridelevels, size_t elemSize, int32_t typeIndex, 
                      int32_t commID, int ln, int32_t fn);
 
+//
+// Do the copy described by the arguments to chpl_comm_put_strd() or
+// chpl_comm_get_strd() when both addresses are on this node.  This is
+// shared by the comm layers, which call it for their local cases.
+//
+void chpl_comm_strd_local_copy(void* dstaddr, size_t* dststrides,
+                               void* srcaddr, size_t* srcstrides,
+                               size_t* count, int32_t stridelevels,
+                               size_t elemSize);
+
 //
 // Get a local copy of a wide string.
 //
@@ -425,6 +435,23 @@ typedef struct _chpl_commDiagnostics {
   uint64_t execute_on_nb;
 } chpl_commDiagnostics;
 
+//
+// Remote data cache diagnostics. These are collected all of the time
+// (when the cache is enabled), separately by each pthread's cache.
+//
+typedef struct _chpl_cacheDiagnostics {
+  uint64_t get_hits;
+  uint64_t get_partial_hits;
+  uint64_t get_misses;
+  uint64_t prefetches;
+  uint64_t prefetch_hits;
+  uint64_t prefetch_unused;
+  uint64_t dirty_flushes;
+  uint64_t promotions;
+  uint64_t evictions;
+  uint64_t acquire_invalidations;
+} chpl_cacheDiagnostics;
+
 void chpl_startVerboseComm(void);
 void chpl_stopVerboseComm(void);
 void chpl_startVerboseCommHere(void);
@@ -440,6 +467,8 @@ void chpl_stopCommDiagnosticsHere(void);
 void chpl_gen_stopCommDiagnosticsHere(void);
 void chpl_resetCommDiagnosticsHere(void);
 void chpl_getCommDiagnosticsHere(chpl_commDiagnostics *cd);
+void chpl_resetCacheDiagnosticsHere(void); // implemented in chpl-cache.c
+void chpl_getCacheDiagnosticsHere(chpl_cacheDiagnostics *cd);
 
 #else // LAUNCHER
 
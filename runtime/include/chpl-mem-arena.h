@@ -0,0 +1,112 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _chpl_mem_arena_H_
+#define _chpl_mem_arena_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Per-task arenas.
+//
+// After a task calls chpl_mem_arena_use() (Memory.useTaskArena() in
+// Chapel), its small allocations are carved out of 64 KiB chunks by
+// bumping a pointer instead of going to the heap.  Freeing such an
+// object just counts it off in its chunk.  A chunk goes back to the
+// arena free list as a whole once the task is done allocating from it
+// and every object in it has been freed, so an object that outlives
+// its task stays valid and simply keeps its chunk around until it too
+// is freed.
+//
+// The chunks are all carved out of one large reserved address range,
+// so telling whether a pointer came from an arena is a range check.
+//
+
+#define CHPL_MEM_ARENA_CHUNK_SIZE ((size_t) 1 << 16)
+
+// Larger allocations always come from the heap.
+#define CHPL_MEM_ARENA_MAX_ALLOC ((size_t) 4096)
+
+// Each object is preceded by a header holding its size.
+#define CHPL_MEM_ARENA_HDR_SIZE ((size_t) 16)
+
+struct chpl_mem_arenaChunk_s;
+
+// The arena state kept in the task private data.
+typedef struct {
+  char* next;                           // next free byte in the chunk
+  char* end;                            // end of the chunk
+  struct chpl_mem_arenaChunk_s* chunk;  // current chunk
+  int64_t numAllocs;                    // objects allocated from it
+  int inUse;
+} chpl_mem_taskArena_t;
+
+// Reserved address range; the size stays 0 until arenas are first used.
+extern uintptr_t chpl_mem_arena_base;
+extern size_t chpl_mem_arena_size;
+
+// Number of running tasks that are using an arena.
+extern volatile int chpl_mem_arena_numActive;
+
+// Start using an arena in the calling task, until it ends.
+void chpl_mem_arena_use(void);
+
+// Called by the tasking layer once a task's body has returned.
+void chpl_mem_arena_taskEnd(chpl_mem_taskArena_t* arena);
+
+// Stop handing out arena memory, when the program is exiting.
+void chpl_mem_arena_exit(void);
+
+void* chpl_mem_arena_alloc_slow(chpl_mem_taskArena_t* arena, size_t size);
+void chpl_mem_arena_free(void* memAlloc);
+
+static inline
+int chpl_mem_arena_owns(void* memAlloc) {
+  return (uintptr_t) memAlloc - chpl_mem_arena_base < chpl_mem_arena_size;
+}
+
+static inline
+size_t chpl_mem_arena_allocSize(void* memAlloc) {
+  return *(size_t*) ((char*) memAlloc - CHPL_MEM_ARENA_HDR_SIZE);
+}
+
+static inline
+void* chpl_mem_arena_allocFrom(chpl_mem_taskArena_t* arena, size_t size) {
+  const size_t need = CHPL_MEM_ARENA_HDR_SIZE + ((size + 15) & ~(size_t) 15);
+  char* p = arena->next;
+
+  if (need > (size_t) (arena->end - p))
+    return chpl_mem_arena_alloc_slow(arena, size);
+
+  arena->next = p + need;
+  arena->numAllocs++;
+  *(size_t*) p = size;
+  return p + CHPL_MEM_ARENA_HDR_SIZE;
+}
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif // _chpl_mem_arena_H_
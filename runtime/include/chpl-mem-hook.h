@@ -29,8 +29,9 @@
 #include "chpltypes.h"
 #include "error.h"
 
-// Need memory tracking prototypes for inlined memory routines
+// Need memory tracking and sampling prototypes for inlined memory routines
 #include "chplmemtrack.h"
+#include "chpl-mem-sample.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -90,6 +91,9 @@ void chpl_memhook_malloc_post(void* memAlloc,
     chpl_memhook_check_post(memAlloc, description, lineno, filename);
   if (CHPL_MEMHOOKS_ACTIVE)
     chpl_track_malloc(memAlloc, number, size, description, lineno, filename);
+  if (chpl_memSampleRate != 0)
+    chpl_mem_sample_malloc(memAlloc, number * size, description,
+                           lineno, filename);
 }
 
 
@@ -101,6 +105,8 @@ void chpl_memhook_free_pre(void* memAlloc,
     chpl_memhook_check_pre(0, 0, 0, lineno, filename);
     chpl_track_free(memAlloc, lineno, filename);
   }
+  if (chpl_memSampleRate != 0)
+    chpl_mem_sample_free(memAlloc);
 }
 
 
@@ -125,6 +131,9 @@ void chpl_memhook_realloc_post(void* moreMemAlloc, void* memAlloc,
   if (CHPL_MEMHOOKS_ACTIVE)
     chpl_track_realloc_post(moreMemAlloc, memAlloc, size, description,
                        lineno, filename);
+  if (chpl_memSampleRate != 0)
+    chpl_mem_sample_realloc(moreMemAlloc, memAlloc, size, description,
+                            lineno, filename);
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,141 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _chpl_mem_sample_H_
+#define _chpl_mem_sample_H_
+
+#ifndef LAUNCHER
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include "chpl-mem-desc.h"
+#include "chpl-thread-local-storage.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//
+// Sampling allocation profiler.
+//
+// When --memSampleRate is set, one allocation is sampled per that many
+// bytes allocated on average, with the intervals between samples drawn
+// from an exponential distribution (Poisson sampling).  Each sample is
+// charged to its description and source location, scaled up by the
+// inverse of the probability that it was sampled, and the resulting
+// heap profile is dumped periodically and at normal termination.
+//
+// The allocation side costs one thread-local subtraction unless the
+// allocation is sampled, and the free side costs two loads from a
+// filter of sampled addresses, which is kept sparse as the number of
+// live samples grows, so sampling can stay on in long runs.
+//
+
+// Mean number of bytes between samples; 0 turns sampling off.
+extern size_t chpl_memSampleRate;
+
+void chpl_mem_sample_init(size_t rate, size_t interval, FILE* logFile);
+void chpl_mem_sample_report(void);
+
+void chpl_mem_sample_malloc_slow(void* memAlloc, size_t size,
+                                 chpl_mem_descInt_t description,
+                                 int32_t lineno, int32_t filename);
+void chpl_mem_sample_free_slow(void* memAlloc);
+void chpl_mem_sample_realloc_slow(void* moreMemAlloc, void* memAlloc,
+                                  size_t size);
+
+#ifdef CHPL_TLS
+// Bytes this thread may still allocate before the next sample
+extern CHPL_TLS int64_t chpl_mem_sample_bytesLeft;
+#endif
+
+// Bit i of the filter is set when a sampled, live allocation hashes to
+// i.  The filter grows with the number of live samples, so that it stays
+// sparse and few frees of unsampled allocations get past it.  It only
+// changes while the profiler's lock is held.  A free reads it without
+// the lock, which is safe because the task freeing an allocation has
+// synchronized with the task that allocated it, and the allocation's
+// bit is set in every filter published after that until it is freed.
+typedef struct {
+  int log2Bits;
+  volatile uint64_t* words;
+} chpl_mem_sample_filter_t;
+
+extern chpl_mem_sample_filter_t* volatile chpl_mem_sample_filter;
+
+static inline
+uint64_t chpl_mem_sample_filterIndex(void* memAlloc, int log2Bits) {
+  uint64_t x = (uint64_t)(uintptr_t)memAlloc >> 4;
+  return (x * UINT64_C(0x9E3779B97F4A7C15)) >> (64 - log2Bits);
+}
+
+
+static inline
+int chpl_mem_sample_maybeSampled(void* memAlloc) {
+  const chpl_mem_sample_filter_t* f = chpl_mem_sample_filter;
+  uint64_t i = chpl_mem_sample_filterIndex(memAlloc, f->log2Bits);
+  return (f->words[i / 64] & (UINT64_C(1) << (i % 64))) != 0;
+}
+
+
+static inline
+void chpl_mem_sample_malloc(void* memAlloc, size_t size,
+                            chpl_mem_descInt_t description,
+                            int32_t lineno, int32_t filename) {
+#ifdef CHPL_TLS
+  chpl_mem_sample_bytesLeft -= (int64_t)size;
+  if (chpl_mem_sample_bytesLeft >= 0)
+    return;
+#endif
+  chpl_mem_sample_malloc_slow(memAlloc, size, description, lineno, filename);
+}
+
+
+static inline
+void chpl_mem_sample_free(void* memAlloc) {
+  if (memAlloc != NULL && chpl_mem_sample_maybeSampled(memAlloc))
+    chpl_mem_sample_free_slow(memAlloc);
+}
+
+
+//
+// A sampled allocation that is reallocated stays sampled and is moved
+// to its new address.  It is not counted as another allocation, but
+// the bytes it grows by are counted as allocated.  An unsampled one
+// stays unsampled.
+//
+static inline
+void chpl_mem_sample_realloc(void* moreMemAlloc, void* memAlloc,
+                             size_t size, chpl_mem_descInt_t description,
+                             int32_t lineno, int32_t filename) {
+  if (memAlloc == NULL)
+    chpl_mem_sample_malloc(moreMemAlloc, size, description,
+                           lineno, filename);
+  else if (moreMemAlloc != NULL && chpl_mem_sample_maybeSampled(memAlloc))
+    chpl_mem_sample_realloc_slow(moreMemAlloc, memAlloc, size);
+}
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif // LAUNCHER
+
+#endif // _chpl_mem_sample_H_
@@ -70,13 +70,36 @@ int chpl_mem_inited(void);
 static chpl_bool chpl_mem_alloc_localizes(void);
 static size_t chpl_mem_localizationThreshold(void);
 
+// Allocate from the current task's arena, if it is using one and the
+// size is small enough, else return NULL.  See chpl-mem-arena.h.
+static inline
+void* chpl_mem_taskArenaAlloc(size_t size) {
+  chpl_task_prvData_t* prvData;
+
+  if (chpl_mem_arena_numActive == 0 || size > CHPL_MEM_ARENA_MAX_ALLOC)
+    return NULL;
+  prvData = chpl_task_getPrvData();
+  if (prvData == NULL || !prvData->mem_arena.inUse)
+    return NULL;
+  return chpl_mem_arena_allocFrom(&prvData->mem_arena, size);
+}
+
+static inline
+void chpl_mem_heapOrArenaFree(void* memAlloc) {
+  if (chpl_mem_arena_owns(memAlloc))
+    chpl_mem_arena_free(memAlloc);
+  else
+    chpl_free(memAlloc);
+}
+
 static inline
 void* chpl_mem_allocMany(size_t number, size_t size,
                          chpl_mem_descInt_t description,
                          int32_t lineno, int32_t filename) {
   void* memAlloc;
   chpl_memhook_malloc_pre(number, size, description, lineno, filename);
-  memAlloc = chpl_malloc(number*size);
+  if ((memAlloc = chpl_mem_taskArenaAlloc(number*size)) == NULL)
+    memAlloc = chpl_malloc(number*size);
   chpl_memhook_malloc_post(memAlloc, number, size, description,
                            lineno, filename);
   return memAlloc;
@@ -94,7 +117,10 @@ void* chpl_mem_allocManyZero(size_t number, size_t size,
                              int32_t lineno, int32_t filename) {
   void* memAlloc;
   chpl_memhook_malloc_pre(number, size, description, lineno, filename);
-  memAlloc = chpl_calloc(number, size);
+  if ((memAlloc = chpl_mem_taskArenaAlloc(number*size)) != NULL)
+    memset(memAlloc, 0, number*size);
+  else
+    memAlloc = chpl_calloc(number, size);
   chpl_memhook_malloc_post(memAlloc, number, size, description,
                            lineno, filename);
   return memAlloc;
@@ -117,10 +143,19 @@ void* chpl_mem_realloc(void* memAlloc, size_t size,
                            lineno, filename);
   if (size == 0) {
     chpl_memhook_free_pre(memAlloc, lineno, filename);
-    chpl_free(memAlloc);
+    chpl_mem_heapOrArenaFree(memAlloc);
     return NULL;
   }
-  moreMemAlloc = chpl_realloc(memAlloc, size);
+  if (chpl_mem_arena_owns(memAlloc)) {
+    // Arena objects can't grow in place; move this one to the heap.
+    if ((moreMemAlloc = chpl_malloc(size)) != NULL) {
+      size_t oldSize = chpl_mem_arena_allocSize(memAlloc);
+      memcpy(moreMemAlloc, memAlloc, (oldSize < size) ? oldSize : size);
+      chpl_mem_arena_free(memAlloc);
+    }
+  } else {
+    moreMemAlloc = chpl_realloc(memAlloc, size);
+  }
   chpl_memhook_realloc_post(moreMemAlloc, memAlloc, size, description,
                             lineno, filename);
   return moreMemAlloc;
@@ -129,7 +164,7 @@ void* chpl_mem_realloc(void* memAlloc, size_t size,
 static inline
 void chpl_mem_free(void* memAlloc, int32_t lineno, int32_t filename) {
   chpl_memhook_free_pre(memAlloc, lineno, filename);
-  chpl_free(memAlloc);
+  chpl_mem_heapOrArenaFree(memAlloc);
 }
 
 static inline
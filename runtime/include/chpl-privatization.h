@@ -22,16 +22,44 @@
 #ifndef LAUNCHER
 #include <stdint.h>
 #include "chpltypes.h"
+#include "chpl-atomics.h"
+#include "chpl-bitops.h"
 
 void chpl_privatization_init(void);
 
 void chpl_newPrivatizedClass(void*, int64_t);
 
+//
+// Privatized objects are stored in a segmented table that never moves
+// once an entry is written, so lookups need no locking. Segment s holds
+// (CHPL_PRIVATIZATION_SEGMENT0_SIZE << s) entries and is allocated the
+// first time a pid in its range is registered, so adding a segment
+// doubles the capacity of the table.
+//
+#define CHPL_PRIVATIZATION_SEGMENT0_BITS 6
+#define CHPL_PRIVATIZATION_SEGMENT0_SIZE (1 << CHPL_PRIVATIZATION_SEGMENT0_BITS)
+#define CHPL_PRIVATIZATION_NUM_SEGMENTS (64 - CHPL_PRIVATIZATION_SEGMENT0_BITS)
+
+// Each segment pointer is really a void**.
+extern atomic_uintptr_t chpl_privateObjects[CHPL_PRIVATIZATION_NUM_SEGMENTS];
+
+// Find the segment containing pid i and i's index within that segment.
+static inline int chpl_privatizationSegment(int64_t i, uint64_t* idx) {
+  uint64_t n = (uint64_t) i + CHPL_PRIVATIZATION_SEGMENT0_SIZE;
+  int seg = (63 - (int) chpl_bitops_clz_64(n))
+            - CHPL_PRIVATIZATION_SEGMENT0_BITS;
+  *idx = n - ((uint64_t) CHPL_PRIVATIZATION_SEGMENT0_SIZE << seg);
+  return seg;
+}
+
 // Implementation is here for performance: getPrivatizedClass can be called
 // frequently, so putting it in a header allows the backend to fully optimize.
-extern void** chpl_privateObjects;
 static inline void* chpl_getPrivatizedClass(int64_t i) {
-  return chpl_privateObjects[i];
+  uint64_t idx;
+  int seg = chpl_privatizationSegment(i, &idx);
+  void** objs = (void**) atomic_load_explicit_uintptr_t(
+                           &chpl_privateObjects[seg], memory_order_acquire);
+  return objs[idx];
 }
 
 void chpl_clearPrivatizedClass(int64_t);
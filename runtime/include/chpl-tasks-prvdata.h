@@ -23,9 +23,13 @@
 // This header file provides chpl_comm_taskPrvData_t
 #include "chpl-comm-task-decls.h"
 
+// This header file provides chpl_mem_taskArena_t
+#include "chpl-mem-arena.h"
+
 // The type for task private data
 typedef struct {
   chpl_comm_taskPrvData_t comm_data;
+  chpl_mem_taskArena_t mem_arena;
 } chpl_task_prvData_t;
 
 #endif
@@ -262,7 +262,9 @@ void      chpl_task_setSerial(chpl_bool);
 // is defined in chpl-tasks-prvdata.h in order to support
 // proper initialization order with a task model .h
 
-// Get pointer to task private data.
+// Get pointer to task private data.  Returns NULL when called from a
+// thread that isn't running a task, such as one the tasking layer is
+// still setting up.
 #ifndef CHPL_TASK_GET_PRVDATA_IMPL_DECL
 chpl_task_prvData_t* chpl_task_getPrvData(void);
 #endif
@@ -0,0 +1,51 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Event tracer (Chrome Trace Event format)
+//
+// When the CHPL_RT_TRACE_FILE environment variable is set, the runtime
+// installs task and comm callbacks that record task create, begin and
+// end events and put, get and executeOn events.  Each thread appends
+// the events it sees to a ring buffer of its own without locking, and a
+// writer thread writes the buffers out in the background.  Each locale
+// writes the JSON file $CHPL_RT_TRACE_FILE-<locale ID>.json, which can
+// be loaded into chrome://tracing or the Perfetto UI.  The timestamps
+// come from chpl_now_timevalue(), so the files from different locales
+// can be viewed on one timeline if their clocks are synchronized.
+//
+
+#ifndef _chpl_trace_h_
+#define _chpl_trace_h_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Start tracing on this locale if CHPL_RT_TRACE_FILE is set.
+void chpl_trace_init(void);
+
+// Stop tracing and write out whatever is still buffered.
+void chpl_trace_exit(void);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif
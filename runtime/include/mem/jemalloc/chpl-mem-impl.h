@@ -56,24 +56,46 @@
 #define CHPL_JE_FREE CHPL_JE_(free)
 #define CHPL_JE_NALLOCX CHPL_JE_(nallocx)
 #define CHPL_JE_MALLCTL CHPL_JE_(mallctl)
+#define CHPL_JE_MALLOCX CHPL_JE_(mallocx)
+#define CHPL_JE_RALLOCX CHPL_JE_(rallocx)
+
+// Under a locale model with sublocales, allocations made while running
+// on a sublocale come from an arena bound to its NUMA domain.  These
+// are not used until chpl_mem_layerInit() has created those arenas.
+extern unsigned chpl_je_numa_num_arenas;
+void* chpl_je_numa_alloc(size_t size, int flags);
+void* chpl_je_numa_realloc(void* ptr, size_t size);
 
 static inline void* chpl_calloc(size_t n, size_t size) {
+  if (chpl_je_numa_num_arenas > 0 && n > 0 && size > 0
+      && n <= SIZE_MAX / size) {
+    return chpl_je_numa_alloc(n * size, MALLOCX_ZERO);
+  }
   return CHPL_JE_CALLOC(n,size);
 }
 
 static inline void* chpl_malloc(size_t size) {
+  if (chpl_je_numa_num_arenas > 0 && size > 0) {
+    return chpl_je_numa_alloc(size, MALLOCX_NO_FLAGS);
+  }
   return CHPL_JE_MALLOC(size);
 }
 
 static inline void* chpl_memalign(size_t boundary, size_t size) {
   void* ret = NULL;
   int rc;
+  if (chpl_je_numa_num_arenas > 0 && size > 0) {
+    return chpl_je_numa_alloc(size, MALLOCX_ALIGN(boundary));
+  }
   rc = CHPL_JE_POSIX_MEMALIGN(&ret, boundary, size);
   if( rc == 0 ) return ret;
   else return NULL;
 }
 
 static inline void* chpl_realloc(void* ptr, size_t size) {
+  if (chpl_je_numa_num_arenas > 0 && ptr != NULL && size > 0) {
+    return chpl_je_numa_realloc(ptr, size);
+  }
   return CHPL_JE_REALLOC(ptr, size);
 }
 
@@ -341,6 +341,8 @@ char* qio_chtype_to_string(qio_chtype_t type);
      -- noreuse -- pread/pwrite
      -- cached -- mmap for reads and writes
      -- force_readwrite
+     -- uring -- only when requested; io_uring read-ahead and
+                 write-behind, or pread/pwrite if io_uring is unavailable
  */
 
 #define QIO_HINT_AFTERCHTYPE 0x0010
@@ -351,13 +353,14 @@ typedef enum {
   QIO_METHOD_FREADFWRITE = 3*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MMAP = 4*QIO_HINT_AFTERCHTYPE,
   QIO_METHOD_MEMORY = 5*QIO_HINT_AFTERCHTYPE,
+  QIO_METHOD_URING = 6*QIO_HINT_AFTERCHTYPE,
   //QIO_METHOD_LIBEVENT,
 } qio_method_t;
 #define QIO_METHODMASK 0x00f0
 #define QIO_HINT_AFTERMETHOD 0x0100
 #define QIO_METHOD_DEFAULT 0
 #define QIO_MIN_METHOD QIO_METHOD_READWRITE
-#define QIO_MAX_METHOD QIO_METHOD_MEMORY
+#define QIO_MAX_METHOD QIO_METHOD_URING
 
 enum {
   QIO_HINT_RANDOM       = QIO_HINT_AFTERMETHOD,
@@ -452,6 +455,9 @@ char* qio_hints_to_string(qio_hint_t hint)
       case QIO_METHOD_MEMORY:
         strcat(buf, " memory"); ok = 1;
         break;
+      case QIO_METHOD_URING:
+        strcat(buf, " uring"); ok = 1;
+        break;
       // no default to get warned if any are added.
     }
   }
@@ -815,6 +821,10 @@ typedef struct qio_channel_s {
 
   qbuffer_t buf;
 
+  // With QIO_METHOD_URING, the read-ahead and write-behind requests
+  // in flight. Reads are for the buffer space after av_end.
+  struct qio_uring_s* uring;
+
   // For reading/writing bits (ie less than a byte) at a time
   qio_bitbuffer_t bit_buffer;
   void* cached_end_bits; // cause flush before byte I/O
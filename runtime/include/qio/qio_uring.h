@@ -0,0 +1,103 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _QIO_URING_H_
+#define _QIO_URING_H_
+
+#include "sys_basic.h"
+#include "qbuffer.h"
+#include "qio_error.h"
+#include "sys.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Asynchronous reads and writes for QIO_METHOD_URING channels.
+ *
+ * Each channel using the method owns a qio_uring_t, created the first
+ * time it reads or writes. Requests are pread/pwrite of one contiguous
+ * piece of a qbytes_t, which stays retained until the request completes,
+ * so a channel can trim its buffer while a write is still in flight.
+ *
+ * Reads and writes are kept in two queues, each in submission order.
+ * A read-ahead channel waits on the oldest read to extend its
+ * available data; a write-behind channel only waits for writes when
+ * the ring is full or when it is flushed.
+ *
+ * Waiting yields to the tasking layer while the kernel works, and only
+ * blocks the thread in the kernel after several yields found nothing.
+ *
+ * On systems without io_uring (or where the kernel refuses it),
+ * qio_uring_available() returns false and choose_io_method uses
+ * QIO_METHOD_PREADPWRITE instead.
+ */
+
+typedef struct qio_uring_s qio_uring_t;
+
+// How many iobufs past the requested data a reading channel keeps in flight
+extern ssize_t qio_uring_readahead_iobufs;
+
+// Returns true if io_uring can be used on this system.
+int qio_uring_available(void);
+
+// Create a ring for requests to the file fd.
+qioerr qio_uring_create(qio_uring_t** ring_out, fd_t fd);
+
+// Waits for every request to complete, then frees the ring.
+// Returns the write error, if there was one.
+qioerr qio_uring_destroy(qio_uring_t* ring);
+
+// Returns true if another request can be queued without waiting.
+int qio_uring_can_submit(qio_uring_t* ring);
+
+// Queue a read of len bytes at file offset into ptr, which is within
+// bytes. Queued requests are given to the kernel by qio_uring_submit
+// or by the next wait. A write to a full ring first waits for the
+// oldest write; a read returns EAGAIN.
+qioerr qio_uring_queue_read(qio_uring_t* ring, qbytes_t* bytes, void* ptr,
+                            int64_t len, int64_t offset);
+qioerr qio_uring_queue_write(qio_uring_t* ring, qbytes_t* bytes, void* ptr,
+                             int64_t len, int64_t offset);
+
+qioerr qio_uring_submit(qio_uring_t* ring);
+
+// Number of reads queued or in flight, and the end offset of the last one
+int qio_uring_num_reads(qio_uring_t* ring);
+int64_t qio_uring_reads_end(qio_uring_t* ring);
+
+// Waits for the oldest read and removes it. Short reads are continued,
+// so *num_read is the full request unless the file ended (or an
+// error occurred). Returns QIO_EEOF if the file ended.
+qioerr qio_uring_wait_read(qio_uring_t* ring, int64_t* offset_out,
+                           ssize_t* num_read);
+
+// Waits for and discards every outstanding read.
+void qio_uring_cancel_reads(qio_uring_t* ring);
+
+// Removes completed writes, waiting for the oldest ones until no more
+// than max_pending remain. Returns the first error from any write
+// made with this ring, so that retrying a flush reports it again.
+qioerr qio_uring_finish_writes(qio_uring_t* ring, int max_pending);
+
+#ifdef __cplusplus
+} // end extern "C"
+#endif
+
+#endif
@@ -115,6 +115,9 @@ extern chpl_qthread_tls_t chpl_qthread_comm_task_tls;
 #define CHPL_TASK_STD_MODULES_INITIALIZED chpl_task_stdModulesInitialized
 void chpl_task_stdModulesInitialized(void);
 
+// Move the calling task to another shepherd, telling the remote cache.
+void chpl_qthread_migrate_to(qthread_shepherd_id_t shep);
+
 // Wrap qthread_get_tasklocal() and assert that it is always available.
 static inline chpl_qthread_tls_t* chpl_qthread_get_tasklocal(void)
 {
@@ -149,7 +152,6 @@ static inline chpl_task_prvData_t* chpl_task_getPrvData(void)
     if (data) {
         return &data->prvdata;
     }
-    assert(data);
     return NULL;
 }
 
@@ -216,7 +218,7 @@ void chpl_task_setSubloc(c_sublocid_t full_subloc)
 
         if (execution_subloc != c_sublocid_any &&
             (qthread_shepherd_id_t) execution_subloc != curr_shep) {
-            qthread_migrate_to((qthread_shepherd_id_t) execution_subloc);
+            chpl_qthread_migrate_to((qthread_shepherd_id_t) execution_subloc);
         }
     }
 }
@@ -244,32 +244,39 @@ the sequence number of the last acquire barrier. If a task performs a GET but
 finds a cache entry with a minimum sequence number before its last acquire
 barrier, it must invalidate that cache line and do a new GET.
 
-Lastly, since the implementation uses thread-local storage for the cache, it
-requires that tasks not move between threads. Tasks could move between threads
-if we had a way to notify the cache that they were about to do so (in which
-case the cache would issue a release barrier in the old thread and an acquire
-barrier in the new thread). Another alternative would be to mark tasks with
-ongoing operations in the cache as not movable to other threads. A third option
-would be to only move tasks between threads in situations that create full
-barriers anyway; notably a full barrier occurs on task start and sync variable
-use.
+Lastly, since the implementation uses thread-local storage for the cache, a
+task that moves between threads must tell the cache about it. The tasking layer
+calls chpl_cache_migrate_begin() before any point where a task might resume on
+another thread; that issues a release barrier on the old thread's cache. Points
+where the task can only resume on the same thread, like a yield under a
+scheduler with one worker per shepherd, skip it. After the task resumes it
+calls chpl_cache_migrate_end(), which issues an acquire barrier if the task is
+now on a different thread's cache, since the task's last acquire sequence
+number only means something to the cache that handed it out. A task that is in
+the middle of a cache operation (a comm wait inside the cache can yield) is not
+allowed to move; migrate_begin reports that to the tasking layer. Tasks also
+move between threads when blocking on a sync variable, but sync variable use
+already creates full barriers.
 
  */
 
 // ASSUMES THAT TASKS DO NOT MIGRATE BETWEEN PTHREADS
+// DURING A CACHE OPERATION
 // because:
 // 1) GASNet handles are only valid for a specific pthread
 // 2) want to avoid synchronization on the cache data structures
 //    but don't want to have 1 per task.
 //
-// If (1) is resolved, we could also weaken (2) by detecting
-// when task-local storage != thread-local storage.
+// Between cache operations, tasks may migrate as long as the tasking
+// layer brackets the move with chpl_cache_migrate_begin/end.
 //
 // See chapel-developers thread "migrating tasks" from 9/25/2013.
 // FIFO: never moves a task from one pthread to another
 // massivethreads: may move a task with sync/wait/yield/etc
-// Qthreads workaround: QT_NUM_WORKERS_PER_SHEPHERD=1
-//   (on 9/26/2013 Dylan mentioned perhaps adding 'pin to worker')
+//   (no migration hooks, so it does not support the cache)
+// Qthreads: may move a task on sublocale change, and with more than
+//   one worker per shepherd also on yield or sync wait; yields and
+//   sublocale changes call the migration hooks.
 
 #include "chplrt.h"
 #include "chpl-comm.h"
@@ -278,11 +285,17 @@ use.
 #include "chpl-atomics.h"
 #include "chpl-thread-local-storage.h" // CHPL_TLS_DECL etc
 #include "chpl-cache.h"
+#include "chpl-env.h"
 #include "chpl-linefile-support.h"
+#include "error.h"
 #include "sys.h" // sys_page_size()
 #include "chpl-comm-compiler-macros.h"
 #include "chpl-comm-no-warning-macros.h" // No warnings for chpl_comm_get etc.
+#include <ctype.h>
 #include <string.h> // memcpy, memset, etc.
+#include <stdio.h>
+#include <inttypes.h>
+#include <pthread.h>
 #include <assert.h>
 
 
@@ -292,12 +305,27 @@ use.
 //int CHPL_CACHE_REMOTE = 1;
 #define VERIFY 0
 
+// The cache geometry and readahead depth below were tuned for one
+// Infiniband network. They can be changed at program launch with
+// these environment variables (sizes accept k/m/g suffixes):
+//
+//   CHPL_RT_CACHE_PAGE_SIZE       cache page size in bytes
+//   CHPL_RT_CACHE_LINE_SIZE       cache line size in bytes
+//   CHPL_RT_CACHE_SIZE            bytes of cached data per pthread
+//   CHPL_RT_CACHE_READAHEAD_PAGES maximum readahead, in pages (0 = off)
+//
+// The values are read once, in chpl_cache_init(), and are constant
+// after that.
+
 // We try to auto-size the cache so that we
 // can have CACHE_PAGES_PER_NODE cache pages per locale, but we
-// do so within the below bounds.
+// do so within the below bounds, unless CHPL_RT_CACHE_SIZE is set.
 #define CACHE_PAGES_PER_NODE 4
 #define MIN_CACHE_DATA_SIZE (1024*1024)
 #define MAX_CACHE_DATA_SIZE (256*1024*1024)
+// CHPL_RT_CACHE_SIZE must leave room for at least this many pages.
+#define MIN_CACHE_PAGES 64
+static size_t cache_data_size = 0; // 0 means auto-size
 
 // How many pending operations can we have at once?
 #define MAX_PENDING 32
@@ -308,39 +336,58 @@ use.
 //
 // Reasonable values for CACHEPAGE_BITS are between 6 and 12
 // (64 bytes and 4k bytes. CACHEPAGE_BITS should not be larger than the
-// page size) and it must currently be even.
-// Here we set it to 1k bytes (ie 2^10).
-#define CACHEPAGE_BITS 10
+// page size).
+// By default we set it to 1k bytes (ie 2^10).
+#define DEFAULT_CACHEPAGE_BITS 10
+#define MIN_CACHEPAGE_BITS 6
+#define MAX_CACHEPAGE_BITS 12
+static int cachepage_bits = DEFAULT_CACHEPAGE_BITS;
+#define CACHEPAGE_BITS cachepage_bits
 #define CACHEPAGE_SIZE (1 << CACHEPAGE_BITS)
 #define CACHEPAGE_MASK (CACHEPAGE_SIZE-1)
+#define MAX_CACHEPAGE_SIZE (1 << MAX_CACHEPAGE_BITS)
 
 // CACHELINE_BITS 
 // Controls the cache line size - that is, the minimum number of bytes
 // that are fetched for any 'get' operation.
 //
 // Reasonable values for CACHELINE_BITS are between 6 and CACHEPAGE_BITS.
-// Here we set it to 64 bytes (ie 2^6)
-#define CACHELINE_BITS 6
+// By default we set it to 64 bytes (ie 2^6)
+#define DEFAULT_CACHELINE_BITS 6
+#define MIN_CACHELINE_BITS 6
+static int cacheline_bits = DEFAULT_CACHELINE_BITS;
+#define CACHELINE_BITS cacheline_bits
 #define CACHELINE_SIZE (1 << CACHELINE_BITS)
 #define CACHELINE_MASK (CACHELINE_SIZE-1)
 
 // What type can store the number of cache lines in a cache page?
 typedef int8_t line_per_page_t; 
-// What type for a number of lines to read ahead?
-typedef int16_t readahead_distance_t;
+// What type for a number of bytes to read ahead?
+typedef int32_t readahead_distance_t;
 
 // When prefetching, what is the maximum number of pages
 // we are willing to prefetch? This is also the maximum
 // readahead window size for sequential access.
-#define MAX_PAGES_PER_PREFETCH 2
+#define DEFAULT_MAX_PAGES_PER_PREFETCH 2
+#define MAX_MAX_PAGES_PER_PREFETCH 256
+static int max_pages_per_prefetch = DEFAULT_MAX_PAGES_PER_PREFETCH;
+#define MAX_PAGES_PER_PREFETCH max_pages_per_prefetch
 
 // Should we enable sequential readahead?
-// For sequential access If we're reading  
-#define ENABLE_READAHEAD 1
+static int enable_readahead = 1;
+#define ENABLE_READAHEAD enable_readahead
 #define ENABLE_READAHEAD_TRIGGER_WITHIN_PAGE 1
-#define ENABLE_READAHEAD_TRIGGER_SEQUENTIAL 0
 #define MAX_SEQUENTIAL_READAHEAD_BYTES (MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE)
 
+// Sequential readahead adapts to the access pattern. Each cache keeps
+// a readahead window between one page and MAX_SEQUENTIAL_READAHEAD_BYTES.
+// Reading a page that readahead brought in doubles the window; evicting
+// such a page unread, or a GET miss that does not continue the previous
+// miss, halves it. Once READAHEAD_STREAM_MISSES misses in a row have
+// each continued the one before, a miss next to the previous one
+// triggers readahead even without other valid lines in its page.
+#define READAHEAD_STREAM_MISSES 2
+
 //#define TIME
 //#define TRACE
 //#define DEBUG
@@ -432,8 +479,9 @@ struct rdcache_s;
 
 #define TOP_BITS 10
 #define BOTTOM_BITS 10
-#define OTHER_BITS ((64-TOP_BITS-BOTTOM_BITS-CACHEPAGE_BITS)/2)
-#define HALF_BITS (TOP_BITS+OTHER_BITS)
+// The bottom half gets the extra bit if 64-CACHEPAGE_BITS is odd.
+#define HALF_BITS ((64-CACHEPAGE_BITS+1)/2)
+#define OTHER_BITS (HALF_BITS-TOP_BITS)
 
 #define TOP_SIZE (1 << TOP_BITS)
 #define BOTTOM_SIZE (1 << BOTTOM_BITS)
@@ -442,6 +490,7 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHEPAGE_SIZE?
 // Divide # bytes in cache by 64, rounding up.
 #define CACHEPAGE_BITMASK_WORDS ((CACHEPAGE_SIZE+63)/64)
+#define MAX_CACHEPAGE_BITMASK_WORDS ((MAX_CACHEPAGE_SIZE+63)/64)
 
 // How many cache lines per cache page?
 #define CACHE_LINES_PER_PAGE (CACHEPAGE_SIZE/CACHELINE_SIZE)
@@ -449,6 +498,8 @@ struct rdcache_s;
 // How many uint64_t words do we need to create a bitmask for CACHE_LINES_PER_PAGE
 // ie, a mask recording a bit per cache line?
 #define CACHE_LINES_PER_PAGE_BITMASK_WORDS (((CACHEPAGE_SIZE/CACHELINE_SIZE)+63)/64)
+#define MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS \
+          (((MAX_CACHEPAGE_SIZE >> MIN_CACHELINE_BITS)+63)/64)
 
 struct cache_entry_base_s {
   uint32_t index_bits;
@@ -471,7 +522,7 @@ struct dirty_entry_s {
   // which cache entry are we talking about here?
   struct cache_entry_s* entry;
   // Which of the page's bytes are dirty?
-  uint64_t dirty[CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
+  uint64_t dirty[MAX_CACHEPAGE_BITMASK_WORDS]; // ie we need to create a put for these bytes
 };
 
 #define QUEUE_FREE 0
@@ -501,6 +552,9 @@ struct cache_entry_s {
   // Readahead information.
   readahead_distance_t readahead_skip;
   readahead_distance_t readahead_len; // == 0 if this page doesn't trigger readahead.
+  // Did a prefetch or readahead bring this page in, and has nobody
+  // read it yet?
+  int8_t prefetch_unused;
   // These are the queue links. Am is LRU but Ain and Aout are FIFO
   struct cache_entry_s* next; // next entry in Ain/Aout/Am
   struct cache_entry_s* prev; // previous entry in An/Aout/Am
@@ -508,7 +562,7 @@ struct cache_entry_s {
   // This refers to CACHEPAGE_SIZE bytes of memory.
   unsigned char* page;
   // Which of the cache lines have we done 'get's for?
-  uint64_t valid_lines[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t valid_lines[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   // dirty info if this cache page is dirty, NULL otherwise.
   struct dirty_entry_s* dirty;
   // What is the minimum sequence number stored in this cache entry?
@@ -547,7 +601,7 @@ static int set_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 // Note skip/len are in line numbers, NOT byte offsets!
 static void unset_valid_lines(uint64_t* valid, uintptr_t skip, uintptr_t len)
 {
-  uint64_t myvalid[CACHE_LINES_PER_PAGE_BITMASK_WORDS];
+  uint64_t myvalid[MAX_CACHE_LINES_PER_PAGE_BITMASK_WORDS];
   unset_valids_for_skip_len(valid, myvalid, skip, len, CACHE_LINES_PER_PAGE_BITMASK_WORDS);  
 }
 /*
@@ -584,6 +638,28 @@ struct rdcache_s {
   c_nodeid_t last_cache_miss_read_node;
   raddr_t last_cache_miss_read_addr;
 
+  // Adaptive readahead: the current limit on sequential readahead,
+  // in bytes, and how many GET misses in a row continued a stream.
+  int readahead_window;
+  int sequential_misses;
+
+  // Counters reported through chpl_getCacheDiagnosticsHere. Each is
+  // only updated by the pthread that owns the cache:
+  //  get_hits -- GET pages satisfied from the cache
+  //  get_partial_hits -- GET pages with only some of the needed lines
+  //  get_misses -- GET pages with none of the needed lines
+  //  prefetches -- pages fetched by readahead or chpl_cache_comm_prefetch
+  //  prefetch_hits -- GET hits on a prefetched page not yet read
+  //  prefetch_unused -- prefetched pages evicted before being read
+  //  dirty_flushes -- PUTs started to write back dirty data
+  //  promotions -- pages found in Aout and promoted to Am
+  //  evictions -- pages evicted from Ain or Am
+  //  acquire_invalidations -- pages discarded due to an acquire fence
+  chpl_cacheDiagnostics stats;
+
+  // Link in the list of all caches on this locale.
+  struct rdcache_s* next_cache;
+
   // The variable names Ain Aout and Am come from the 2Q paper
 
   // Ain is a FIFO queue storing entries initially as they go into
@@ -671,6 +747,38 @@ struct rdcache_s {
 
 static void validate_cache(struct rdcache_s* tree);
 
+static inline
+void readahead_grow(struct rdcache_s* cache)
+{
+  cache->readahead_window *= 2;
+  if( cache->readahead_window > MAX_SEQUENTIAL_READAHEAD_BYTES )
+    cache->readahead_window = MAX_SEQUENTIAL_READAHEAD_BYTES;
+}
+
+static inline
+void readahead_shrink(struct rdcache_s* cache)
+{
+  cache->readahead_window /= 2;
+  if( cache->readahead_window < CACHEPAGE_SIZE )
+    cache->readahead_window = CACHEPAGE_SIZE;
+}
+
+// Called for each GET miss (before recording it as the last miss) to
+// decide whether we are streaming through memory.
+static inline
+void readahead_note_miss(struct rdcache_s* cache,
+                         c_nodeid_t node, raddr_t raddr)
+{
+  if( cache->last_cache_miss_read_node == node &&
+      raddr <= cache->last_cache_miss_read_addr + CACHEPAGE_SIZE &&
+      raddr + CACHEPAGE_SIZE >= cache->last_cache_miss_read_addr ) {
+    cache->sequential_misses++;
+  } else {
+    cache->sequential_misses = 0;
+    readahead_shrink(cache);
+  }
+}
+
 
 static
 struct rdcache_s* cache_create(void) {
@@ -693,11 +801,15 @@ struct rdcache_s* cache_create(void) {
   unsigned char* buffer;
   unsigned char* pages;
 
-  cache_pages = CACHE_PAGES_PER_NODE * chpl_numNodes;
-  if( cache_pages < MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
-    cache_pages = MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
-  if( cache_pages > MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
-    cache_pages = MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+  if( cache_data_size ) {
+    cache_pages = cache_data_size / CACHEPAGE_SIZE;
+  } else {
+    cache_pages = CACHE_PAGES_PER_NODE * chpl_numNodes;
+    if( cache_pages < MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
+      cache_pages = MIN_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+    if( cache_pages > MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE )
+      cache_pages = MAX_CACHE_DATA_SIZE/CACHEPAGE_SIZE;
+  }
 
   ain_pages = cache_pages / 4; // 2Q: "Kin should be 25% of page slots"
   aout_pages = cache_pages / 2; // 2Q: "Kout should hold identifiers for as
@@ -766,6 +878,14 @@ struct rdcache_s* cache_create(void) {
   c->last_cache_miss_read_node = -1;
   c->last_cache_miss_read_addr = 0;
 
+  c->readahead_window = DEFAULT_MAX_PAGES_PER_PREFETCH*CACHEPAGE_SIZE;
+  if( c->readahead_window > MAX_SEQUENTIAL_READAHEAD_BYTES )
+    c->readahead_window = MAX_SEQUENTIAL_READAHEAD_BYTES;
+  c->sequential_misses = 0;
+
+  memset(&c->stats, 0, sizeof(c->stats));
+  c->next_cache = NULL;
+
   c->max_pages = cache_pages;
   c->max_entries = n_entries;
   c->max_top_nodes = top_entries;
@@ -1741,6 +1861,7 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
 
           // Save the handle in the list of pending requests.
           entry->max_put_sequence_number = pending_push(cache, handle);
+          cache->stats.dirty_flushes++;
 
           // Move past this region of 1s in dirty bits.
           start = got_skip + got_len;
@@ -1776,6 +1897,7 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
     if( len == CACHEPAGE_SIZE ) {
       entry->readahead_skip = 0;
       entry->readahead_len = 0;
+      entry->prefetch_unused = 0;
       entry->min_sequence_number = NO_SEQUENCE_NUMBER;
       entry->max_put_sequence_number = NO_SEQUENCE_NUMBER;
       entry->max_prefetch_sequence_number = NO_SEQUENCE_NUMBER;
@@ -1787,6 +1909,15 @@ void flush_entry(struct rdcache_s* cache, struct cache_entry_s* entry, int op,
 
   // If evicting, remove the page from the cache and put it on a free list.
   if( op & FLUSH_DO_EVICT ) {
+    // Nobody read what was prefetched into this page, so read
+    // ahead less aggressively.
+    if( entry->prefetch_unused ) {
+      entry->prefetch_unused = 0;
+      cache->stats.prefetch_unused++;
+      readahead_shrink(cache);
+    }
+    cache->stats.evictions++;
+
     // But, our entry no longer can have a page associated with it.
     page = entry->page;
     entry->page = NULL;
@@ -1874,10 +2005,12 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     tree->aout_current--;
     DOUBLE_PUSH_HEAD(tree, bottom_match, am_lru);
     tree->am_current++;
+    tree->stats.promotions++;
 
     bottom_match->queue = QUEUE_AM;
     bottom_match->readahead_skip = 0;
     bottom_match->readahead_len = 0;
+    bottom_match->prefetch_unused = 0;
     // Set the page to the one the caller already allocated
     bottom_match->page = page;
     // Clear the valid lines
@@ -1904,6 +2037,7 @@ struct cache_entry_s* make_entry(struct rdcache_s* tree,
     bottom_tmp->queue = QUEUE_AIN;
     bottom_tmp->readahead_skip = 0;
     bottom_tmp->readahead_len = 0;
+    bottom_tmp->prefetch_unused = 0;
 
     bottom_tmp->next = NULL;
     bottom_tmp->prev = NULL;
@@ -1987,6 +2121,7 @@ void cache_put(struct rdcache_s* cache,
       // Is this cache line available for use, based on when we
       // last ran an acquire fence?
       entry_after_acquire = ( entry->min_sequence_number >= last_acquire );
+      if( ! entry_after_acquire ) cache->stats.acquire_invalidations++;
    
       // If the cache line contains any overlapping writes or prefetches,
       // we must wait for them to complete before we store new data.
@@ -2122,8 +2257,8 @@ void cache_get_trigger_readahead(struct rdcache_s* cache,
   if( ENABLE_READAHEAD && skip && ! is_congested(cache) ) {
     next_ra_length = 2 * len;
 
-    if( next_ra_length > MAX_SEQUENTIAL_READAHEAD_BYTES )
-      next_ra_length = MAX_SEQUENTIAL_READAHEAD_BYTES;
+    if( next_ra_length > cache->readahead_window )
+      next_ra_length = cache->readahead_window;
 
     if( skip < 0 )
       next_ra_length = - next_ra_length;
@@ -2244,6 +2379,7 @@ void cache_get(struct rdcache_s* cache,
   raddr_t ra_line;
   raddr_t ra_line_end;
   int has_data;
+  int has_some_data; // for counting partial hits
   unsigned char* page;
   cache_seqn_t sn = NO_SEQUENCE_NUMBER;
   int isprefetch = (addr == NULL);
@@ -2305,14 +2441,20 @@ void cache_get(struct rdcache_s* cache,
       // Is this cache line available for use, based on when we
       // last ran an acquire fence?
       entry_after_acquire = ( entry->min_sequence_number >= last_acquire );
+      if( ! entry_after_acquire ) cache->stats.acquire_invalidations++;
      
       // Is the relevant data available in the cache line?
       has_data = check_valid_lines(entry->valid_lines,
                                    (ra_line - ra_page) >> CACHELINE_BITS,
                                    (ra_line_end - ra_line) >> CACHELINE_BITS);
+      has_some_data = entry_after_acquire &&
+                      any_valid_lines(entry->valid_lines,
+                                      (ra_line - ra_page) >> CACHELINE_BITS,
+                                      (ra_line_end - ra_line) >> CACHELINE_BITS);
     } else {
       entry_after_acquire = 1;
       has_data = 0;
+      has_some_data = 0;
     }
 
     //printf("%i entry is %p after_acquire %i has_data %i\n", chpl_nodeID, entry, entry_after_acquire, has_data);
@@ -2339,7 +2481,8 @@ void cache_get(struct rdcache_s* cache,
         }
       }
      
-      if( ENABLE_READAHEAD_TRIGGER_SEQUENTIAL && ra == 0 &&
+      if( ra == 0 &&
+          cache->sequential_misses >= READAHEAD_STREAM_MISSES &&
           cache->last_cache_miss_read_node == node ) {
         if(cache->last_cache_miss_read_addr < ra_line &&
            ra_line <= cache->last_cache_miss_read_addr + CACHEPAGE_SIZE) {
@@ -2404,6 +2547,13 @@ void cache_get(struct rdcache_s* cache,
         // If the cache line is in Am, move it to the front of Am.
         use_entry(cache, entry);
         if( ! isprefetch ) {
+          cache->stats.get_hits++;
+          if( entry->prefetch_unused ) {
+            // Prefetching paid off, so read further ahead next time.
+            entry->prefetch_unused = 0;
+            cache->stats.prefetch_hits++;
+            readahead_grow(cache);
+          }
       
           //printf("cache hit on page %i:%p %p ra_len %i\n", 
           //       node, (void*) ra_page, (void*) requested_start,
@@ -2455,6 +2605,14 @@ void cache_get(struct rdcache_s* cache,
 
     // Otherwise -- start a get !
 
+    if( isprefetch ) {
+      cache->stats.prefetches++;
+    } else if( has_some_data ) {
+      cache->stats.get_partial_hits++;
+    } else {
+      cache->stats.get_misses++;
+    }
+
     if( ! page ) {
       // get a page from the free list.
       page = allocate_page(cache);
@@ -2487,6 +2645,8 @@ void cache_get(struct rdcache_s* cache,
       use_entry(cache, entry);
     } else {
       entry = make_entry(cache, node, ra_page, page);
+      // Note pages that only a prefetch asked for.
+      if( isprefetch ) entry->prefetch_unused = 1;
     }
 
     // Set the valid lines
@@ -2540,6 +2700,7 @@ void cache_get(struct rdcache_s* cache,
     // Update the last read location on a miss
     // (as long as there was not an intervening acquire)
     if( entry_after_acquire && sequential_readahead_length == 0 ) {
+      if( ! isprefetch ) readahead_note_miss(cache, node, ra_line);
       cache->last_cache_miss_read_node = node;
       cache->last_cache_miss_read_addr = ra_line;
     }
@@ -2673,6 +2834,16 @@ static struct rdcache_s* cache_create(void);
 CHPL_TLS_DECL(struct rdcache_s*,cache_remote_data);
 static pthread_key_t pthread_cache_info_key; // stores struct rdcache_s*
 
+// We also keep a list of all of the caches on this locale so that
+// we can report statistics. The counters of caches whose pthreads
+// have exited are folded into retired_cache_stats. Since the counters
+// are only written by their own pthreads, resetting them just records
+// the current totals in reset_cache_stats, to be subtracted later.
+static pthread_mutex_t all_caches_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct rdcache_s* all_caches_head = NULL;
+static chpl_cacheDiagnostics retired_cache_stats;
+static chpl_cacheDiagnostics reset_cache_stats;
+
 static
 struct rdcache_s* tls_cache_remote_data(void) {
   struct rdcache_s *cache = CHPL_TLS_GET(cache_remote_data);
@@ -2680,10 +2851,58 @@ struct rdcache_s* tls_cache_remote_data(void) {
     cache = cache_create();
     CHPL_TLS_SET(cache_remote_data, cache);
     pthread_setspecific(pthread_cache_info_key, cache);
+
+    pthread_mutex_lock(&all_caches_lock);
+    cache->next_cache = all_caches_head;
+    all_caches_head = cache;
+    pthread_mutex_unlock(&all_caches_lock);
   }
   return cache;
 }
 
+static
+void cache_stats_add(chpl_cacheDiagnostics* sum, chpl_cacheDiagnostics* s)
+{
+  sum->get_hits += s->get_hits;
+  sum->get_partial_hits += s->get_partial_hits;
+  sum->get_misses += s->get_misses;
+  sum->prefetches += s->prefetches;
+  sum->prefetch_hits += s->prefetch_hits;
+  sum->prefetch_unused += s->prefetch_unused;
+  sum->dirty_flushes += s->dirty_flushes;
+  sum->promotions += s->promotions;
+  sum->evictions += s->evictions;
+  sum->acquire_invalidations += s->acquire_invalidations;
+}
+
+static
+void cache_stats_sub(chpl_cacheDiagnostics* sum, chpl_cacheDiagnostics* s)
+{
+  sum->get_hits -= s->get_hits;
+  sum->get_partial_hits -= s->get_partial_hits;
+  sum->get_misses -= s->get_misses;
+  sum->prefetches -= s->prefetches;
+  sum->prefetch_hits -= s->prefetch_hits;
+  sum->prefetch_unused -= s->prefetch_unused;
+  sum->dirty_flushes -= s->dirty_flushes;
+  sum->promotions -= s->promotions;
+  sum->evictions -= s->evictions;
+  sum->acquire_invalidations -= s->acquire_invalidations;
+}
+
+// Sum the counters of all caches on this locale, current and retired.
+// Call with all_caches_lock held.
+static
+void cache_stats_total(chpl_cacheDiagnostics* total)
+{
+  struct rdcache_s* cache;
+
+  *total = retired_cache_stats;
+  for( cache = all_caches_head; cache; cache = cache->next_cache ) {
+    cache_stats_add(total, &cache->stats);
+  }
+}
+
 static
 chpl_cache_taskPrvData_t* task_private_cache_data(void)
 {
@@ -2695,18 +2914,130 @@ static
 void destroy_pthread_local_cache(void* arg)
 {
   struct rdcache_s* s = (struct rdcache_s*) arg;
+  struct rdcache_s** cur;
+
+  pthread_mutex_lock(&all_caches_lock);
+  for( cur = &all_caches_head; *cur; cur = &(*cur)->next_cache ) {
+    if( *cur == s ) {
+      *cur = s->next_cache;
+      break;
+    }
+  }
+  cache_stats_add(&retired_cache_stats, &s->stats);
+  pthread_mutex_unlock(&all_caches_lock);
+
   cache_destroy(s);
 }
 
+// Parse a CHPL_RT_CACHE_* size setting, which may have a k, m, or g
+// suffix. Returns dflt if the variable is unset or can't be parsed.
+static
+size_t cache_env_size(const char* ev, size_t dflt)
+{
+  const char* p;
+  size_t size;
+  char units;
+  int scan_cnt;
+  char msg[200];
+
+  if( (p = chpl_get_rt_env(ev, NULL)) == NULL ) return dflt;
+
+  // %zu would quietly turn a negative number into a huge one
+  while( isspace((unsigned char) *p) ) p++;
+  if( *p == '-' )
+    scan_cnt = 0;
+  else
+    scan_cnt = sscanf(p, "%zu%c", &size, &units);
+
+  if( scan_cnt != 1 ) {
+    if( scan_cnt == 2 && strchr("kKmMgG", units) != NULL ) {
+      switch (units) {
+      case 'k' : case 'K': size <<= 10; break;
+      case 'm' : case 'M': size <<= 20; break;
+      case 'g' : case 'G': size <<= 30; break;
+      }
+    } else {
+      snprintf(msg, sizeof(msg), "Cannot parse CHPL_RT_%s", ev);
+      chpl_warning(msg, 0, 0);
+      size = dflt;
+    }
+  }
+
+  return size;
+}
+
+// Parse a CHPL_RT_CACHE_* power-of-2 size setting and return its log2,
+// or dflt_bits if it is unset or not a power of 2 between the bounds.
+static
+int cache_env_bits(const char* ev, int dflt_bits, int min_bits, int max_bits)
+{
+  size_t size = cache_env_size(ev, (size_t) 1 << dflt_bits);
+  int bits;
+  char msg[200];
+
+  for( bits = min_bits; bits <= max_bits; bits++ ) {
+    if( size == (size_t) 1 << bits ) return bits;
+  }
+
+  snprintf(msg, sizeof(msg),
+           "CHPL_RT_%s must be a power of 2 between %zu and %zu; using %zu",
+           ev, (size_t) 1 << min_bits, (size_t) 1 << max_bits,
+           (size_t) 1 << dflt_bits);
+  chpl_warning(msg, 0, 0);
+  return dflt_bits;
+}
+
+static
+void cache_read_env(void)
+{
+  size_t n;
+  char msg[200];
+
+  cachepage_bits = cache_env_bits("CACHE_PAGE_SIZE", DEFAULT_CACHEPAGE_BITS,
+                                  MIN_CACHEPAGE_BITS, MAX_CACHEPAGE_BITS);
+  cacheline_bits = cache_env_bits("CACHE_LINE_SIZE",
+                                  (DEFAULT_CACHELINE_BITS < cachepage_bits) ?
+                                  DEFAULT_CACHELINE_BITS : cachepage_bits,
+                                  MIN_CACHELINE_BITS, cachepage_bits);
+
+  cache_data_size = cache_env_size("CACHE_SIZE", 0);
+  if( cache_data_size != 0 &&
+      cache_data_size < (size_t) MIN_CACHE_PAGES * CACHEPAGE_SIZE ) {
+    snprintf(msg, sizeof(msg),
+             "CHPL_RT_CACHE_SIZE must be at least %zu with %d-byte pages; "
+             "using %zu",
+             (size_t) MIN_CACHE_PAGES * CACHEPAGE_SIZE, CACHEPAGE_SIZE,
+             (size_t) MIN_CACHE_PAGES * CACHEPAGE_SIZE);
+    chpl_warning(msg, 0, 0);
+    cache_data_size = (size_t) MIN_CACHE_PAGES * CACHEPAGE_SIZE;
+  }
+
+  n = cache_env_size("CACHE_READAHEAD_PAGES", DEFAULT_MAX_PAGES_PER_PREFETCH);
+  if( n > MAX_MAX_PAGES_PER_PREFETCH ) {
+    snprintf(msg, sizeof(msg),
+             "CHPL_RT_CACHE_READAHEAD_PAGES must be <= %d; using %d",
+             MAX_MAX_PAGES_PER_PREFETCH, MAX_MAX_PAGES_PER_PREFETCH);
+    chpl_warning(msg, 0, 0);
+    n = MAX_MAX_PAGES_PER_PREFETCH;
+  }
+  // Explicit prefetches still need to fetch at least one page.
+  enable_readahead = (n > 0);
+  max_pages_per_prefetch = (n > 0) ? (int) n : 1;
+}
+
 static
 void chpl_cache_do_init(void)
 {
   static int inited = 0;
   if( ! inited ) {
   
+    cache_read_env();
+
     // Quick configuration check...
-    assert(OTHER_BITS+TOP_BITS+OTHER_BITS+BOTTOM_BITS+CACHEPAGE_BITS == 64);
-    assert(HALF_BITS + HALF_BITS + CACHEPAGE_BITS == 64);
+    assert(OTHER_BITS+TOP_BITS+OTHER_BITS+BOTTOM_BITS+CACHEPAGE_BITS >= 64);
+    assert(HALF_BITS + HALF_BITS + CACHEPAGE_BITS <= 65);
+    assert(HALF_BITS <= 32); // index_bits is a uint32_t
+    assert(CACHELINE_BITS <= CACHEPAGE_BITS);
 
     // Otherwise, we will need some thread-local storage.
     // We create two versions: cache_remote_data stores
@@ -2770,8 +3101,11 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
     chpl_cache_print();
 #endif
 
+    task_local->in_cache_op++;
+
     if( acquire ) {
       task_local->last_acquire = cache->next_request_number;
+      task_local->cache = cache;
       cache->next_request_number++;
     }
 
@@ -2779,6 +3113,8 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
       cache_clean_dirty(cache);
       wait_all(cache);
     }
+
+    task_local->in_cache_op--;
 #ifdef DUMP
     DEBUG_PRINT(("%d: task %d after fence\n", chpl_nodeID, (int) chpl_task_getId()));
     chpl_cache_print();
@@ -2787,6 +3123,46 @@ void chpl_cache_fence(int acquire, int release, int ln, int32_t fn)
   // Do nothing if cache is not enabled.
 }
 
+int chpl_cache_migrate_begin(void)
+{
+  struct rdcache_s* cache;
+  chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
+
+  // Comm waits inside the cache can yield. The cache state for the
+  // operation in progress lives on this pthread, so don't move.
+  if( task_local->in_cache_op ) return 0;
+
+  cache = tls_cache_remote_data();
+  TRACE_PRINT(("%d: task %d in chpl_cache_migrate_begin on cache %p\n",
+               chpl_nodeID, (int) chpl_task_getId(), cache));
+
+  // Complete our PUTs while we are still on the pthread that owns
+  // their handles.
+  task_local->in_cache_op++;
+  cache_clean_dirty(cache);
+  wait_all(cache);
+  task_local->in_cache_op--;
+
+  return 1;
+}
+
+void chpl_cache_migrate_end(void)
+{
+  struct rdcache_s* cache = tls_cache_remote_data();
+  chpl_cache_taskPrvData_t* task_local = task_private_cache_data();
+
+  // If we moved, last_acquire is a sequence number from another
+  // pthread's cache, so start over with an acquire on this one.
+  if( task_local->cache != cache ) {
+    TRACE_PRINT(("%d: task %d migrated from cache %p to cache %p\n",
+                 chpl_nodeID, (int) chpl_task_getId(),
+                 task_local->cache, cache));
+    task_local->last_acquire = cache->next_request_number;
+    task_local->cache = cache;
+    cache->next_request_number++;
+  }
+}
+
 void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
                          size_t size, int32_t typeIndex,
                          int32_t commID, int ln, int32_t fn)
@@ -2808,8 +3184,10 @@ void chpl_cache_comm_put(void* addr, c_nodeid_t node, void* raddr,
 
   //saturating_increment(&info->put_since_release);
   //task_local->last_op = seqn_max(cache, addr, node, raddr, size);
+  task_local->in_cache_op++;
   cache_put(cache, addr, node, (raddr_t)raddr, size, task_local->last_acquire,
             commID, ln, fn);
+  task_local->in_cache_op--;
   return;
 }
 
@@ -2833,8 +3211,10 @@ void chpl_cache_comm_get(void *addr, c_nodeid_t node, void* raddr,
 #endif
 
   //saturating_increment(&info->get_since_acquire);
+  task_local->in_cache_op++;
   cache_get(cache, addr, node, (raddr_t)raddr, size, task_local->last_acquire,
             0, commID, ln, fn);
+  task_local->in_cache_op--;
 
   return;
 }
@@ -2851,8 +3231,10 @@ void chpl_cache_comm_prefetch(c_nodeid_t node, void* raddr,
            chpl_lookupFilename(fn), ln, node);
   // Always use the cache for prefetches.
   //saturating_increment(&info->prefetch_since_acquire);
+  task_local->in_cache_op++;
   cache_get(cache, NULL, node, (raddr_t)raddr, size, task_local->last_acquire,
             0, CHPL_COMM_UNKNOWN_ID, ln, fn);
+  task_local->in_cache_op--;
 }
 void chpl_cache_comm_get_strd(void *addr, void *dststr, c_nodeid_t node,
                               void *raddr, void *srcstr, void *count,
@@ -2910,6 +3292,23 @@ void chpl_cache_print(void)
   rdcache_print(cache);
 }
 
+void chpl_resetCacheDiagnosticsHere(void)
+{
+  pthread_mutex_lock(&all_caches_lock);
+  cache_stats_total(&reset_cache_stats);
+  pthread_mutex_unlock(&all_caches_lock);
+}
+
+void chpl_getCacheDiagnosticsHere(chpl_cacheDiagnostics *cd)
+{
+  // Other pthreads may be updating their counters while we read them,
+  // so the result is only approximate while the cache is in use.
+  pthread_mutex_lock(&all_caches_lock);
+  cache_stats_total(cd);
+  cache_stats_sub(cd, &reset_cache_stats);
+  pthread_mutex_unlock(&all_caches_lock);
+}
+
 // This is for debugging.
 void chpl_cache_assert_released(void)
 {
@@ -2941,6 +3340,15 @@ void chpl_cache_set_enabled(int enabled)
 }
 */
 
+#else
+// ifdef HAS_CHPL_CACHE_FNS
+
+// Without a cache, there is nothing to count.
+void chpl_resetCacheDiagnosticsHere(void) { }
+void chpl_getCacheDiagnosticsHere(chpl_cacheDiagnostics *cd) {
+  memset(cd, 0, sizeof(chpl_cacheDiagnostics));
+}
+
 #endif
 // end ifdef HAS_CHPL_CACHE_FNS
 
@@ -113,3 +113,135 @@ size_t chpl_comm_getenvMaxHeapSize(void)
 
   return size;
 }
+
+
+//
+// Strided copy between two addresses on this node.
+//
+// Dimensions whose count is 1 are dropped, and a dimension is folded
+// into the one inside it when its strides just step over that inner
+// dimension in both source and destination, so that what's left is as
+// few and as long runs as possible.  The innermost remaining dimension
+// is then walked by a loop that copies runs of 1, 2, 4, 8 or 16 bytes
+// with fixed-size copies the compiler can turn into single loads and
+// stores, rather than calling memmove() for every element.  The outer
+// dimensions are walked with an odometer, so there's no limit on the
+// number of stride levels and no per-run bookkeeping to allocate.
+//
+
+typedef struct {
+  size_t cnt;
+  size_t dststr;                        // bytes
+  size_t srcstr;                        // bytes
+} strd_dim_t;
+
+
+#define STRD_COPY_RUNS(runSize)                                         \
+  do {                                                                  \
+    for (; n >= 4; n -= 4) {                                            \
+      memcpy(dst, src, runSize);                                        \
+      memcpy(dst + dststr, src + srcstr, runSize);                      \
+      memcpy(dst + 2 * dststr, src + 2 * srcstr, runSize);              \
+      memcpy(dst + 3 * dststr, src + 3 * srcstr, runSize);              \
+      dst += 4 * dststr;                                                \
+      src += 4 * srcstr;                                                \
+    }                                                                   \
+    for (; n > 0; n--) {                                                \
+      memcpy(dst, src, runSize);                                        \
+      dst += dststr;                                                    \
+      src += srcstr;                                                    \
+    }                                                                   \
+  } while (0)
+
+static
+void strd_copy_runs(char* dst, size_t dststr, const char* src, size_t srcstr,
+                    size_t n, size_t run) {
+  switch (run) {
+  case 1:  STRD_COPY_RUNS(1);  break;
+  case 2:  STRD_COPY_RUNS(2);  break;
+  case 4:  STRD_COPY_RUNS(4);  break;
+  case 8:  STRD_COPY_RUNS(8);  break;
+  case 16: STRD_COPY_RUNS(16); break;
+  default:
+    for (; n > 0; n--) {
+      memmove(dst, src, run);
+      dst += dststr;
+      src += srcstr;
+    }
+    break;
+  }
+}
+
+#undef STRD_COPY_RUNS
+
+
+void chpl_comm_strd_local_copy(void* dstaddr, size_t* dststrides,
+                               void* srcaddr, size_t* srcstrides,
+                               size_t* count, int32_t stridelevels,
+                               size_t elemSize) {
+  const size_t strlvls = (size_t)stridelevels;
+  strd_dim_t dims[strlvls + 1];
+  size_t idx[strlvls + 1];
+  size_t ndims = 0;
+  size_t run = count[0] * elemSize;
+  char* dst = (char*)dstaddr;
+  const char* src = (const char*)srcaddr;
+  size_t i;
+
+  for (i = 1; i <= strlvls; i++) {
+    const size_t cnt = count[i];
+    const size_t dststr = dststrides[i - 1] * elemSize;
+    const size_t srcstr = srcstrides[i - 1] * elemSize;
+
+    if (cnt == 0)
+      return;
+    if (cnt == 1)
+      continue;
+
+    if (ndims == 0) {
+      if (dststr == run && srcstr == run) {
+        run *= cnt;
+        continue;
+      }
+    } else {
+      strd_dim_t* inner = &dims[ndims - 1];
+      if (dststr == inner->dststr * inner->cnt
+          && srcstr == inner->srcstr * inner->cnt) {
+        inner->cnt *= cnt;
+        continue;
+      }
+    }
+
+    dims[ndims].cnt = cnt;
+    dims[ndims].dststr = dststr;
+    dims[ndims].srcstr = srcstr;
+    idx[ndims] = 0;
+    ndims++;
+  }
+
+  if (run == 0)
+    return;
+
+  if (ndims == 0) {
+    memmove(dst, src, run);
+    return;
+  }
+
+  while (1) {
+    strd_copy_runs(dst, dims[0].dststr, src, dims[0].srcstr, dims[0].cnt, run);
+
+    for (i = 1; i < ndims; i++) {
+      if (++idx[i] < dims[i].cnt) {
+        dst += dims[i].dststr;
+        src += dims[i].srcstr;
+        break;
+      }
+      idx[i] = 0;
+      dst -= dims[i].dststr * (dims[i].cnt - 1);
+      src -= dims[i].srcstr * (dims[i].cnt - 1);
+    }
+
+    if (i == ndims)
+      break;
+  }
+}
@@ -32,6 +32,7 @@
 #include "chpl-privatization.h"
 #include "chpl-tasks.h"
 #include "chpl-topo.h"
+#include "chpl-trace.h"
 #include "chpl-linefile-support.h"
 #include "chplsys.h"
 #include "config.h"
@@ -193,6 +194,9 @@ void chpl_rt_init(int argc, char* argv[]) {
   chpl_comm_post_task_init();
   chpl_comm_rollcall();
 
+  // Start tracing, if requested, now that the comm layer is up.
+  chpl_trace_init();
+
   //
   // Make sure the runtime is fully set up on all locales before we start
   // running Chapel code.
@@ -0,0 +1,217 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Per-task arenas, see chpl-mem-arena.h.
+//
+#include "chplrt.h"
+
+#include "chpl-mem-arena.h"
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-tasks.h"
+#include "error.h"
+
+#include <pthread.h>
+#include <stdint.h>
+#include <sys/mman.h>
+
+
+uintptr_t chpl_mem_arena_base = 0;
+size_t chpl_mem_arena_size = 0;
+volatile int chpl_mem_arena_numActive = 0;
+
+//
+// A chunk's reference count starts out biased by a large constant so
+// that frees can't take it to zero while its task is still allocating
+// from it.  When the task moves on, it adds the number of objects it
+// allocated and takes away the bias, and from then on the count is the
+// number of live objects.  Whoever takes it to zero releases the chunk.
+//
+#define CHUNK_REFS_BIAS ((int64_t) 1 << 62)
+
+typedef struct chpl_mem_arenaChunk_s {
+  atomic_int_least64_t refs;
+  struct chpl_mem_arenaChunk_s* nextFree;
+} arenaChunk;
+
+// The first object in a chunk starts after the chunk header, leaving
+// room for the object's own header, so objects are 16-byte aligned.
+#define CHUNK_FIRST_OBJ 64
+
+static pthread_mutex_t arenaLock = PTHREAD_MUTEX_INITIALIZER;
+static char* regionNext = NULL;             // protected by arenaLock
+static arenaChunk* freeChunks = NULL;       // protected by arenaLock
+static chpl_bool arenaDisabled = false;     // protected by arenaLock
+
+
+//
+// Reserve the address range for the chunks.  Nothing is committed until
+// a chunk is touched, so we ask for a lot and settle for less if the
+// system won't give it to us.
+//
+static chpl_bool reserveRegion(void) {
+  size_t size;
+
+  for (size = (size_t) 1 << 36;
+       size >= ((size_t) 1 << 26);
+       size >>= 1) {
+    void* p = mmap(NULL, size + CHPL_MEM_ARENA_CHUNK_SIZE,
+                   PROT_READ | PROT_WRITE,
+                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (p != MAP_FAILED) {
+      uintptr_t base = ((uintptr_t) p + CHPL_MEM_ARENA_CHUNK_SIZE - 1)
+                       & ~(uintptr_t) (CHPL_MEM_ARENA_CHUNK_SIZE - 1);
+      regionNext = (char*) base;
+      chpl_mem_arena_base = base;
+      chpl_mem_arena_size = size;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+
+static arenaChunk* getChunk(void) {
+  arenaChunk* chunk = NULL;
+
+  pthread_mutex_lock(&arenaLock);
+  if (freeChunks != NULL) {
+    chunk = freeChunks;
+    freeChunks = chunk->nextFree;
+  } else if (regionNext + CHPL_MEM_ARENA_CHUNK_SIZE
+             <= (char*) chpl_mem_arena_base + chpl_mem_arena_size) {
+    chunk = (arenaChunk*) regionNext;
+    regionNext += CHPL_MEM_ARENA_CHUNK_SIZE;
+  }
+  pthread_mutex_unlock(&arenaLock);
+
+  if (chunk != NULL)
+    atomic_init_int_least64_t(&chunk->refs, CHUNK_REFS_BIAS);
+  return chunk;
+}
+
+
+static void putChunk(arenaChunk* chunk) {
+  pthread_mutex_lock(&arenaLock);
+  chunk->nextFree = freeChunks;
+  freeChunks = chunk;
+  pthread_mutex_unlock(&arenaLock);
+}
+
+
+//
+// The task is done allocating from its current chunk.
+//
+static void retireChunk(chpl_mem_taskArena_t* arena) {
+  arenaChunk* chunk = arena->chunk;
+  int64_t delta;
+
+  if (chunk == NULL)
+    return;
+
+  delta = arena->numAllocs - CHUNK_REFS_BIAS;
+  if (atomic_fetch_add_int_least64_t(&chunk->refs, delta) + delta == 0)
+    putChunk(chunk);
+
+  arena->chunk = NULL;
+  arena->next = arena->end = NULL;
+  arena->numAllocs = 0;
+}
+
+
+void chpl_mem_arena_use(void) {
+  chpl_task_prvData_t* prvData = chpl_task_getPrvData();
+  chpl_mem_taskArena_t* arena;
+
+  if (prvData == NULL || prvData->mem_arena.inUse)
+    return;
+  arena = &prvData->mem_arena;
+
+  //
+  // The chunks aren't registered with the network, so arena memory
+  // can't be the target of remote puts and gets.  Only use arenas when
+  // there is no other locale to talk to.
+  //
+  if (chpl_numNodes > 1)
+    return;
+
+  pthread_mutex_lock(&arenaLock);
+  if (!arenaDisabled && chpl_mem_arena_size == 0 && !reserveRegion())
+    arenaDisabled = true;
+  if (!arenaDisabled) {
+    arena->inUse = 1;
+    chpl_mem_arena_numActive++;
+  }
+  pthread_mutex_unlock(&arenaLock);
+}
+
+
+void chpl_mem_arena_taskEnd(chpl_mem_taskArena_t* arena) {
+  if (!arena->inUse)
+    return;
+
+  retireChunk(arena);
+  arena->inUse = 0;
+
+  pthread_mutex_lock(&arenaLock);
+  if (chpl_mem_arena_numActive > 0)
+    chpl_mem_arena_numActive--;
+  pthread_mutex_unlock(&arenaLock);
+}
+
+
+void chpl_mem_arena_exit(void) {
+  //
+  // Tasks that never end through the tasking layer, like the main task,
+  // may still have their arenas.  Stop looking for them, since from
+  // here on allocations may be made outside of any task.  Arena memory
+  // that is still live stays valid.
+  //
+  pthread_mutex_lock(&arenaLock);
+  arenaDisabled = true;
+  chpl_mem_arena_numActive = 0;
+  pthread_mutex_unlock(&arenaLock);
+}
+
+
+void* chpl_mem_arena_alloc_slow(chpl_mem_taskArena_t* arena, size_t size) {
+  arenaChunk* chunk;
+
+  retireChunk(arena);
+
+  if ((chunk = getChunk()) == NULL)
+    return NULL;                        // region used up; use the heap
+
+  arena->chunk = chunk;
+  arena->next = (char*) chunk + CHUNK_FIRST_OBJ - CHPL_MEM_ARENA_HDR_SIZE;
+  arena->end = (char*) chunk + CHPL_MEM_ARENA_CHUNK_SIZE;
+  return chpl_mem_arena_allocFrom(arena, size);
+}
+
+
+void chpl_mem_arena_free(void* memAlloc) {
+  arenaChunk* chunk =
+    (arenaChunk*) ((uintptr_t) memAlloc
+                   & ~(uintptr_t) (CHPL_MEM_ARENA_CHUNK_SIZE - 1));
+
+  if (atomic_fetch_sub_int_least64_t(&chunk->refs, 1) == 1)
+    putChunk(chunk);
+}
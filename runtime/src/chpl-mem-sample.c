@@ -0,0 +1,588 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Sampling allocation profiler, see chpl-mem-sample.h.
+//
+#include "chplrt.h"
+
+#include "chpl-mem-sample.h"
+#include "chpl-atomics.h"
+#include "chpl-mem-desc.h"
+#include "chpl-mem-sys.h"  // the profiler's own tables must not be sampled
+#include "chpl-tasks.h"
+#include "chpl-comm.h"
+#include "chpl-linefile-support.h"
+#include "chpl-thread-local-storage.h"
+#include "error.h"
+
+#include <inttypes.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+size_t chpl_memSampleRate = 0;
+
+chpl_mem_sample_filter_t* volatile chpl_mem_sample_filter = NULL;
+
+//
+// Allocations are charged to sites, one per description and source
+// location.  The counts are estimates of the totals over all
+// allocations, not just the sampled ones.
+//
+typedef struct sampleSite_struct {
+  chpl_mem_descInt_t description;
+  int32_t lineno;
+  int32_t filename;
+  double allocObjects;
+  double allocBytes;
+  double liveObjects;
+  double liveBytes;
+  struct sampleSite_struct* nextInBucket;
+} sampleSite;
+
+// A sampled allocation that has not been freed yet
+typedef struct sampleEntry_struct {
+  void* memAlloc;
+  double objects;               /* estimated allocations it stands for */
+  double bytes;                 /* estimated bytes it stands for */
+  sampleSite* site;
+  struct sampleEntry_struct* nextInBucket;
+} sampleEntry;
+
+#define NUM_SITE_BUCKETS 4096
+
+static sampleSite* siteTable[NUM_SITE_BUCKETS];
+static size_t numSites = 0;
+
+//
+// The entry table and the filter are indexed by the same hash of the
+// address: an entry's bucket is the top bits of its filter index.  So
+// the entries that share a filter bit are all in one bucket, and a free
+// can tell whether to clear the bit by looking through that bucket.
+// The filter has 2^LOG2_FILTER_BITS_PER_BUCKET bits per bucket, and
+// there are at least as many buckets as entries, so that few frees of
+// unsampled allocations hit a set bit.
+//
+#define LOG2_FILTER_BITS_PER_BUCKET 8
+
+static sampleEntry** entryTable = NULL;
+static int entryTableLog2Size = 0;
+static size_t numEntries = 0;
+
+static chpl_sync_aux_t sampleSync;
+
+static size_t sampleInterval = 0;  /* estimated bytes between dumps */
+static double bytesSinceDump = 0;
+static int numDumps = 0;
+static FILE* sampleLogFile = NULL;
+
+static atomic_uint_least64_t numSampleThreads;
+
+
+//
+// Per-thread sampling state.  The countdown is tested inline in
+// chpl_mem_sample_malloc(), so where there is no compiler support for
+// thread-local storage every allocation comes here and the countdown
+// is kept in pthread thread-specific data.
+//
+#ifdef CHPL_TLS
+CHPL_TLS int64_t chpl_mem_sample_bytesLeft;
+static CHPL_TLS uint64_t sampleRandState;
+
+static int64_t* getBytesLeft(void) { return &chpl_mem_sample_bytesLeft; }
+static uint64_t* getRandState(void) { return &sampleRandState; }
+#else
+typedef struct {
+  int64_t bytesLeft;
+  uint64_t randState;
+} sampleThreadState;
+
+static pthread_key_t sampleThreadKey;
+
+static void freeThreadState(void* state) {
+  sys_free(state);
+}
+
+static sampleThreadState* getThreadState(void) {
+  sampleThreadState* state = pthread_getspecific(sampleThreadKey);
+  if (state == NULL) {
+    state = sys_calloc(1, sizeof(sampleThreadState));
+    if (state == NULL)
+      chpl_internal_error("out of memory for allocation sampling");
+    pthread_setspecific(sampleThreadKey, state);
+  }
+  return state;
+}
+
+static int64_t* getBytesLeft(void) { return &getThreadState()->bytesLeft; }
+static uint64_t* getRandState(void) { return &getThreadState()->randState; }
+#endif
+
+
+static uint64_t nextRand(uint64_t* state) {
+  // xorshift64*
+  uint64_t x = *state;
+  x ^= x >> 12;
+  x ^= x << 25;
+  x ^= x >> 27;
+  *state = x;
+  return x * UINT64_C(0x2545F4914F6CDD1D);
+}
+
+
+//
+// Draw the number of bytes until the next sample.  A rate of 1 samples
+// every allocation, which makes the profile exact.
+//
+static int64_t nextInterval(uint64_t* state) {
+  double u;
+  double interval;
+
+  if (chpl_memSampleRate <= 1)
+    return 0;
+
+  // u is uniform in (0, 1]
+  u = (double)((nextRand(state) >> 11) + 1) * (1.0 / 9007199254740992.0);
+  interval = -log(u) * (double)chpl_memSampleRate;
+  if (interval >= (double)INT64_MAX)
+    return INT64_MAX;
+  return (int64_t)interval;
+}
+
+
+static chpl_mem_sample_filter_t* newFilter(int log2Bits) {
+  size_t numWords = ((size_t)1 << log2Bits) / 64;
+  chpl_mem_sample_filter_t* f;
+
+  f = sys_calloc(1, sizeof(chpl_mem_sample_filter_t)
+                    + numWords * sizeof(uint64_t));
+  if (f == NULL)
+    chpl_internal_error("out of memory for allocation sampling");
+  f->log2Bits = log2Bits;
+  f->words = (volatile uint64_t*)(f + 1);
+  return f;
+}
+
+
+void chpl_mem_sample_init(size_t rate, size_t interval, FILE* logFile) {
+  if (rate == 0)
+    return;
+
+  chpl_sync_initAux(&sampleSync);
+  atomic_init_uint_least64_t(&numSampleThreads, 0);
+#ifndef CHPL_TLS
+  if (pthread_key_create(&sampleThreadKey, freeThreadState) != 0)
+    chpl_internal_error("cannot create allocation sampling thread key");
+#endif
+
+  entryTableLog2Size = 10;
+  entryTable = sys_calloc((size_t)1 << entryTableLog2Size,
+                          sizeof(sampleEntry*));
+  if (entryTable == NULL)
+    chpl_internal_error("out of memory for allocation sampling");
+  chpl_mem_sample_filter = newFilter(entryTableLog2Size
+                                     + LOG2_FILTER_BITS_PER_BUCKET);
+
+  sampleInterval = interval;
+  sampleLogFile = logFile;
+
+  // Set this last; it turns sampling on in the allocation hooks.
+  chpl_memSampleRate = rate;
+}
+
+
+static unsigned siteHash(chpl_mem_descInt_t description,
+                         int32_t lineno, int32_t filename) {
+  uint64_t h = ((uint64_t)(uint32_t)filename << 32) | (uint32_t)lineno;
+  h = (h ^ (uint64_t)description) * UINT64_C(0x9E3779B97F4A7C15);
+  return (unsigned)(h >> 52) % NUM_SITE_BUCKETS;
+}
+
+
+static sampleSite* findSite(chpl_mem_descInt_t description,
+                            int32_t lineno, int32_t filename) {
+  unsigned b = siteHash(description, lineno, filename);
+  sampleSite* site;
+
+  for (site = siteTable[b]; site != NULL; site = site->nextInBucket) {
+    if (site->description == description && site->lineno == lineno
+        && site->filename == filename)
+      return site;
+  }
+
+  site = sys_calloc(1, sizeof(sampleSite));
+  if (site == NULL)
+    chpl_internal_error("out of memory for allocation sampling");
+  site->description = description;
+  site->lineno = lineno;
+  site->filename = filename;
+  site->nextInBucket = siteTable[b];
+  siteTable[b] = site;
+  numSites++;
+  return site;
+}
+
+
+static size_t entryHash(void* memAlloc) {
+  return (size_t)chpl_mem_sample_filterIndex(memAlloc, entryTableLog2Size);
+}
+
+
+static uint64_t filterIndex(void* memAlloc) {
+  return chpl_mem_sample_filterIndex(memAlloc, entryTableLog2Size
+                                               + LOG2_FILTER_BITS_PER_BUCKET);
+}
+
+
+//
+// Double the entry table, and replace the filter with one twice as
+// large to go with it.  The old filter is not freed, since a free may
+// still be reading it; each is half the size of the next, so together
+// they take no more memory than the current one.
+//
+static void growEntryTable(void) {
+  const size_t oldSize = (size_t)1 << entryTableLog2Size;
+  sampleEntry** newTable = sys_calloc(2 * oldSize, sizeof(sampleEntry*));
+  chpl_mem_sample_filter_t* newF;
+  size_t i;
+
+  if (newTable == NULL)
+    chpl_internal_error("out of memory for allocation sampling");
+
+  entryTableLog2Size++;
+  newF = newFilter(entryTableLog2Size + LOG2_FILTER_BITS_PER_BUCKET);
+
+  for (i = 0; i < oldSize; i++) {
+    sampleEntry* entry = entryTable[i];
+    while (entry != NULL) {
+      sampleEntry* next = entry->nextInBucket;
+      size_t b = entryHash(entry->memAlloc);
+      uint64_t j = filterIndex(entry->memAlloc);
+      entry->nextInBucket = newTable[b];
+      newTable[b] = entry;
+      newF->words[j / 64] |= UINT64_C(1) << (j % 64);
+      entry = next;
+    }
+  }
+
+  sys_free(entryTable);
+  entryTable = newTable;
+
+  // Finish filling in the new filter before publishing it.
+  atomic_thread_fence(memory_order_release);
+  chpl_mem_sample_filter = newF;
+}
+
+
+//
+// Add a sampled allocation to the entry table and the filter.  The
+// caller holds sampleSync.
+//
+static void insertEntry(sampleEntry* entry) {
+  size_t b;
+  uint64_t j;
+
+  if (numEntries >= ((size_t)1 << entryTableLog2Size))
+    growEntryTable();
+  b = entryHash(entry->memAlloc);
+  entry->nextInBucket = entryTable[b];
+  entryTable[b] = entry;
+  numEntries++;
+
+  j = filterIndex(entry->memAlloc);
+  chpl_mem_sample_filter->words[j / 64] |= UINT64_C(1) << (j % 64);
+}
+
+
+//
+// Remove the entry for memAlloc from the entry table and return it, or
+// NULL if it wasn't sampled.  Its filter bit is cleared unless another
+// entry in the bucket has the same one.  The caller holds sampleSync.
+//
+static sampleEntry* removeEntry(void* memAlloc) {
+  const uint64_t j = filterIndex(memAlloc);
+  sampleEntry** link;
+  sampleEntry* entry = NULL;
+  sampleEntry* other;
+
+  for (link = &entryTable[entryHash(memAlloc)];
+       *link != NULL;
+       link = &(*link)->nextInBucket) {
+    if ((*link)->memAlloc == memAlloc) {
+      entry = *link;
+      *link = entry->nextInBucket;
+      numEntries--;
+      break;
+    }
+  }
+
+  if (entry == NULL)
+    return NULL;
+
+  for (other = entryTable[entryHash(memAlloc)];
+       other != NULL;
+       other = other->nextInBucket) {
+    if (filterIndex(other->memAlloc) == j)
+      return entry;
+  }
+  chpl_mem_sample_filter->words[j / 64] &= ~(UINT64_C(1) << (j % 64));
+
+  return entry;
+}
+
+
+static void dumpProfile(const char* title);
+
+
+void chpl_mem_sample_malloc_slow(void* memAlloc, size_t size,
+                                 chpl_mem_descInt_t description,
+                                 int32_t lineno, int32_t filename) {
+  int64_t* bytesLeft = getBytesLeft();
+  uint64_t* randState = getRandState();
+  double objects;
+  sampleEntry* entry;
+  sampleSite* site;
+
+#ifndef CHPL_TLS
+  *bytesLeft -= (int64_t)size;
+  if (*bytesLeft >= 0)
+    return;
+#endif
+
+  if (*randState == 0) {
+    // This thread's first trip here: its countdown was never started
+    uint64_t id = atomic_fetch_add_uint_least64_t(&numSampleThreads, 1);
+    *randState = ((uint64_t)(uintptr_t)randState
+                  ^ ((uint64_t)chpl_nodeID << 40)
+                  ^ (id * UINT64_C(0x9E3779B97F4A7C15))) | 1;
+    *bytesLeft += nextInterval(randState);
+    if (*bytesLeft >= 0)
+      return;
+  }
+
+  // The bytes until the next sample start over after this allocation.
+  *bytesLeft = nextInterval(randState);
+
+  // Don't sample the allocations the memory tracker ignores either;
+  // some of them are made while the tasking layer holds its own locks.
+  if (memAlloc == NULL || !chpl_mem_descTrack(description))
+    return;
+
+  // An allocation of size bytes is sampled with probability
+  // 1 - exp(-size/rate), so it stands for the inverse of that many.
+  if (chpl_memSampleRate <= 1)
+    objects = 1.0;
+  else
+    objects = 1.0 / -expm1(-(double)size / (double)chpl_memSampleRate);
+
+  entry = sys_malloc(sizeof(sampleEntry));
+  if (entry == NULL)
+    chpl_internal_error("out of memory for allocation sampling");
+  entry->memAlloc = memAlloc;
+  entry->objects = objects;
+  entry->bytes = objects * (double)size;
+
+  chpl_sync_lock(&sampleSync);
+
+  site = findSite(description, lineno, filename);
+  site->allocObjects += entry->objects;
+  site->allocBytes += entry->bytes;
+  site->liveObjects += entry->objects;
+  site->liveBytes += entry->bytes;
+  entry->site = site;
+  insertEntry(entry);
+
+  bytesSinceDump += entry->bytes;
+  if (sampleInterval > 0 && bytesSinceDump >= (double)sampleInterval) {
+    bytesSinceDump = 0;
+    dumpProfile("Sampled Heap Profile");
+  }
+
+  chpl_sync_unlock(&sampleSync);
+}
+
+
+void chpl_mem_sample_free_slow(void* memAlloc) {
+  sampleEntry* entry;
+
+  chpl_sync_lock(&sampleSync);
+
+  if ((entry = removeEntry(memAlloc)) != NULL) {
+    entry->site->liveObjects -= entry->objects;
+    entry->site->liveBytes -= entry->bytes;
+  }
+
+  chpl_sync_unlock(&sampleSync);
+
+  if (entry != NULL)
+    sys_free(entry);
+}
+
+
+void chpl_mem_sample_realloc_slow(void* moreMemAlloc, void* memAlloc,
+                                  size_t size) {
+  sampleEntry* entry;
+
+  chpl_sync_lock(&sampleSync);
+
+  // The entry keeps standing for as many allocations as it did, now of
+  // the new size.  Growing them counts as allocating the added bytes.
+  if ((entry = removeEntry(memAlloc)) != NULL) {
+    const double bytes = entry->objects * (double)size;
+    entry->site->liveBytes += bytes - entry->bytes;
+    if (bytes > entry->bytes) {
+      entry->site->allocBytes += bytes - entry->bytes;
+      bytesSinceDump += bytes - entry->bytes;
+    }
+    entry->bytes = bytes;
+    entry->memAlloc = moreMemAlloc;
+    insertEntry(entry);
+  }
+
+  chpl_sync_unlock(&sampleSync);
+}
+
+
+static int siteCmp(const void* p1, const void* p2) {
+  const sampleSite* s1 = *(sampleSite* const*)p1;
+  const sampleSite* s2 = *(sampleSite* const*)p2;
+
+  // Most live bytes first, then most allocated bytes
+  if (s1->liveBytes != s2->liveBytes)
+    return (s1->liveBytes < s2->liveBytes) ? 1 : -1;
+  if (s1->allocBytes != s2->allocBytes)
+    return (s1->allocBytes < s2->allocBytes) ? 1 : -1;
+  if (s1->filename != s2->filename)
+    return (s1->filename < s2->filename) ? -1 : 1;
+  if (s1->lineno != s2->lineno)
+    return (s1->lineno < s2->lineno) ? -1 : 1;
+  return (s1->description < s2->description) ? -1
+         : (s1->description > s2->description);
+}
+
+
+static uint64_t roundEstimate(double x) {
+  return (x <= 0) ? 0 : (uint64_t)(x + 0.5);
+}
+
+
+//
+// Print one line per site, in the layout of printMemAllocs().  The
+// caller holds sampleSync.
+//
+static void dumpProfile(const char* title) {
+  const int numberWidth = 13;
+  const int descWidth   = 33;
+  int filenameWidth     = strlen("Location");
+  int totalWidth;
+  sampleSite** sites;
+  sampleSite* site;
+  char* loc;
+  double liveBytes = 0, allocBytes = 0;
+  size_t n = 0;
+  size_t i;
+
+  sites = sys_malloc((numSites + 1) * sizeof(sampleSite*));
+  if (sites == NULL)
+    chpl_internal_error("out of memory printing allocation samples");
+
+  for (i = 0; i < NUM_SITE_BUCKETS; i++) {
+    for (site = siteTable[i]; site != NULL; site = site->nextInBucket) {
+      sites[n++] = site;
+      liveBytes += site->liveBytes;
+      allocBytes += site->allocBytes;
+      if (site->filename) {
+        int len = strlen(chpl_lookupFilename(site->filename)) + 11;
+        if (len > filenameWidth)
+          filenameWidth = len;
+      }
+    }
+  }
+  qsort(sites, n, sizeof(sampleSite*), siteCmp);
+
+  totalWidth = filenameWidth + numberWidth * 4 + descWidth;
+  numDumps++;
+
+  fprintf(sampleLogFile,
+          "%s %d (locale %" FORMAT_c_nodeid_t ", 1 sample per %zu bytes)\n",
+          title, numDumps, chpl_nodeID, chpl_memSampleRate);
+  fprintf(sampleLogFile, "Estimated live bytes: %" PRIu64
+          ", estimated allocated bytes: %" PRIu64 "\n",
+          roundEstimate(liveBytes), roundEstimate(allocBytes));
+  for (i = 0; i < (size_t)totalWidth; i++)
+    fputc('=', sampleLogFile);
+  fputc('\n', sampleLogFile);
+  fprintf(sampleLogFile, "%-*s%-*s%-*s%-*s%-*s%s\n",
+          filenameWidth, "Location",
+          numberWidth, "Live Bytes",
+          numberWidth, "Live Number",
+          numberWidth, "Total Bytes",
+          numberWidth, "Total Number",
+          "Description");
+  for (i = 0; i < (size_t)totalWidth; i++)
+    fputc('=', sampleLogFile);
+  fputc('\n', sampleLogFile);
+
+  loc = sys_malloc(filenameWidth + 1);
+  if (loc == NULL)
+    chpl_internal_error("out of memory printing allocation samples");
+
+  for (i = 0; i < n; i++) {
+    site = sites[i];
+    if (site->filename)
+      snprintf(loc, filenameWidth + 1, "%s:%" PRId32,
+               chpl_lookupFilename(site->filename), site->lineno);
+    else
+      snprintf(loc, filenameWidth + 1, "--");
+    fprintf(sampleLogFile, "%-*s%-*" PRIu64 "%-*" PRIu64 "%-*" PRIu64
+                           "%-*" PRIu64 "%s\n",
+            filenameWidth, loc,
+            numberWidth, roundEstimate(site->liveBytes),
+            numberWidth, roundEstimate(site->liveObjects),
+            numberWidth, roundEstimate(site->allocBytes),
+            numberWidth, roundEstimate(site->allocObjects),
+            chpl_mem_descString(site->description));
+  }
+  for (i = 0; i < (size_t)totalWidth; i++)
+    fputc('=', sampleLogFile);
+  fputc('\n', sampleLogFile);
+  fflush(sampleLogFile);
+
+  sys_free(loc);
+  sys_free(sites);
+}
+
+
+void chpl_mem_sample_report(void) {
+  if (chpl_memSampleRate == 0)
+    return;
+
+  chpl_sync_lock(&sampleSync);
+  fputc('\n', sampleLogFile);
+  dumpProfile("Final Sampled Heap Profile");
+
+  // Stop sampling, since the log may be closed after this.
+  sampleInterval = 0;
+  chpl_memSampleRate = 0;
+  chpl_sync_unlock(&sampleSync);
+}
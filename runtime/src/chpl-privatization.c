@@ -20,70 +20,75 @@
 #include "chplrt.h"
 #include "chpl-privatization.h"
 #include "chpl-mem.h"
-#include "chpl-tasks.h"
+#include "chpl-atomics.h"
 
-static int64_t chpl_capPrivateObjects = 0;
-static chpl_sync_aux_t privatizationSync;
+atomic_uintptr_t chpl_privateObjects[CHPL_PRIVATIZATION_NUM_SEGMENTS];
 
-void** chpl_privateObjects = NULL;
+// The number of non-NULL entries, so we don't have to scan the table.
+static atomic_int_least64_t chpl_numPrivateObjects;
 
 void chpl_privatization_init(void) {
-    chpl_sync_initAux(&privatizationSync);
+  int i;
+
+  for (i = 0; i < CHPL_PRIVATIZATION_NUM_SEGMENTS; i++)
+    atomic_init_uintptr_t(&chpl_privateObjects[i], (uintptr_t) NULL);
+  atomic_init_int_least64_t(&chpl_numPrivateObjects, 0);
 }
 
-static inline int64_t max(int64_t a, int64_t b) {
-  return a > b ? a : b;
+// Return segment seg, allocating it if no one has yet. Several tasks can
+// race to allocate the same segment; the first one to publish it wins and
+// the others free theirs.
+static void** getSegment(int seg) {
+  uintptr_t cur;
+  uintptr_t mine;
+  size_t size;
+
+  cur = atomic_load_explicit_uintptr_t(&chpl_privateObjects[seg],
+                                       memory_order_acquire);
+  if (cur != (uintptr_t) NULL)
+    return (void**) cur;
+
+  size = (size_t) CHPL_PRIVATIZATION_SEGMENT0_SIZE << seg;
+  mine = (uintptr_t) chpl_mem_allocManyZero(size, sizeof(void *),
+                                           CHPL_RT_MD_COMM_PRV_OBJ_ARRAY,
+                                           0, 0);
+  if (atomic_compare_exchange_strong_uintptr_t(&chpl_privateObjects[seg],
+                                               (uintptr_t) NULL, mine))
+    return (void**) mine;
+
+  // Someone else got there first, so use their segment.
+  chpl_mem_free((void*) mine, 0, 0);
+  return (void**) atomic_load_explicit_uintptr_t(&chpl_privateObjects[seg],
+                                                 memory_order_acquire);
 }
 
 // Note that this function can be called in parallel and more notably it can be
 // called with non-monotonic pid's. e.g. this may be called with pid 27, and
-// then pid 2, so it has to ensure that the privatized array has at least pid+1
-// elements. Be __very__ careful if you have to update it.
+// then pid 2. Entries never move once their segment exists, so this doesn't
+// need a lock and chpl_getPrivatizedClass doesn't either.
 void chpl_newPrivatizedClass(void* v, int64_t pid) {
-  chpl_sync_lock(&privatizationSync);
-
-  // initialize array to a default size
-  if (chpl_privateObjects == NULL) {
-    chpl_capPrivateObjects = 2*max(pid, 4);
-    chpl_privateObjects =
-        chpl_mem_allocManyZero(chpl_capPrivateObjects, sizeof(void *),
-                           CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-  } else {
-    // if we're out of space, double (or more) the array size
-    if (pid >= chpl_capPrivateObjects) {
-      void** tmp;
-      int64_t oldCap;
-
-      oldCap = chpl_capPrivateObjects;
-      chpl_capPrivateObjects = 2*max(pid, oldCap);
+  uint64_t idx;
+  int seg = chpl_privatizationSegment(pid, &idx);
+  void** objs = getSegment(seg);
 
-      tmp = chpl_mem_allocManyZero(chpl_capPrivateObjects, sizeof(void *),
-                                   CHPL_RT_MD_COMM_PRV_OBJ_ARRAY, 0, 0);
-      chpl_memcpy((void*)tmp, (void*)chpl_privateObjects, (oldCap)*sizeof(void*));
-      chpl_privateObjects = tmp;
-      // purposely leak old copies of chpl_privateObject to avoid the need to
-      // lock chpl_getPrivatizedClass; TODO: fix with lock free data structure
-    }
-  }
-  chpl_privateObjects[pid] = v;
-
-  chpl_sync_unlock(&privatizationSync);
+  if (objs[idx] == NULL && v != NULL)
+    atomic_fetch_add_int_least64_t(&chpl_numPrivateObjects, 1);
+  objs[idx] = v;
 }
 
 void chpl_clearPrivatizedClass(int64_t i) {
-  chpl_sync_lock(&privatizationSync);
-  chpl_privateObjects[i] = NULL;
-  chpl_sync_unlock(&privatizationSync);
+  uint64_t idx;
+  int seg = chpl_privatizationSegment(i, &idx);
+  void** objs = (void**) atomic_load_explicit_uintptr_t(
+                           &chpl_privateObjects[seg], memory_order_acquire);
+
+  if (objs[idx] != NULL) {
+    objs[idx] = NULL;
+    atomic_fetch_sub_int_least64_t(&chpl_numPrivateObjects, 1);
+  }
 }
 
 // Used to check for leaks of privatized classes
 int64_t chpl_numPrivatizedClasses(void) {
-  int64_t ret = 0;
-  chpl_sync_lock(&privatizationSync);
-  for (int64_t i = 0; i < chpl_capPrivateObjects; i++) {
-    if (chpl_privateObjects[i])
-      ret++;
-  }
-  chpl_sync_unlock(&privatizationSync);
-  return ret;
+  return atomic_load_int_least64_t(&chpl_numPrivateObjects);
 }
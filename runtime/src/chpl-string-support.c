@@ -128,6 +128,58 @@ int string_index_of(c_string haystack, c_string needle) {
   return substring ? (int) (substring-haystack)+1 : 0;
 }
 
+// Returns the offset of the first occurrence of the nLen bytes at needle
+// within the hLen bytes at haystack, or -1 if there is none.  Neither
+// needs to be NUL-terminated.  memchr(), which C libraries vectorize,
+// skips to each place the first byte of the needle occurs, and only
+// there are the last byte and then the rest of the needle compared.
+int64_t string_find_bytes(const uint8_t* haystack, int64_t hLen,
+                          const uint8_t* needle, int64_t nLen) {
+  const uint8_t* p = haystack;
+  const uint8_t* end;
+  uint8_t first;
+  uint8_t last;
+
+  if (nLen == 0)
+    return 0;
+  if (nLen > hLen)
+    return -1;
+
+  first = needle[0];
+  last = needle[nLen-1];
+  end = haystack + (hLen - nLen) + 1;  // just past the last possible match
+  while ((p = memchr(p, first, end - p)) != NULL) {
+    if (p[nLen-1] == last && memcmp(p + 1, needle + 1, nLen - 1) == 0)
+      return p - haystack;
+    p++;
+  }
+
+  return -1;
+}
+
+// Like string_find_bytes(), but returns the offset of the last occurrence.
+int64_t string_rfind_bytes(const uint8_t* haystack, int64_t hLen,
+                           const uint8_t* needle, int64_t nLen) {
+  uint8_t first;
+  uint8_t last;
+  int64_t i;
+
+  if (nLen == 0)
+    return hLen;
+  if (nLen > hLen)
+    return -1;
+
+  first = needle[0];
+  last = needle[nLen-1];
+  for (i = hLen - nLen; i >= 0; i--) {
+    if (haystack[i] == first && haystack[i + nLen - 1] == last &&
+        memcmp(haystack + i + 1, needle + 1, nLen - 1) == 0)
+      return i;
+  }
+
+  return -1;
+}
+
 // Returns a newly-allocated string containing (a copy of) the bytes selected
 // from the original string.
 // It is up to the caller to make sure low and high are within the string
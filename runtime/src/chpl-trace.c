@@ -0,0 +1,434 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+//
+// Event tracer, see chpl-trace.h.
+//
+
+#include "chplrt.h"
+
+#include "chpl-trace.h"
+#include "chpl-atomics.h"
+#include "chpl-comm.h"
+#include "chpl-comm-callbacks.h"
+#include "chpl-env.h"
+#include "chpl-linefile-support.h"
+#include "chpl-mem-sys.h"
+#include "chpl-tasks.h"
+#include "chpl-tasks-callbacks.h"
+#include "chpl-thread-local-storage.h"
+#include "chplcgfns.h"
+#include "chpltimers.h"
+#include "error.h"
+
+#include <errno.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+
+typedef enum {
+  trace_task_create,
+  trace_task_begin,
+  trace_task_end,
+  trace_comm_first,             // comm events are this + the callback kind
+} traceKind;
+
+static const char* commEventNames[chpl_comm_cb_num_event_kinds] = {
+  "put", "put_nb", "put_strd",
+  "get", "get_nb", "get_strd",
+  "executeOn", "executeOn_nb", "executeOn_fast"
+};
+
+typedef struct {
+  int64_t ts;                   // microseconds since the epoch
+  uint64_t id;                  // task ID, or bytes sent by a comm event
+  int32_t kind;                 // traceKind
+  int32_t fid;                  // task or executeOn function
+  int32_t filename;
+  int32_t lineno;
+  int32_t node;                 // remote locale of a comm event
+} traceEvent;
+
+//
+// Each thread has its own ring of events.  Only the owning thread adds
+// events, at tail, and only the holder of traceLock writes them out and
+// advances head, so neither side needs a lock to see the other's work.
+// The writer thread does that in the background, so the threads that
+// record events never format or write them.  A thread whose ring is
+// half full wakes the writer early, and one whose ring is full yields
+// to it until there is room.
+//
+#define TRACE_RING_SIZE 4096    // a power of 2
+#define TRACE_WRITE_INTERVAL_NS 10000000
+
+typedef struct traceRing_struct {
+  atomic_uint_least64_t head;   // next event to write out
+  atomic_uint_least64_t tail;   // next slot to fill
+  uint64_t ownerTail;           // owner's copy of tail
+  uint64_t ownerHead;           // owner's last look at head
+  int tid;                      // trace thread ID
+  chpl_bool named;              // thread_name record written?
+  struct traceRing_struct* next;
+  traceEvent events[TRACE_RING_SIZE];
+} traceRing;
+
+static chpl_bool tracing = false;
+
+static FILE* traceFile = NULL;
+static chpl_bool traceFileHasEvents = false;
+static int numFids = 0;
+
+static pthread_mutex_t traceLock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t traceWake = PTHREAD_COND_INITIALIZER;
+static pthread_t traceWriter;
+static chpl_bool traceWriterRunning = false;
+static traceRing* allRings = NULL;    // protected by traceLock
+static int numRings = 0;              // protected by traceLock
+
+CHPL_TLS_DECL(traceRing*, traceMyRing);
+
+
+static int64_t traceNow(void) {
+  _timevalue t = chpl_now_timevalue();
+  return chpl_timevalue_seconds(t) * 1000000
+         + chpl_timevalue_microseconds(t);
+}
+
+
+// Write a string as the body of a JSON string.
+static void writeJSONString(const char* s) {
+  for (; *s != '\0'; s++) {
+    if (*s == '"' || *s == '\\')
+      fputc('\\', traceFile);
+    if ((unsigned char)*s >= ' ')
+      fputc(*s, traceFile);
+  }
+}
+
+
+static void writeEventStart(const char* name, const char* ph, int64_t ts,
+                            int tid) {
+  fputs(traceFileHasEvents ? ",\n" : "\n", traceFile);
+  traceFileHasEvents = true;
+  fputs("{\"name\":\"", traceFile);
+  writeJSONString(name);
+  fprintf(traceFile, "\",\"ph\":\"%s\",\"ts\":%" PRId64
+                     ",\"pid\":%d,\"tid\":%d",
+          ph, ts, (int)chpl_nodeID, tid);
+}
+
+
+static void writeLocation(int32_t filename, int32_t lineno) {
+  fputs(",\"loc\":\"", traceFile);
+  writeJSONString(filename ? chpl_lookupFilename(filename) : "--");
+  fprintf(traceFile, ":%" PRId32 "\"", lineno);
+}
+
+
+static const char* fidName(int32_t fid) {
+  return (fid >= 0 && fid < numFids) ? chpl_finfo[fid].name : "task";
+}
+
+
+// Write out one event.  The caller holds traceLock.
+static void writeEvent(const traceEvent* ev, int tid) {
+  switch (ev->kind) {
+  case trace_task_create:
+    writeEventStart("create", "i", ev->ts, tid);
+    fprintf(traceFile, ",\"s\":\"t\",\"args\":{\"id\":%" PRIu64, ev->id);
+    writeLocation(ev->filename, ev->lineno);
+    fputs("}}", traceFile);
+    break;
+
+  //
+  // A task's begin and end are async events keyed by the task ID rather
+  // than duration events on the thread: tasking layers that switch
+  // between blocked tasks interleave them on one thread, so they don't
+  // nest there.
+  //
+  case trace_task_begin:
+    writeEventStart(fidName(ev->fid), "b", ev->ts, tid);
+    fprintf(traceFile, ",\"cat\":\"task\",\"id\":%" PRIu64
+                       ",\"args\":{\"id\":%" PRIu64, ev->id, ev->id);
+    writeLocation(ev->filename, ev->lineno);
+    fputs("}}", traceFile);
+    break;
+
+  case trace_task_end:
+    writeEventStart(fidName(ev->fid), "e", ev->ts, tid);
+    fprintf(traceFile, ",\"cat\":\"task\",\"id\":%" PRIu64 "}", ev->id);
+    break;
+
+  default: {
+    chpl_comm_cb_event_kind_t ck =
+      (chpl_comm_cb_event_kind_t)(ev->kind - trace_comm_first);
+    writeEventStart(commEventNames[ck], "i", ev->ts, tid);
+    fprintf(traceFile, ",\"s\":\"t\",\"args\":{\"node\":%" PRId32, ev->node);
+    if (ck == chpl_comm_cb_event_kind_executeOn
+        || ck == chpl_comm_cb_event_kind_executeOn_nb
+        || ck == chpl_comm_cb_event_kind_executeOn_fast) {
+      fputs(",\"fn\":\"", traceFile);
+      writeJSONString(fidName(ev->fid));
+      fprintf(traceFile, "\",\"argBytes\":%" PRIu64, ev->id);
+    } else {
+      fprintf(traceFile, ",\"bytes\":%" PRIu64, ev->id);
+      writeLocation(ev->filename, ev->lineno);
+    }
+    fputs("}}", traceFile);
+    break;
+  }
+  }
+}
+
+
+// Write out the events in a ring.  The caller holds traceLock.
+static void drainRing(traceRing* ring) {
+  uint64_t head = atomic_load_uint_least64_t(&ring->head);
+  uint64_t tail = atomic_load_uint_least64_t(&ring->tail);
+
+  if (!ring->named) {
+    writeEventStart("thread_name", "M", 0, ring->tid);
+    fprintf(traceFile, ",\"args\":{\"name\":\"thread %d\"}}", ring->tid);
+    ring->named = true;
+  }
+
+  for (; head != tail; head++)
+    writeEvent(&ring->events[head & (TRACE_RING_SIZE - 1)], ring->tid);
+
+  atomic_store_uint_least64_t(&ring->head, head);
+}
+
+
+// Write out all the rings.  The caller holds traceLock.
+static void drainRings(void) {
+  traceRing* ring;
+
+  for (ring = allRings; ring != NULL; ring = ring->next)
+    drainRing(ring);
+}
+
+
+static void* traceWriterMain(void* arg) {
+  struct timespec wake;
+
+  pthread_mutex_lock(&traceLock);
+  while (tracing) {
+    drainRings();
+    fflush(traceFile);
+
+    clock_gettime(CLOCK_REALTIME, &wake);
+    wake.tv_nsec += TRACE_WRITE_INTERVAL_NS;
+    if (wake.tv_nsec >= 1000000000) {
+      wake.tv_sec++;
+      wake.tv_nsec -= 1000000000;
+    }
+    if (tracing)
+      pthread_cond_timedwait(&traceWake, &traceLock, &wake);
+  }
+  pthread_mutex_unlock(&traceLock);
+
+  return NULL;
+}
+
+
+static traceRing* getRing(void) {
+  traceRing* ring = CHPL_TLS_GET(traceMyRing);
+
+  if (ring == NULL) {
+    ring = (traceRing*) sys_calloc(1, sizeof(traceRing));
+    if (ring == NULL)
+      chpl_internal_error("out of memory for trace buffer");
+    atomic_init_uint_least64_t(&ring->head, 0);
+    atomic_init_uint_least64_t(&ring->tail, 0);
+
+    pthread_mutex_lock(&traceLock);
+    ring->tid = numRings++;
+    ring->next = allRings;
+    allRings = ring;
+    pthread_mutex_unlock(&traceLock);
+
+    CHPL_TLS_SET(traceMyRing, ring);
+  }
+  return ring;
+}
+
+
+static void record(int32_t kind, uint64_t id, int32_t fid,
+                   int32_t filename, int32_t lineno, int32_t node) {
+  traceRing* ring;
+  traceEvent* ev;
+
+  if (!tracing)
+    return;
+
+  ring = getRing();
+
+  // If the ring is full, let the writer catch up rather than lose events.
+  if (ring->ownerTail - ring->ownerHead == TRACE_RING_SIZE) {
+    ring->ownerHead = atomic_load_uint_least64_t(&ring->head);
+    while (ring->ownerTail - ring->ownerHead == TRACE_RING_SIZE) {
+      if (!tracing)
+        return;
+      pthread_cond_signal(&traceWake);
+      sched_yield();
+      ring->ownerHead = atomic_load_uint_least64_t(&ring->head);
+    }
+  }
+
+  ev = &ring->events[ring->ownerTail & (TRACE_RING_SIZE - 1)];
+  ev->ts = traceNow();
+  ev->id = id;
+  ev->kind = kind;
+  ev->fid = fid;
+  ev->filename = filename;
+  ev->lineno = lineno;
+  ev->node = node;
+
+  ring->ownerTail++;
+  atomic_store_uint_least64_t(&ring->tail, ring->ownerTail);
+
+  // Wake the writer once, as the ring passes half full.
+  if (ring->ownerTail - ring->ownerHead == TRACE_RING_SIZE / 2) {
+    ring->ownerHead = atomic_load_uint_least64_t(&ring->head);
+    if (ring->ownerTail - ring->ownerHead == TRACE_RING_SIZE / 2)
+      pthread_cond_signal(&traceWake);
+  }
+}
+
+
+static void cb_task(const chpl_task_cb_info_t* info) {
+  int32_t kind = (info->event_kind == chpl_task_cb_event_kind_create)
+                 ? trace_task_create
+                 : (info->event_kind == chpl_task_cb_event_kind_begin)
+                   ? trace_task_begin : trace_task_end;
+  record(kind, info->iu.full.id, info->iu.full.fid,
+         info->iu.full.filename, info->iu.full.lineno, -1);
+}
+
+
+static void cb_comm(const chpl_comm_cb_info_t* info) {
+  int32_t kind = trace_comm_first + info->event_kind;
+
+  switch (info->event_kind) {
+  case chpl_comm_cb_event_kind_put:
+  case chpl_comm_cb_event_kind_put_nb:
+  case chpl_comm_cb_event_kind_get:
+  case chpl_comm_cb_event_kind_get_nb:
+    record(kind, info->iu.comm.size, -1,
+           info->iu.comm.filename, info->iu.comm.lineno, info->remoteNodeID);
+    break;
+
+  case chpl_comm_cb_event_kind_put_strd:
+  case chpl_comm_cb_event_kind_get_strd: {
+    const struct chpl_comm_info_comm_strd* cm = &info->iu.comm_strd;
+    uint64_t bytes = cm->elemSize;
+    int32_t i;
+    for (i = 0; i <= cm->stridelevels; i++)
+      bytes *= cm->count[i];
+    record(kind, bytes, -1, cm->filename, cm->lineno, info->remoteNodeID);
+    break;
+  }
+
+  default:
+    record(kind, info->iu.executeOn.arg_size, info->iu.executeOn.fid,
+           0, 0, info->remoteNodeID);
+    break;
+  }
+}
+
+
+void chpl_trace_init(void) {
+  const char* root = chpl_get_rt_env("TRACE_FILE", NULL);
+  char fname[1024];
+  int i;
+
+  if (root == NULL || root[0] == '\0')
+    return;
+
+  snprintf(fname, sizeof(fname), "%s-%d.json", root, (int)chpl_nodeID);
+  traceFile = fopen(fname, "w");
+  if (traceFile == NULL) {
+    char msg[1100];
+    snprintf(msg, sizeof(msg), "cannot open trace file %s: %s",
+             fname, strerror(errno));
+    chpl_warning(msg, 0, 0);
+    return;
+  }
+
+  for (numFids = 0; chpl_finfo[numFids].name != NULL; numFids++)
+    ;
+
+  CHPL_TLS_INIT(traceMyRing);
+
+  fputs("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", traceFile);
+  writeEventStart("process_name", "M", 0, 0);
+  fprintf(traceFile, ",\"args\":{\"name\":\"locale %d\"}}", (int)chpl_nodeID);
+
+  tracing = true;
+
+  if (pthread_create(&traceWriter, NULL, traceWriterMain, NULL) != 0) {
+    chpl_warning("cannot start the trace writer thread", 0, 0);
+    tracing = false;
+    fclose(traceFile);
+    traceFile = NULL;
+    return;
+  }
+  traceWriterRunning = true;
+
+  for (i = 0; i < chpl_task_cb_num_event_kinds; i++)
+    chpl_task_install_callback((chpl_task_cb_event_kind_t) i,
+                               chpl_task_cb_info_kind_full, cb_task);
+  for (i = 0; i < chpl_comm_cb_num_event_kinds; i++)
+    chpl_comm_install_callback((chpl_comm_cb_event_kind_t) i, cb_comm);
+}
+
+
+void chpl_trace_exit(void) {
+  int i;
+
+  if (!tracing)
+    return;
+
+  for (i = 0; i < chpl_task_cb_num_event_kinds; i++)
+    chpl_task_uninstall_callback((chpl_task_cb_event_kind_t) i, cb_task);
+  for (i = 0; i < chpl_comm_cb_num_event_kinds; i++)
+    chpl_comm_uninstall_callback((chpl_comm_cb_event_kind_t) i, cb_comm);
+
+  pthread_mutex_lock(&traceLock);
+  tracing = false;
+  pthread_cond_signal(&traceWake);
+  pthread_mutex_unlock(&traceLock);
+
+  if (traceWriterRunning) {
+    pthread_join(traceWriter, NULL);
+    traceWriterRunning = false;
+  }
+
+  pthread_mutex_lock(&traceLock);
+  drainRings();
+  fputs("\n]}\n", traceFile);
+  fclose(traceFile);
+  traceFile = NULL;
+  pthread_mutex_unlock(&traceLock);
+}
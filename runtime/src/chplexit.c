@@ -25,6 +25,7 @@
 #include "chpl-mem.h"
 #include "chplmemtrack.h"
 #include "chpl-topo.h"
+#include "chpl-trace.h"
 #include "gdb.h"
 
 #include <stdio.h>
@@ -38,6 +39,8 @@ static void chpl_exit_common(int status, int all) {
   if (status != 0) {
     gdbShouldBreakHere();
   }
+  chpl_trace_exit();
+  chpl_mem_arena_exit();
   chpl_comm_pre_task_exit(all);
   if (all) {
     chpl_task_exit();
@@ -20,8 +20,10 @@
 #include "chplrt.h"
 
 #include "chplmemtrack.h"
+#include "chpl-atomics.h"
 #include "chpl-mem.h"
 #include "chpl-mem-desc.h"
+#include "chpl-mem-sample.h"
 #include "chpl-mem-sys.h"  // mem layer not initialized yet, need system alloc
 #include "chpl-tasks.h"
 #include "chpltypes.h"
@@ -57,7 +59,10 @@ extern void chpl_memTracking_returnConfigVals(chpl_bool* memTrack,
                                               size_t* memMax,
                                               size_t* memThreshold,
                                               c_string* memLog,
-                                              c_string* memLeaksLog);
+                                              c_string* memLeaksLog,
+                                              size_t* memSampleRate,
+                                              size_t* memSampleInterval,
+                                              c_string* memSampleLog);
 
 chpl_bool chpl_memTrack = false;
 
@@ -77,10 +82,24 @@ static int hashSizes[NUM_HASH_SIZE_INDICES] = { 1543, 3079, 6151, 12289, 24593,
                                                 196613, 393241, 786433, 1572869, 3145739,
                                                 6291469, 12582917, 25165843, 50331653,
                                                 100663319, 201326611, 402653189, 805306457 };
-static int hashSizeIndex = 0;
-static int hashSize = 0;
 
-static memTableEntry** memTable = NULL;
+//
+// The table is split into shards by address, each a hash table with its
+// own lock, so that tasks allocating and freeing at the same time rarely
+// wait for each other.  The memory totals are kept in atomics.
+//
+#define LOG2_NUM_MEM_TABLE_SHARDS 6
+#define NUM_MEM_TABLE_SHARDS (1 << LOG2_NUM_MEM_TABLE_SHARDS)
+
+typedef struct memTableShard_struct {
+  chpl_sync_aux_t sync;
+  int hashSizeIndex;
+  int hashSize;
+  size_t numEntries;                /* number of entries in this shard */
+  memTableEntry** table;
+} memTableShard;
+
+static memTableShard memTableShards[NUM_MEM_TABLE_SHARDS];
 
 static _Bool memStats = false;
 static _Bool memLeaksByType = false;
@@ -91,18 +110,34 @@ static size_t memThreshold = 0;
 static c_string memLog = NULL;
 static FILE* memLogFile = NULL;
 static c_string memLeaksLog = NULL;
+static FILE* memSampleLogFile = NULL;
 
-static size_t totalMem = 0;       /* total memory currently allocated */
-static size_t maxMem = 0;         /* maximum total memory during run  */
-static size_t totalAllocated = 0; /* total memory allocated */
-static size_t totalFreed = 0;     /* total memory freed */
-static size_t totalEntries = 0;     /* number of entries in hash table */
+static atomic_uint_least64_t totalMem;       /* total memory currently allocated */
+static atomic_uint_least64_t maxMem;         /* maximum total memory during run  */
+static atomic_uint_least64_t totalAllocated; /* total memory allocated */
+static atomic_uint_least64_t totalFreed;     /* total memory freed */
 
-static chpl_sync_aux_t memTrack_sync;
+
+static FILE* openPerNodeLog(c_string name) {
+  FILE* f;
+
+  if (chpl_numNodes == 1) {
+    f = fopen(name, "w");
+  } else {
+    char* filename = (char*)sys_malloc((strlen(name)+10)*sizeof(char));
+    sprintf(filename, "%s.%" FORMAT_c_nodeid_t, name, chpl_nodeID);
+    f = fopen(filename, "w");
+    sys_free(filename);
+  }
+  return f;
+}
 
 
 void chpl_setMemFlags(void) {
   chpl_bool local_memTrack = false;
+  size_t memSampleRate = 0;
+  size_t memSampleInterval = 0;
+  c_string memSampleLog = NULL;
 
   //
   // Get the values of the memTracking config consts from the module.
@@ -127,7 +162,10 @@ void chpl_setMemFlags(void) {
                                     &memMax,
                                     &memThreshold,
                                     &memLog,
-                                    &memLeaksLog);
+                                    &memLeaksLog,
+                                    &memSampleRate,
+                                    &memSampleInterval,
+                                    &memSampleLog);
 
   if (local_memTrack
       || memStats
@@ -142,21 +180,38 @@ void chpl_setMemFlags(void) {
   if (!memLog) {
     memLogFile = stdout;
   } else {
-    if (chpl_numNodes == 1) {
-      memLogFile = fopen(memLog, "w");
-    } else {
-      char* filename = (char*)sys_malloc((strlen(memLog)+10)*sizeof(char));
-      sprintf(filename, "%s.%" FORMAT_c_nodeid_t, memLog, chpl_nodeID);
-      memLogFile = fopen(filename, "w");
-      sys_free(filename);
-    }
+    memLogFile = openPerNodeLog(memLog);
+  }
+
+  //
+  // Sampling doesn't turn on memory tracking.  Its profiles go to the
+  // memory log unless they have their own.
+  //
+  if (memSampleRate > 0) {
+    if (memSampleLog && strcmp(memSampleLog, ""))
+      memSampleLogFile = openPerNodeLog(memSampleLog);
+    if (!memSampleLogFile)
+      memSampleLogFile = memLogFile;
+    chpl_mem_sample_init(memSampleRate, memSampleInterval, memSampleLogFile);
   }
 
+  atomic_init_uint_least64_t(&totalMem, 0);
+  atomic_init_uint_least64_t(&maxMem, 0);
+  atomic_init_uint_least64_t(&totalAllocated, 0);
+  atomic_init_uint_least64_t(&totalFreed, 0);
+
   if (chpl_memTrack) {
-    chpl_sync_initAux(&memTrack_sync);
-    hashSizeIndex = 0;
-    hashSize = hashSizes[hashSizeIndex];
-    memTable = sys_calloc(hashSize, sizeof(memTableEntry*));
+    int i;
+
+    for (i = 0; i < NUM_MEM_TABLE_SHARDS; i++) {
+      memTableShard* shard = &memTableShards[i];
+
+      chpl_sync_initAux(&shard->sync);
+      shard->hashSizeIndex = 0;
+      shard->hashSize = hashSizes[shard->hashSizeIndex];
+      shard->numEntries = 0;
+      shard->table = sys_calloc(shard->hashSize, sizeof(memTableEntry*));
+    }
   }
 }
 
@@ -173,37 +228,71 @@ static unsigned hash(void* memAlloc, int hashSize) {
 }
 
 
+//
+// Allocations are at least 8-byte aligned, so the low bits of their
+// addresses say little.  Multiplying by a large odd constant mixes the
+// rest into the top bits, which pick the shard.
+//
+static memTableShard* getShard(void* memAlloc) {
+  uint64_t mixed = ((uint64_t)(uintptr_t)memAlloc >> 3) * 0x9E3779B97F4A7C15ULL;
+  return &memTableShards[mixed >> (64 - LOG2_NUM_MEM_TABLE_SHARDS)];
+}
+
+
+static void lockAllShards(void) {
+  int i;
+  for (i = 0; i < NUM_MEM_TABLE_SHARDS; i++)
+    chpl_sync_lock(&memTableShards[i].sync);
+}
+
+
+static void unlockAllShards(void) {
+  int i;
+  for (i = 0; i < NUM_MEM_TABLE_SHARDS; i++)
+    chpl_sync_unlock(&memTableShards[i].sync);
+}
+
+
 static void increaseMemStat(size_t chunk, int32_t lineno, int32_t filename) {
-  totalMem += chunk;
-  totalAllocated += chunk;
-  if (memMax && (totalMem > memMax)) {
+  uint_least64_t newTotal, oldMax;
+
+  newTotal = atomic_fetch_add_uint_least64_t(&totalMem, chunk) + chunk;
+  atomic_fetch_add_uint_least64_t(&totalAllocated, chunk);
+  if (memMax && (newTotal > memMax)) {
     chpl_error("Exceeded memory limit", lineno, filename);
   }
-  if (totalMem > maxMem)
-    maxMem = totalMem;
+
+  // Each total comes from one fetch_add, so the largest one seen here
+  // is the exact maximum.
+  oldMax = atomic_load_uint_least64_t(&maxMem);
+  while (newTotal > oldMax &&
+         !atomic_compare_exchange_weak_uint_least64_t(&maxMem, oldMax,
+                                                       newTotal)) {
+    oldMax = atomic_load_uint_least64_t(&maxMem);
+  }
 }
 
 
 static void decreaseMemStat(size_t chunk) {
-  totalMem -= chunk; // > totalMem ? 0 : totalMem - chunk;
-  totalFreed += chunk;
+  atomic_fetch_sub_uint_least64_t(&totalMem, chunk);
+  atomic_fetch_add_uint_least64_t(&totalFreed, chunk);
 }
 
 
 static void
-resizeTable(int direction) {
+resizeTable(memTableShard* shard, int direction) {
   memTableEntry** newMemTable = NULL;
   int newHashSizeIndex, newHashSize, newHashValue;
   int i;
   memTableEntry* me;
   memTableEntry* next;
 
-  newHashSizeIndex = hashSizeIndex + direction;
+  newHashSizeIndex = shard->hashSizeIndex + direction;
   newHashSize = hashSizes[newHashSizeIndex];
   newMemTable = sys_calloc(newHashSize, sizeof(memTableEntry*));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = next) {
+  for (i = 0; i < shard->hashSize; i++) {
+    for (me = shard->table[i]; me != NULL; me = next) {
       next = me->nextInBucket;
       newHashValue = hash(me->memAlloc, newHashSize);
       me->nextInBucket = newMemTable[newHashValue];
@@ -211,20 +300,23 @@ resizeTable(int direction) {
     }
   }
 
-  sys_free(memTable);
-  memTable = newMemTable;
-  hashSize = newHashSize;
-  hashSizeIndex = newHashSizeIndex;
+  sys_free(shard->table);
+  shard->table = newMemTable;
+  shard->hashSize = newHashSize;
+  shard->hashSizeIndex = newHashSizeIndex;
 }
 
-static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
+// The caller must hold the lock of the shard for memAlloc.
+static void addMemTableEntry(memTableShard* shard,
+                             void *memAlloc, size_t number, size_t size,
                              chpl_mem_descInt_t description, int32_t lineno,
                              int32_t filename) {
   unsigned hashValue;
   memTableEntry* memEntry;
 
-  if ((totalEntries+1)*2 > hashSize && hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
-    resizeTable(1);
+  if ((shard->numEntries+1)*2 > shard->hashSize &&
+      shard->hashSizeIndex < NUM_HASH_SIZE_INDICES-1)
+    resizeTable(shard, 1);
 
   memEntry = (memTableEntry*) sys_calloc(1, sizeof(memTableEntry));
   if (!memEntry) {
@@ -232,9 +324,9 @@ static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
                lineno, filename);
   }
 
-  hashValue = hash(memAlloc, hashSize);
-  memEntry->nextInBucket = memTable[hashValue];
-  memTable[hashValue] = memEntry;
+  hashValue = hash(memAlloc, shard->hashSize);
+  memEntry->nextInBucket = shard->table[hashValue];
+  shard->table[hashValue] = memEntry;
   memEntry->description = description;
   memEntry->memAlloc = memAlloc;
   memEntry->lineno = lineno;
@@ -242,23 +334,25 @@ static void addMemTableEntry(void *memAlloc, size_t number, size_t size,
   memEntry->number = number;
   memEntry->size = size;
   increaseMemStat(number*size, lineno, filename);
-  totalEntries += 1;
+  shard->numEntries += 1;
 }
 
 
-static memTableEntry* removeMemTableEntry(void* address) {
-  unsigned hashValue = hash(address, hashSize);
-  memTableEntry* thisBucketEntry = memTable[hashValue];
+// The caller must hold the lock of the shard for address.
+static memTableEntry* removeMemTableEntry(memTableShard* shard,
+                                          void* address) {
+  unsigned hashValue = hash(address, shard->hashSize);
+  memTableEntry* thisBucketEntry = shard->table[hashValue];
   memTableEntry* deletedBucket = NULL;
 
   if (!thisBucketEntry)
     return NULL;
 
   if (thisBucketEntry->memAlloc == address) {
-    memTable[hashValue] = thisBucketEntry->nextInBucket;
+    shard->table[hashValue] = thisBucketEntry->nextInBucket;
     deletedBucket = thisBucketEntry;
   } else {
-    for (thisBucketEntry = memTable[hashValue];
+    for (thisBucketEntry = shard->table[hashValue];
          thisBucketEntry != NULL;
          thisBucketEntry = thisBucketEntry->nextInBucket) {
 
@@ -272,9 +366,9 @@ static memTableEntry* removeMemTableEntry(void* address) {
   }
   if (deletedBucket) {
     decreaseMemStat(deletedBucket->number * deletedBucket->size);
-    totalEntries -= 1;
-    if (totalEntries*8 < hashSize && hashSizeIndex > 0)
-      resizeTable(-1);
+    shard->numEntries -= 1;
+    if (shard->numEntries*8 < shard->hashSize && shard->hashSizeIndex > 0)
+      resizeTable(shard, -1);
   }
   return deletedBucket;
 }
@@ -287,7 +381,7 @@ uint64_t chpl_memoryUsed(int32_t lineno, int32_t filename) {
     return 0;
   }
 
-  return (uint64_t)totalMem;
+  return (uint64_t)atomic_load_uint_least64_t(&totalMem);
 }
 
 
@@ -298,15 +392,18 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     return;
   }
 
-  chpl_sync_lock(&memTrack_sync);
   fprintf(memLogFile, "=================\n");
   fprintf(memLogFile, "Memory Statistics\n");
   if (chpl_numNodes == 1) {
     fprintf(memLogFile, "==============================================================\n");
-    fprintf(memLogFile, "Current Allocated Memory               %zd\n", totalMem);
-    fprintf(memLogFile, "Maximum Simultaneous Allocated Memory  %zd\n", maxMem);
-    fprintf(memLogFile, "Total Allocated Memory                 %zd\n", totalAllocated);
-    fprintf(memLogFile, "Total Freed Memory                     %zd\n", totalFreed);
+    fprintf(memLogFile, "Current Allocated Memory               %zd\n",
+            (size_t)atomic_load_uint_least64_t(&totalMem));
+    fprintf(memLogFile, "Maximum Simultaneous Allocated Memory  %zd\n",
+            (size_t)atomic_load_uint_least64_t(&maxMem));
+    fprintf(memLogFile, "Total Allocated Memory                 %zd\n",
+            (size_t)atomic_load_uint_least64_t(&totalAllocated));
+    fprintf(memLogFile, "Total Freed Memory                     %zd\n",
+            (size_t)atomic_load_uint_least64_t(&totalFreed));
     fprintf(memLogFile, "==============================================================\n");
   } else {
     int i;
@@ -318,16 +415,19 @@ void chpl_printMemAllocStats(int32_t lineno, int32_t filename) {
     fprintf(memLogFile, "                                            Total Freed Memory\n");
     fprintf(memLogFile, "==============================================================\n");
     for (i = 0; i < chpl_numNodes; i++) {
-      static size_t m1, m2, m3, m4;
-      chpl_gen_comm_get(&m1, i, &totalMem,       sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
-      chpl_gen_comm_get(&m2, i, &maxMem,         sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
-      chpl_gen_comm_get(&m3, i, &totalAllocated, sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
-      chpl_gen_comm_get(&m4, i, &totalFreed,     sizeof(size_t), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
-      fprintf(memLogFile, "%-9d  %-9zu  %-9zu  %-9zu  %-9zu\n", i, m1, m2, m3, m4);
+      static atomic_uint_least64_t m1, m2, m3, m4;
+      chpl_gen_comm_get(&m1, i, &totalMem,       sizeof(m1), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
+      chpl_gen_comm_get(&m2, i, &maxMem,         sizeof(m2), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
+      chpl_gen_comm_get(&m3, i, &totalAllocated, sizeof(m3), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
+      chpl_gen_comm_get(&m4, i, &totalFreed,     sizeof(m4), -1 /* broke for hetero */, CHPL_COMM_UNKNOWN_ID, lineno, filename);
+      fprintf(memLogFile, "%-9d  %-9zu  %-9zu  %-9zu  %-9zu\n", i,
+              (size_t)atomic_load_uint_least64_t(&m1),
+              (size_t)atomic_load_uint_least64_t(&m2),
+              (size_t)atomic_load_uint_least64_t(&m3),
+              (size_t)atomic_load_uint_least64_t(&m4));
     }
     fprintf(memLogFile, "==============================================================\n");
   }
-  chpl_sync_unlock(&memTrack_sync);
 }
 
 
@@ -341,7 +441,7 @@ static void printMemAllocsByType(_Bool forLeaks,
                                  int32_t lineno, int32_t filename) {
   size_t* table;
   memTableEntry* me;
-  int i;
+  int i, s;
   const int numberWidth   = 9;
   const int numEntries = CHPL_RT_MD_NUM+chpl_mem_numDescs;
 
@@ -354,13 +454,18 @@ static void printMemAllocsByType(_Bool forLeaks,
 
   table = (size_t*)sys_calloc(numEntries, 3*sizeof(size_t));
 
-  for (i = 0; i < hashSize; i++) {
-    for (me = memTable[i]; me != NULL; me = me->nextInBucket) {
-      table[3*me->description] += me->number*me->size;
-      table[3*me->description+1] += 1;
-      table[3*me->description+2] = me->description;
+  lockAllShards();
+  for (s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTableShards[s];
+    for (i = 0; i < shard->hashSize; i++) {
+      for (me = shard->table[i]; me != NULL; me = me->nextInBucket) {
+        table[3*me->description] += me->number*me->size;
+        table[3*me->description+1] += 1;
+        table[3*me->description+2] = me->description;
+      }
     }
   }
+  unlockAllShards();
 
   qsort(table, numEntries, 3*sizeof(size_t), memTableEntryCmp);
 
@@ -460,7 +565,7 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
 
   memTableEntry* memEntry;
   c_string memEntryFilename;
-  int n, i;
+  int n, i, s;
   char* loc;
   memTableEntry** table;
 
@@ -470,21 +575,28 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     return;
   }
 
+  // Hold every shard until the entries are printed, so that none are
+  // freed in the meantime
+  lockAllShards();
+
   n = 0;
   filenameWidth = strlen("Allocated Memory (Bytes)");
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      n += 1;
-      if (memEntry->filename) {
-        memEntryFilename = chpl_lookupFilename(memEntry->filename);
-        filenameLength = strlen(memEntryFilename);
-        if (filenameLength > filenameWidth)
-          filenameWidth = filenameLength;
+  for (s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTableShards[s];
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->table[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        n += 1;
+        if (memEntry->filename) {
+          memEntryFilename = chpl_lookupFilename(memEntry->filename);
+          filenameLength = strlen(memEntryFilename);
+          if (filenameLength > filenameWidth)
+            filenameWidth = filenameLength;
+        }
       }
     }
   }
@@ -509,14 +621,17 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
     chpl_error("out of memory printing memory table", lineno, filename);
 
   n = 0;
-  for (i = 0; i < hashSize; i++) {
-    for (memEntry = memTable[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
-      size_t chunk = memEntry->number * memEntry->size;
-      if (chunk < threshold)
-        continue;
-      if (description != -1 && memEntry->description != description)
-        continue;
-      table[n++] = memEntry;
+  for (s = 0; s < NUM_MEM_TABLE_SHARDS; s++) {
+    memTableShard* shard = &memTableShards[s];
+    for (i = 0; i < shard->hashSize; i++) {
+      for (memEntry = shard->table[i]; memEntry != NULL; memEntry = memEntry->nextInBucket) {
+        size_t chunk = memEntry->number * memEntry->size;
+        if (chunk < threshold)
+          continue;
+        if (description != -1 && memEntry->description != description)
+          continue;
+        table[n++] = memEntry;
+      }
     }
   }
   qsort(table, n, sizeof(memTableEntry*), descCmp);
@@ -544,6 +659,8 @@ printMemAllocs(chpl_mem_descInt_t description, int64_t threshold,
   fprintf(memLogFile, "\n");
   putchar('\n');
 
+  unlockAllShards();
+
   sys_free(table);
   sys_free(loc);
 }
@@ -566,6 +683,9 @@ void chpl_reportMemInfo() {
     fprintf(memLogFile, "\n");
     printMemAllocs(-1, memThreshold, 0, 0);
   }
+  chpl_mem_sample_report();
+  if (memSampleLogFile && memSampleLogFile != memLogFile)
+    fclose(memSampleLogFile);
   if (memLogFile && memLogFile != stdout)
     fclose(memLogFile);
   if (memLeaksLog && strcmp(memLeaksLog, "")) {
@@ -585,9 +705,11 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
                        int32_t lineno, int32_t filename) {
   if (number * size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      chpl_sync_lock(&memTrack_sync);
-      addMemTableEntry(memAlloc, number, size, description, lineno, filename);
-      chpl_sync_unlock(&memTrack_sync);
+      memTableShard* shard = getShard(memAlloc);
+      chpl_sync_lock(&shard->sync);
+      addMemTableEntry(shard, memAlloc, number, size, description,
+                       lineno, filename);
+      chpl_sync_unlock(&shard->sync);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
@@ -603,8 +725,9 @@ void chpl_track_malloc(void* memAlloc, size_t number, size_t size,
 void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
   if (chpl_memTrack) {
-    chpl_sync_lock(&memTrack_sync);
-    memEntry = removeMemTableEntry(memAlloc);
+    memTableShard* shard = getShard(memAlloc);
+    chpl_sync_lock(&shard->sync);
+    memEntry = removeMemTableEntry(shard, memAlloc);
     if (memEntry) {
       if (chpl_verbose_mem) {
         fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
@@ -615,7 +738,7 @@ void chpl_track_free(void* memAlloc, int32_t lineno, int32_t filename) {
       }
       sys_free(memEntry);
     }
-    chpl_sync_unlock(&memTrack_sync);
+    chpl_sync_unlock(&shard->sync);
   } else if (chpl_verbose_mem && !memEntry) {
     fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32 ": free at %p\n",
             chpl_nodeID, (filename ? chpl_lookupFilename(filename) : "--"),
@@ -629,14 +752,13 @@ void chpl_track_realloc_pre(void* memAlloc, size_t size,
                          int32_t lineno, int32_t filename) {
   memTableEntry* memEntry = NULL;
 
-  if (chpl_memTrack && size > memThreshold) {
-    chpl_sync_lock(&memTrack_sync);
-    if (memAlloc) {
-      memEntry = removeMemTableEntry(memAlloc);
-      if (memEntry)
-        sys_free(memEntry);
-    }
-    chpl_sync_unlock(&memTrack_sync);
+  if (chpl_memTrack && size > memThreshold && memAlloc) {
+    memTableShard* shard = getShard(memAlloc);
+    chpl_sync_lock(&shard->sync);
+    memEntry = removeMemTableEntry(shard, memAlloc);
+    if (memEntry)
+      sys_free(memEntry);
+    chpl_sync_unlock(&shard->sync);
   }
 }
 
@@ -647,9 +769,11 @@ void chpl_track_realloc_post(void* moreMemAlloc,
                          int32_t lineno, int32_t filename) {
   if (size > memThreshold) {
     if (chpl_memTrack && chpl_mem_descTrack(description)) {
-      chpl_sync_lock(&memTrack_sync);
-      addMemTableEntry(moreMemAlloc, 1, size, description, lineno, filename);
-      chpl_sync_unlock(&memTrack_sync);
+      memTableShard* shard = getShard(moreMemAlloc);
+      chpl_sync_lock(&shard->sync);
+      addMemTableEntry(shard, moreMemAlloc, 1, size, description,
+                       lineno, filename);
+      chpl_sync_unlock(&shard->sync);
     }
     if (chpl_verbose_mem) {
       fprintf(memLogFile, "%" FORMAT_c_nodeid_t ": %s:%" PRId32
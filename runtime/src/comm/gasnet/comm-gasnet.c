@@ -1342,7 +1342,6 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
     chpl_comm_do_callbacks (&cb_data);
   }
   
-  // the case (chpl_nodeID == srcnode) is internally managed inside gasnet
   if (chpl_verbose_comm && !chpl_comm_no_debug_private)
     printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, srcnode);
@@ -1352,6 +1351,14 @@ void  chpl_comm_get_strd(void* dstaddr, size_t* dststrides, c_nodeid_t srcnode_i
     chpl_sync_unlock(&chpl_comm_diagnostics_sync);
   }
 
+  // The transfer is still reported and counted above when it's local,
+  // as it always has been, but it's done with a plain strided copy.
+  if (chpl_nodeID == srcnode) {
+    chpl_comm_strd_local_copy(dstaddr, dststrides, srcaddr, srcstrides,
+                              count, stridelevels, elemSize);
+    return;
+  }
+
   // TODO -- handle strided get for non-registered memory
   gasnet_gets_bulk(dstaddr, dststr, srcnode, srcaddr, srcstr, cnt, strlvls); 
 }
@@ -1407,7 +1414,6 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
       chpl_comm_do_callbacks (&cb_data);
   }
 
-  // the case (chpl_nodeID == dstnode) is internally managed inside gasnet
   if (chpl_verbose_comm && !chpl_comm_no_debug_private)
     printf("%d: %s:%d: remote get from %d\n", chpl_nodeID,
            chpl_lookupFilename(fn), ln, dstnode);
@@ -1416,6 +1422,14 @@ void  chpl_comm_put_strd(void* dstaddr, size_t* dststrides, c_nodeid_t dstnode_i
     chpl_comm_commDiagnostics.put++;
     chpl_sync_unlock(&chpl_comm_diagnostics_sync);
   }
+
+  // As in chpl_comm_get_strd(), a local transfer is a plain copy.
+  if (chpl_nodeID == dstnode) {
+    chpl_comm_strd_local_copy(dstaddr, dststrides, srcaddr, srcstrides,
+                              count, stridelevels, elemSize);
+    return;
+  }
+
   // TODO -- handle strided put for non-registered memory
   gasnet_puts_bulk(dstnode, dstaddr, dststr, srcaddr, srcstr, cnt, strlvls); 
 }
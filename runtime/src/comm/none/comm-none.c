@@ -167,153 +167,10 @@ void  chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides, c_nodeid_t dstno
                          int32_t stridelevels, size_t elemSize, int32_t typeIndex,
                          int32_t commID, int ln, int32_t fn)
 {
-  const size_t strlvls = (size_t)stridelevels;
-  size_t i,j,k,l,m,t,total,off,x,carry;
-
-  int8_t* dstaddr,*dstaddr1,*dstaddr2,*dstaddr3;
-  int8_t* srcaddr,*srcaddr1,*srcaddr2,*srcaddr3;
-
-  int *srcdisp, *dstdisp;
-
-  size_t dststr[strlvls];
-  size_t srcstr[strlvls];
-  size_t cnt[strlvls+1];
-
   assert(dstnode==0);
 
-  //Only count[0] and strides are measured in number of bytes.
-  cnt[0] = count[0] * elemSize;
-  if (strlvls>0) {
-    srcstr[0] = srcstrides[0] * elemSize;
-    dststr[0] = dststrides[0] * elemSize;
-    for (i=1;i<strlvls;i++) {
-      srcstr[i] = srcstrides[i] * elemSize;
-      dststr[i] = dststrides[i] * elemSize;
-      cnt[i] = count[i];
-    }
-    cnt[strlvls] = count[strlvls];
-  }
-
-  switch(strlvls) {
-  case 0:
-    memmove(dstaddr_arg,srcaddr_arg,cnt[0]);
-    break;
-  case 1:
-    dstaddr = (int8_t*)dstaddr_arg;
-    srcaddr = (int8_t*)srcaddr_arg;
-    for (i=0; i<cnt[1]; i++) {
-      memmove((void*)dstaddr,(void*)srcaddr,cnt[0]);
-      srcaddr += srcstr[0];
-      dstaddr += dststr[0];
-    }
-    break;
-  case 2:
-    for (i=0; i<cnt[2]; i++) {
-      srcaddr = (int8_t*)srcaddr_arg + srcstr[1]*i;
-      dstaddr = (int8_t*)dstaddr_arg + dststr[1]*i;
-      for (j=0; j<cnt[1]; j++) {
-        memmove(dstaddr,srcaddr,cnt[0]);
-        srcaddr += srcstr[0];
-        dstaddr += dststr[0];
-      }
-    }
-    break;
-  case 3:
-    for (i=0; i<cnt[3]; i++) {
-      srcaddr1 = (int8_t*)srcaddr_arg + srcstr[2]*i;
-      dstaddr1 = (int8_t*)dstaddr_arg + dststr[2]*i;
-      for (j=0; j<cnt[2]; j++) {
-        srcaddr = srcaddr1 + srcstr[1]*j;
-        dstaddr = dstaddr1 + dststr[1]*j;
-        for (k=0; k<cnt[1]; k++) {
-          memmove(dstaddr,srcaddr,cnt[0]);
-          srcaddr += srcstr[0];
-          dstaddr += dststr[0];
-        }
-      }
-    }
-    break;
-    case 4:
-    for (i=0; i<cnt[4]; i++) {
-      srcaddr2 = (int8_t*)srcaddr_arg + srcstr[3]*i;
-      dstaddr2 = (int8_t*)dstaddr_arg + dststr[3]*i;
-      for (j=0; j<cnt[3]; j++) {
-        srcaddr1 = srcaddr2 + srcstr[2]*j;
-        dstaddr1 = dstaddr2 + dststr[2]*j;
-        for (k=0; k<cnt[2]; k++) {
-          srcaddr = srcaddr1 + srcstr[1]*k;
-          dstaddr = dstaddr1 + dststr[1]*k;
-          for (l=0; l<cnt[1]; l++) {
-            memmove(dstaddr,srcaddr,cnt[0]);
-            srcaddr += srcstr[0];
-            dstaddr += dststr[0];
-          }
-        }
-      }
-    }
-    break;
-  case 5:
-    for (i=0; i<cnt[5]; i++) {
-      srcaddr3 = (int8_t*)srcaddr_arg + srcstr[4]*i;
-      dstaddr3 = (int8_t*)dstaddr_arg + dststr[4]*i;
-      for (j=0; j<cnt[4]; j++) {
-        srcaddr2 = srcaddr3 + srcstr[3]*j;
-        dstaddr2 = dstaddr3 + dststr[3]*j;
-        for (k=0; k<cnt[3]; k++) {
-          srcaddr1 = srcaddr2 + srcstr[2]*k;
-          dstaddr1 = dstaddr2 + dststr[2]*k;
-          for (l=0; l<cnt[2]; l++) {
-            srcaddr = srcaddr1 + srcstr[1]*l;
-            dstaddr = dstaddr1 + dststr[1]*l;
-            for (m=0; m<cnt[1]; m++) {
-              memmove(dstaddr,srcaddr,cnt[0]);
-              srcaddr += srcstr[0];
-              dstaddr += dststr[0];
-            }
-          }
-        }
-      }
-    }
-    break;
-  default:
-    dstaddr = (int8_t*)dstaddr_arg;
-    srcaddr = (int8_t*)srcaddr_arg;
-
-    //Number of memmove operations to do
-    total = 1;
-    for (i=0; i<strlvls; i++)
-      total = total*cnt[i+1];
-
-    //displacement from the dstaddr and srcaddr start points
-    // We want these allocations to be locale-aware, since computing these stripes is 
-    // a kind of kernel code.
-    srcdisp = chpl_mem_allocManyZero(total,sizeof(int),CHPL_RT_MD_GETS_PUTS_STRIDES,0,0);
-    dstdisp = chpl_mem_allocManyZero(total,sizeof(int),CHPL_RT_MD_GETS_PUTS_STRIDES,0,0);
-
-    for (j=0; j<total; j++) {
-      carry = 1;
-      for (t=1;t<=strlvls;t++) {
-        if (cnt[t]*carry>=j+1) {  //IF 1
-          x = j/carry;
-          off = j-(carry*x);
-          if (carry!=1) {  //IF 2
-            srcdisp[j] = srcstr[t-1]*x+srcdisp[off];
-            dstdisp[j] = dststr[t-1]*x+dstdisp[off];
-          } else {  //ELSE 2
-            srcdisp[j] = srcstr[t-1]*x;
-            dstdisp[j] = dststr[t-1]*x;
-          }
-          memmove(dstaddr+dstdisp[j],srcaddr+srcdisp[j],cnt[0]);
-          break;
-        } else {  //ELSE 1
-          carry = carry*cnt[t];
-        }
-      }
-    }  // for j
-    chpl_mem_free(srcdisp,0,0);
-    chpl_mem_free(dstdisp,0,0);
-    break;
-  }
+  chpl_comm_strd_local_copy(dstaddr_arg, dststrides, srcaddr_arg, srcstrides,
+                            count, stridelevels, elemSize);
 }
 
 void  chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides, c_nodeid_t srcnode,
@@ -321,152 +178,10 @@ void  chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides, c_nodeid_t srcno
                          int32_t stridelevels, size_t elemSize, int32_t typeIndex,
                          int32_t commID, int ln, int32_t fn)
 {
-  const size_t strlvls = (size_t)stridelevels;
-  size_t i,j,k,l,m,t,total,off,x,carry;
-
-  int8_t* dstaddr,*dstaddr1,*dstaddr2,*dstaddr3;
-  int8_t* srcaddr,*srcaddr1,*srcaddr2,*srcaddr3;
-
-  int *srcdisp, *dstdisp;
-  size_t dststr[strlvls];
-  size_t srcstr[strlvls];
-  size_t cnt[strlvls+1];
-
   assert(srcnode==0);
 
-  //Only count[0] and strides are measured in number of bytes.
-  cnt[0] = count[0] * elemSize;
-  if (strlvls>0) {
-    srcstr[0] = srcstrides[0] * elemSize;
-    dststr[0] = dststrides[0] * elemSize;
-    for (i=1;i<strlvls;i++) {
-      srcstr[i] = srcstrides[i] * elemSize;
-      dststr[i] = dststrides[i] * elemSize;
-      cnt[i] = count[i];
-      }
-    cnt[strlvls] = count[strlvls];
-  }
-
-  switch(strlvls) {
-  case 0:
-    dstaddr = (int8_t*)dstaddr_arg;
-    srcaddr = (int8_t*)srcaddr_arg;
-    memmove(dstaddr,srcaddr,cnt[0]);
-    break;
-  case 1:
-    dstaddr = (int8_t*)dstaddr_arg;
-    srcaddr = (int8_t*)srcaddr_arg;
-    for (i=0; i<cnt[1]; i++) {
-      memmove(dstaddr,srcaddr,cnt[0]);
-      srcaddr += srcstr[0];
-      dstaddr += dststr[0];
-    }
-    break;
-  case 2:
-    for (i=0; i<cnt[2]; i++) {
-      srcaddr = (int8_t*)srcaddr_arg + srcstr[1]*i;
-      dstaddr = (int8_t*)dstaddr_arg + dststr[1]*i;
-      for (j=0; j<cnt[1]; j++) {
-        memmove(dstaddr,srcaddr,cnt[0]);
-        srcaddr += srcstr[0];
-        dstaddr += dststr[0];
-      }
-    }
-    break;
-  case 3:
-    for (i=0; i<cnt[3]; i++) {
-      srcaddr1 = (int8_t*)srcaddr_arg + srcstr[2]*i;
-      dstaddr1 = (int8_t*)dstaddr_arg + dststr[2]*i;
-      for (j=0; j<cnt[2]; j++) {
-        srcaddr = srcaddr1 + srcstr[1]*j;
-        dstaddr = dstaddr1 + dststr[1]*j;
-        for (k=0; k<cnt[1]; k++) {
-          memmove(dstaddr,srcaddr,cnt[0]);
-          srcaddr += srcstr[0];
-          dstaddr += dststr[0];
-        }
-      }
-    }
-    break;
-  case 4:
-    for (i=0; i<cnt[4]; i++) {
-      srcaddr2 = (int8_t*)srcaddr_arg + srcstr[3]*i;
-      dstaddr2 = (int8_t*)dstaddr_arg + dststr[3]*i;
-      for (j=0; j<cnt[3]; j++) {
-        srcaddr1 = srcaddr2 + srcstr[2]*j;
-        dstaddr1 = dstaddr2 + dststr[2]*j;
-        for (k=0; k<cnt[2]; k++) {
-          srcaddr = srcaddr1 + srcstr[1]*k;
-          dstaddr = dstaddr1 + dststr[1]*k;
-          for (l=0; l<cnt[1]; l++) {
-            memmove(dstaddr,srcaddr,cnt[0]);
-            srcaddr += srcstr[0];
-            dstaddr += dststr[0];
-          }
-        }
-      }
-    }
-    break;
-  case 5:
-    for (i=0; i<cnt[5]; i++) {
-      srcaddr3 = (int8_t*)srcaddr_arg + srcstr[4]*i;
-      dstaddr3 = (int8_t*)dstaddr_arg + dststr[4]*i;
-      for (j=0; j<cnt[4]; j++) {
-        srcaddr2 = srcaddr3 + srcstr[3]*j;
-        dstaddr2 = dstaddr3 + dststr[3]*j;
-        for (k=0; k<cnt[3]; k++) {
-          srcaddr1 = srcaddr2 + srcstr[2]*k;
-          dstaddr1 = dstaddr2 + dststr[2]*k;
-          for (l=0; l<cnt[2]; l++) {
-            srcaddr = srcaddr1 + srcstr[1]*l;
-            dstaddr = dstaddr1 + dststr[1]*l;
-            for (m=0; m<cnt[1]; m++) {
-              memmove(dstaddr,srcaddr,cnt[0]);
-              srcaddr += srcstr[0];
-              dstaddr += dststr[0];
-            }
-          }
-        }
-      }
-    }
-    break;
-  default:
-    dstaddr = (int8_t*)dstaddr_arg;
-    srcaddr = (int8_t*)srcaddr_arg;
-
-    //Number of memmove operations to do
-    total = 1;
-    for (i=0; i<strlvls; i++)
-      total = total*cnt[i+1];
-
-    //displacement from the dstaddr and srcaddr start points
-    srcdisp = chpl_mem_allocManyZero(total,sizeof(int),CHPL_RT_MD_GETS_PUTS_STRIDES,0,0);
-    dstdisp = chpl_mem_allocManyZero(total,sizeof(int),CHPL_RT_MD_GETS_PUTS_STRIDES,0,0);
-
-    for (j=0; j<total; j++) {
-      carry = 1;
-      for (t=1;t<=strlvls;t++) {
-        if (cnt[t]*carry>=j+1) {  //IF 1
-          x = j/carry;
-          off = j-(carry*x);
-          if (carry!=1) {  //IF 2
-            srcdisp[j] = srcstr[t-1]*x+srcdisp[off];
-            dstdisp[j] = dststr[t-1]*x+dstdisp[off];
-          } else {  //ELSE 2
-            srcdisp[j] = srcstr[t-1]*x;
-            dstdisp[j] = dststr[t-1]*x;
-          }
-          memmove(dstaddr+dstdisp[j],srcaddr+srcdisp[j],cnt[0]);
-          break;
-        } else {  //ELSE 1
-          carry = carry*cnt[t];
-        }
-      }
-    }  // for j
-    chpl_mem_free(srcdisp,0,0);
-    chpl_mem_free(dstdisp,0,0);
-    break;
-  }
+  chpl_comm_strd_local_copy(dstaddr_arg, dststrides, srcaddr_arg, srcstrides,
+                            count, stridelevels, elemSize);
 }
 
 typedef struct {
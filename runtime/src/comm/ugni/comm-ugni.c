@@ -4162,6 +4162,16 @@ void  chpl_comm_put_strd(void* dstaddr_arg, size_t* dststrides,
       chpl_comm_do_callbacks (&cb_data);
   }
 
+  // A local transfer is a plain strided copy.  As before, it still
+  // counts in the stats and is seen by the callbacks, but as each run
+  // would have been a local chpl_comm_put(), not in the diagnostics.
+  if (dstlocale == chpl_nodeID) {
+    chpl_comm_strd_local_copy(dstaddr_arg, dststrides,
+                              srcaddr_arg, srcstrides,
+                              count, stridelevels, elemSize);
+    return;
+  }
+
   //Only count[0] and strides are measured in number of bytes.
   cnt[0]= count[0] * elemSize;
   if (strlvls>0) {
@@ -4317,6 +4327,14 @@ void  chpl_comm_get_strd(void* dstaddr_arg, size_t* dststrides,
     chpl_comm_do_callbacks (&cb_data);
   }
 
+  // As in chpl_comm_put_strd(), a local transfer is a plain copy.
+  if (srclocale == chpl_nodeID) {
+    chpl_comm_strd_local_copy(dstaddr_arg, dststrides,
+                              srcaddr_arg, srcstrides,
+                              count, stridelevels, elemSize);
+    return;
+  }
+
   //Only count[0] and strides are measured in number of bytes.
   cnt[0]=count[0] * elemSize;
   if(strlvls>0){
@@ -29,6 +29,8 @@
 #include "chpl-mem.h"
 #include "chplmemtrack.h"
 #include "chplsys.h"
+#include "chpl-tasks.h"
+#include "chpl-thread-local-storage.h"
 #include "chpl-topo.h"
 #include "chpltypes.h"
 #include "error.h"
@@ -59,6 +61,32 @@ typedef struct shared_heap {
 
 static shared_heap_t* heaps;
 
+//
+// NUMA arenas.  With a locale model that has sublocales we create an
+// extra arena for each NUMA domain, and allocations made by a task
+// that is running on a sublocale come from the arena for that domain
+// (see chpl_je_numa_alloc()).  The chunks for these arenas either come
+// out of that domain's part of the localized shared heap, or, when
+// there is no shared heap, from jemalloc's own chunk allocator after
+// which we bind their pages to the domain.
+//
+unsigned chpl_je_numa_num_arenas = 0;
+static unsigned numa_first_arena;
+
+//
+// Each thread has its own explicit tcache for each NUMA arena, so that
+// small allocations made on a sublocale still come out of a thread
+// cache instead of taking the arena's lock.  A tcache hands back
+// whatever it has cached, whichever arena that came from, so each one
+// only serves one arena.  A thread's tcaches are created the first
+// time it allocates on each sublocale and destroyed when it exits.
+// The entries hold the tcache index plus 1, so that 0 means none yet.
+//
+#ifdef USE_JE_CHUNK_HOOKS
+static pthread_key_t numa_tcaches_key;
+static CHPL_TLS_DECL(unsigned*, numa_tcaches);
+#endif
+
 static int get_num_heaps(void) {
   static int num_heaps = -1;
 
@@ -99,6 +127,16 @@ static inline int get_nearby_heap(void) {
   }
 }
 
+// the heap a given arena gets its chunks from
+static inline int get_arena_heap(unsigned arena_ind) {
+  if (chpl_je_numa_num_arenas > 0
+      && arena_ind >= numa_first_arena
+      && arena_ind - numa_first_arena < (unsigned) get_num_heaps()) {
+    return arena_ind - numa_first_arena;
+  }
+  return get_nearby_heap();
+}
+
 
 // helper routine to initialize the table of heaps
 static void setupLocalizedHeaps(void* heap_base, size_t heap_size) {
@@ -182,7 +220,7 @@ static void* chunk_alloc(void *chunk, size_t size, size_t alignment, bool *zero,
   size_t cur_heap_size;
 
   // which heap?
-  hpi = get_nearby_heap();
+  hpi = get_arena_heap(arena_ind);
 
   // this function can be called concurrently and it looks like jemalloc
   // doesn't call it inside a lock, so we need to protect it ourselves
@@ -251,6 +289,25 @@ static bool null_merge(void *chunk_a, size_t size_a, void *chunk_b, size_t size_
   return true;
 }
 
+//
+// The chunk allocation hook for NUMA arenas when there is no shared
+// heap: get the chunk the way jemalloc would have, then bind it to the
+// arena's NUMA domain.  The other hooks are jemalloc's defaults.
+//
+static chunk_hooks_t numa_default_hooks;
+
+static void* numa_chunk_alloc(void *chunk, size_t size, size_t alignment, bool *zero, bool *commit, unsigned arena_ind) {
+  void* p;
+
+  p = numa_default_hooks.alloc(chunk, size, alignment, zero, commit,
+                               arena_ind);
+  if (p != NULL) {
+    chpl_topo_setMemLocality(p, size, true,
+                             (c_sublocid_t) (arena_ind - numa_first_arena));
+  }
+  return p;
+}
+
 #endif // ifdef USE_JE_CHUNK_HOOKS
 
 // *** End chunk hook replacements *** //
@@ -305,15 +362,9 @@ static void initialize_arenas(void) {
 }
 
 
-// replace the chunk hooks for each arena with the hooks we provided above
-static void replaceChunkHooks(void) {
-
-// we can't use chunk hooks for older versions of jemalloc
 #ifdef USE_JE_CHUNK_HOOKS
-
-  unsigned narenas;
-  unsigned arena;
-
+// have one arena use the hooks we provided above
+static void setSharedHeapChunkHooks(unsigned arena) {
   // set the pointers for the new_hooks to our above functions
   chunk_hooks_t new_hooks = {
     chunk_alloc,
@@ -324,15 +375,28 @@ static void replaceChunkHooks(void) {
     null_split,
     null_merge
   };
+  char path[128];
+
+  snprintf(path, sizeof(path), "arena.%u.chunk_hooks", arena);
+  if (CHPL_JE_MALLCTL(path, NULL, NULL, &new_hooks, sizeof(chunk_hooks_t)) != 0) {
+    chpl_internal_error("could not update the chunk hooks");
+  }
+}
+#endif
+
+// replace the chunk hooks for each arena with the hooks we provided above
+static void replaceChunkHooks(void) {
+
+// we can't use chunk hooks for older versions of jemalloc
+#ifdef USE_JE_CHUNK_HOOKS
+
+  unsigned narenas;
+  unsigned arena;
 
   // for each arena, change the chunk hooks
   narenas = get_num_arenas();
   for (arena=0; arena<narenas; arena++) {
-    char path[128];
-    snprintf(path, sizeof(path), "arena.%u.chunk_hooks", arena);
-    if (CHPL_JE_MALLCTL(path, NULL, NULL, &new_hooks, sizeof(chunk_hooks_t)) != 0) {
-      chpl_internal_error("could not update the chunk hooks");
-    }
+    setSharedHeapChunkHooks(arena);
   }
 #else
     chpl_internal_error("cannot init multi-locale heap: please rebuild with jemalloc >= 4.1");
@@ -441,6 +505,140 @@ static void initializeSharedHeap(void* heap_base, size_t heap_size) {
 }
 
 
+#ifdef USE_JE_CHUNK_HOOKS
+static void destroyNumaTcaches(void* p) {
+  unsigned* tcaches = (unsigned*) p;
+  unsigned i;
+
+  for (i = 0; i < chpl_je_numa_num_arenas; i++) {
+    if (tcaches[i] != 0) {
+      unsigned tcache = tcaches[i] - 1;
+      (void) CHPL_JE_MALLCTL("tcache.destroy", NULL, NULL,
+                             &tcache, sizeof(tcache));
+    }
+  }
+  CHPL_JE_FREE(tcaches);
+}
+
+
+// the mallocx() flags for an allocation from a sublocale's arena
+static int getNumaFlags(c_sublocid_t subloc) {
+  unsigned* tcaches = CHPL_TLS_GET(numa_tcaches);
+  const int arena_flags = MALLOCX_ARENA(numa_first_arena + subloc);
+
+  if (tcaches == NULL) {
+    tcaches = (unsigned*) CHPL_JE_CALLOC(chpl_je_numa_num_arenas,
+                                         sizeof(unsigned));
+    if (tcaches == NULL) {
+      return arena_flags | MALLOCX_TCACHE_NONE;
+    }
+    CHPL_TLS_SET(numa_tcaches, tcaches);
+    (void) pthread_setspecific(numa_tcaches_key, tcaches);
+  }
+
+  if (tcaches[subloc] == 0) {
+    unsigned tcache;
+    size_t sz = sizeof(tcache);
+
+    if (CHPL_JE_MALLCTL("tcache.create", &tcache, &sz, NULL, 0) != 0) {
+      return arena_flags | MALLOCX_TCACHE_NONE;
+    }
+    tcaches[subloc] = tcache + 1;
+  }
+
+  return arena_flags | MALLOCX_TCACHE(tcaches[subloc] - 1);
+}
+#endif
+
+
+// Create the NUMA arenas, if we want them.  Any shared heap must have
+// been set up already.
+static void setupNumaArenas(void* heap_base) {
+#ifdef USE_JE_CHUNK_HOOKS
+  const int num_domains = chpl_topo_getNumNumaDomains();
+  unsigned i;
+
+  if (strcmp(CHPL_LOCALE_MODEL, "flat") == 0 || num_domains <= 1) {
+    return;
+  }
+
+  // With a shared heap that isn't localized there is nowhere to get
+  // NUMA-local chunks from.
+  if (heap_base != NULL && get_num_heaps() < num_domains) {
+    return;
+  }
+
+  for (i = 0; i < (unsigned) num_domains; i++) {
+    unsigned arena;
+    size_t sz = sizeof(arena);
+
+    if (CHPL_JE_MALLCTL("arenas.extend", &arena, &sz, NULL, 0) != 0) {
+      chpl_internal_error("could not create a NUMA arena");
+    }
+    if (i == 0) {
+      numa_first_arena = arena;
+    } else if (arena != numa_first_arena + i) {
+      chpl_internal_error("NUMA arenas are not consecutive");
+    }
+
+    // set the hooks before anything is allocated from the new arena
+    if (heap_base != NULL) {
+      setSharedHeapChunkHooks(arena);
+    } else {
+      chunk_hooks_t new_hooks;
+      size_t hooks_sz = sizeof(chunk_hooks_t);
+      char path[128];
+
+      snprintf(path, sizeof(path), "arena.%u.chunk_hooks", arena);
+      if (CHPL_JE_MALLCTL(path, &numa_default_hooks, &hooks_sz,
+                          NULL, 0) != 0) {
+        chpl_internal_error("could not get the chunk hooks");
+      }
+      new_hooks = numa_default_hooks;
+      new_hooks.alloc = numa_chunk_alloc;
+      if (CHPL_JE_MALLCTL(path, NULL, NULL,
+                          &new_hooks, sizeof(chunk_hooks_t)) != 0) {
+        chpl_internal_error("could not update the chunk hooks");
+      }
+    }
+  }
+
+  CHPL_TLS_INIT(numa_tcaches);
+  if (pthread_key_create(&numa_tcaches_key, destroyNumaTcaches) != 0) {
+    chpl_internal_error("could not create the NUMA tcache key");
+  }
+
+  chpl_je_numa_num_arenas = num_domains;
+#endif
+}
+
+
+void* chpl_je_numa_alloc(size_t size, int flags) {
+#ifdef USE_JE_CHUNK_HOOKS
+  c_sublocid_t subloc = chpl_task_getRequestedSubloc();
+
+  if (isActualSublocID(subloc)
+      && (unsigned) subloc < chpl_je_numa_num_arenas) {
+    flags |= getNumaFlags(subloc);
+  }
+#endif
+  return CHPL_JE_MALLOCX(size, flags);
+}
+
+
+void* chpl_je_numa_realloc(void* ptr, size_t size) {
+#ifdef USE_JE_CHUNK_HOOKS
+  c_sublocid_t subloc = chpl_task_getRequestedSubloc();
+
+  if (isActualSublocID(subloc)
+      && (unsigned) subloc < chpl_je_numa_num_arenas) {
+    return CHPL_JE_RALLOCX(ptr, size, getNumaFlags(subloc));
+  }
+#endif
+  return CHPL_JE_REALLOC(ptr, size);
+}
+
+
 void chpl_mem_layerInit(void) {
   void* heap_base;
   size_t heap_size;
@@ -465,6 +663,8 @@ void chpl_mem_layerInit(void) {
     }
     CHPL_JE_FREE(p);
   }
+
+  setupNumaArenas(heap_base);
 }
 
 
@@ -37,6 +37,7 @@
 
 #include "qio.h"
 #include "qbuffer.h"
+#include "qio_uring.h"
 
 #include "error.h"
 
@@ -590,6 +591,16 @@ qio_hint_t choose_io_method(qio_file_t* file, qio_hint_t hints, qio_hint_t defau
     }
   }
 
+  // io_uring reads and writes at an offset, so it needs a seekable
+  // file descriptor and a kernel that supports it.
+  if( method == QIO_METHOD_URING ) {
+    if( file->fd == -1 || !(fdflags & QIO_FDFLAG_SEEKABLE) ) {
+      method = QIO_METHOD_READWRITE;
+    } else if( !qio_uring_available() ) {
+      method = QIO_METHOD_PREADPWRITE;
+    }
+  }
+
   // Always use fread/fwrite with FILE*
   //if( file->fp ) method = QIO_METHOD_FREADFWRITE;
   // we get FILE* from tmpfile() and want to be able to mmap...
@@ -1873,6 +1884,13 @@ qioerr _qio_channel_final_flush_unlocked(qio_channel_t* ch)
     }
   }
 
+  // Wait for any read-ahead and write-behind still in flight.
+  if( ch->uring ) {
+    qioerr uring_err = qio_uring_destroy(ch->uring);
+    ch->uring = NULL;
+    if( !err ) err = uring_err;
+  }
+
   // Make a note of any error from flush/truncate so we don't forget it
   flush_or_truncate_error = err;
 
@@ -2280,6 +2298,82 @@ qioerr _buffered_get_mmap(qio_channel_t* ch, int64_t amt_in, int writing)
   else return 0;
 }
 
+// Reads at least amt bytes with io_uring, and keeps reads for
+// qio_uring_readahead_iobufs more iobufs in flight so that the next
+// call can usually use data that has already arrived.
+//
+// The reads in flight are always for the buffer space right after
+// av_end, in order. Each one reads a part of the buffer at the file
+// offset matching its position in the buffer.
+static
+qioerr _buffered_read_atleast_uring(qio_channel_t* ch, int64_t amt, int64_t max_amt)
+{
+  int64_t need_end = ch->av_end + amt;
+  int64_t ahead = amt + qio_uring_readahead_iobufs * qbytes_iobuf_size;
+  int64_t buf_end;
+  int64_t read_offset;
+  ssize_t num_read;
+  qbuffer_iter_t iter;
+  qbuffer_iter_t end;
+  qbytes_t* bytes;
+  int64_t skip;
+  int64_t len;
+  qioerr err = 0;
+
+  if( ! ch->uring ) {
+    err = qio_uring_create(&ch->uring, ch->file->fd);
+    if( err ) return err;
+  }
+
+  if( ahead > max_amt ) ahead = max_amt;
+
+  while( ch->av_end < need_end ) {
+    // Make buffer space for the read-ahead, in whole iobufs
+    buf_end = qbuffer_end_offset(&ch->buf);
+    if( buf_end < ch->av_end + ahead ) {
+      err = _buffered_allocate_bufferspace(ch, ch->av_end + ahead - buf_end,
+                                           max_amt - (buf_end - ch->av_end));
+      if( err ) return err;
+    }
+
+    // Queue reads for the buffer space that has none yet
+    read_offset = ch->av_end;
+    if( qio_uring_num_reads(ch->uring) > 0 ) {
+      read_offset = qio_uring_reads_end(ch->uring);
+    }
+
+    iter = qbuffer_iter_at(&ch->buf, read_offset);
+    end = qbuffer_end(&ch->buf);
+    while( iter.offset < end.offset && qio_uring_can_submit(ch->uring) ) {
+      qbuffer_iter_get(iter, end, &bytes, &skip, &len);
+      err = qio_uring_queue_read(ch->uring, bytes,
+                                 qio_ptr_add(bytes->data, skip), len,
+                                 iter.offset);
+      if( err ) break;
+      qbuffer_iter_advance(&ch->buf, &iter, len);
+    }
+
+    if( !err ) err = qio_uring_submit(ch->uring);
+
+    // Wait for the reads, oldest first, until there is enough data.
+    while( !err && ch->av_end < need_end &&
+           qio_uring_num_reads(ch->uring) > 0 ) {
+      err = qio_uring_wait_read(ch->uring, &read_offset, &num_read);
+      assert( read_offset == ch->av_end );
+      ch->av_end += num_read;
+    }
+
+    if( err ) {
+      // At end of file or after an error, the later reads are not
+      // contiguous with the data read so far.
+      qio_uring_cancel_reads(ch->uring);
+      return err;
+    }
+  }
+
+  return 0;
+}
+
 // Runs read or pread, whichever is appropriate,
 // to read into the buffer.
 static
@@ -2309,6 +2403,13 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
     return_eof = 1;
   }
 
+  if( method == QIO_METHOD_URING && !(ch->flags & QIO_FDFLAG_WRITEABLE) ) {
+    err = _buffered_read_atleast_uring(ch, amt, max_amt);
+    if( err ) return err;
+    if( return_eof ) return QIO_EEOF;
+    else return 0;
+  }
+
   //printf("Allocating bufferspace %lli\n", (long long int) amt);
   err = _buffered_allocate_bufferspace(ch, amt, max_amt);
   if( err ) return err;
@@ -2330,6 +2431,7 @@ qioerr _buffered_read_atleast(qio_channel_t* ch, int64_t amt)
         err = qio_readv(ch->file, &ch->buf, read_start, read_end, &num_read);
         break;
       case QIO_METHOD_PREADPWRITE:
+      case QIO_METHOD_URING: // when the channel also writes
         err = qio_preadv(ch->file, &ch->buf, read_start, read_end, read_start.offset, &num_read);
         break;
       case QIO_METHOD_FREADFWRITE:
@@ -2495,6 +2597,33 @@ void _qio_buffered_setup_cached(qio_channel_t* ch)
 }
 
 
+// Queues an io_uring write of the part of the buffer at write_start.
+// The write completes later, so *num_queued counts the bytes queued.
+static
+qioerr _qio_uring_write_part(qio_channel_t* ch, qbuffer_iter_t write_start, qbuffer_iter_t write_end, ssize_t* num_queued)
+{
+  qbytes_t* bytes;
+  int64_t skip;
+  int64_t len;
+  qioerr err;
+
+  *num_queued = 0;
+
+  if( ! ch->uring ) {
+    err = qio_uring_create(&ch->uring, ch->file->fd);
+    if( err ) return err;
+  }
+
+  qbuffer_iter_get(write_start, write_end, &bytes, &skip, &len);
+
+  err = qio_uring_queue_write(ch->uring, bytes, qio_ptr_add(bytes->data, skip),
+                              len, write_start.offset);
+  if( err ) return err;
+
+  *num_queued = len;
+  return 0;
+}
+
 // Writes chunks that are complete. If flushall is set,
 // also writes an incomplete portion of a chunk.
 //
@@ -2540,6 +2669,10 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
   // to update the iterators. This is the common case.
   if( qbuffer_iter_num_bytes(write_start, write_end) == 0 ) {
     err = 0;
+    // Earlier writes might still be in flight
+    if( flushall && ch->uring ) {
+      err = qio_uring_finish_writes(ch->uring, 0);
+    }
     goto done;
   }
 
@@ -2565,6 +2698,9 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
         case QIO_METHOD_FREADFWRITE:
           err = qio_fwritev(ch->file->fp, &ch->buf, write_start, write_end, &num_written);
           break;
+        case QIO_METHOD_URING:
+          err = _qio_uring_write_part(ch, write_start, write_end, &num_written);
+          break;
         case QIO_METHOD_MMAP:
         case QIO_METHOD_MEMORY:
           // do nothing; mmap already puts data.
@@ -2587,6 +2723,15 @@ qioerr _qio_buffered_behind(qio_channel_t* ch, int flushall)
     write_start = write_end;
   }
 
+  if( ch->uring ) {
+    // Start the queued writes. The buffer can be trimmed right away
+    // since they hold references to its bytes. Only wait for them
+    // when flushing.
+    err = qio_uring_submit(ch->uring);
+    if( !err ) err = qio_uring_finish_writes(ch->uring, flushall ? 0 : INT_MAX);
+    if( err ) goto error;
+  }
+
   err = 0;
 
 error:
@@ -2787,6 +2932,7 @@ qioerr _qio_unbuffered_write(qio_channel_t* ch, const void* ptr, ssize_t len_in,
         case QIO_METHOD_MMAP: // mmap uses pread/pwrite when we're 
                               // outside the mmap'd region.
         case QIO_METHOD_PREADPWRITE:
+        case QIO_METHOD_URING: // only buffered I/O is asynchronous
           err = qio_int_to_err(sys_pwrite(ch->file->fd, ptr, len, _right_mark_start(ch), &num_written));
           break;
         case QIO_METHOD_FREADFWRITE:
@@ -2877,6 +3023,7 @@ qioerr _qio_unbuffered_read(qio_channel_t* ch, void* ptr, ssize_t len_in, ssize_
           break;
         case QIO_METHOD_MMAP:
         case QIO_METHOD_PREADPWRITE:
+        case QIO_METHOD_URING:
           err = qio_int_to_err(sys_pread(ch->file->fd, ptr, len, _right_mark_start(ch), &num_read));
           break;
         case QIO_METHOD_FREADFWRITE:
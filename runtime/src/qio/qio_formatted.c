@@ -18,6 +18,14 @@
  */
 
 
+// After the feature macros in sys_basic.h, but before the runtime
+// headers, whose malloc and free macros would break the mm_malloc.h
+// it includes
+#include "sys_basic.h"
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
 #ifndef CHPL_RT_UNIT_TEST
 #include "chplrt.h"
 #endif
@@ -65,6 +73,66 @@ static int wcwidth(int wc) {
 }
 #endif
 
+/* Fast paths for scanning text.
+ *
+ * When the bytes being scanned are already contiguous in the channel's
+ * cached buffer (between cached_cur and cached_end), the scanning
+ * functions below look at them directly instead of reading one
+ * character at a time with mark/revert. They only handle the common
+ * cases; anything else (data that continues past the cached buffer,
+ * non-ASCII characters, errors) is left to the general code, so the
+ * results and errors are the same either way.
+ */
+
+// Returns true if every ASCII byte is a character by itself in the
+// channel's encoding, so that ASCII whitespace and digits can be
+// recognized byte by byte.
+static inline
+int _qio_ascii_bytes_are_chars(void)
+{
+  return qio_glocale_utf8 == QIO_GLOCALE_UTF8 ||
+         qio_glocale_utf8 == QIO_GLOCALE_ASCII;
+}
+
+// Returns the number of ASCII decimal digits at the start of p..end-1.
+// Uses SSE2 to check 16 bytes at a time when it is available.
+static inline
+size_t _qio_count_digits(const uint8_t* restrict p, const uint8_t* restrict end)
+{
+  const uint8_t* start = p;
+
+#ifdef __SSE2__
+  {
+    const __m128i zero = _mm_set1_epi8('0');
+    const __m128i nine = _mm_set1_epi8(9);
+
+    while( end - p >= 16 ) {
+      __m128i v = _mm_loadu_si128((const __m128i*) p);
+      // A byte is a digit if byte - '0', as an unsigned byte, is <= 9
+      __m128i d = _mm_sub_epi8(v, zero);
+      __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(d, nine), d);
+      int mask = _mm_movemask_epi8(is_digit);
+      if( mask != 0xffff ) {
+        return (p - start) + __builtin_ctz(~mask);
+      }
+      p += 16;
+    }
+  }
+#endif
+
+  while( p < end && *p >= '0' && *p <= '9' ) p++;
+
+  return p - start;
+}
+
+// Skips ASCII whitespace, returning the first other byte or end.
+static inline
+const uint8_t* _qio_skip_ascii_space(const uint8_t* restrict p, const uint8_t* restrict end)
+{
+  while( p < end && (*p == ' ' || (*p >= '\t' && *p <= '\r')) ) p++;
+  return p;
+}
+
 qioerr qio_channel_read_uvarint(const int threadsafe, qio_channel_t* restrict ch, uint64_t* restrict ptr) {
   qioerr err = 0;
   uint8_t byte;
@@ -165,6 +233,18 @@ qioerr _peek_until_byte(qio_channel_t* restrict ch, uint8_t term_byte, int64_t*
   uint8_t byte = 0;
   int found_term;
 
+  // If the terminator is in the cached buffer, memchr finds it (with
+  // SIMD in most C libraries) without reading byte by byte.
+  if( qio_space_in_ptr_diff(1, ch->cached_end, ch->cached_cur) ) {
+    void* found = memchr(ch->cached_cur, term_byte,
+                         qio_ptr_diff(ch->cached_end, ch->cached_cur));
+    if( found ) {
+      *amt_read_out = qio_ptr_diff(found, ch->cached_cur);
+      *found_term_out = 1;
+      return 0;
+    }
+  }
+
   mark_offset = qio_channel_offset_unlocked(ch);
 
   err = qio_channel_mark(false, ch);
@@ -462,6 +542,63 @@ unlock:
   return err;
 }
 
+// Returns true if every byte in p..end-1 is ASCII.
+static inline
+int _qio_bytes_are_ascii(const uint8_t* restrict p, const uint8_t* restrict end)
+{
+#ifdef __SSE2__
+  while( end - p >= 16 ) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    if( _mm_movemask_epi8(v) ) return 0;
+    p += 16;
+  }
+#endif
+
+  while( p < end ) {
+    if( *p & 0x80 ) return 0;
+    p++;
+  }
+
+  return 1;
+}
+
+// Reads an ASCII line ending with term_chr from the cached buffer into
+// the string being built by qio_channel_scan_string. Returns 0 without
+// reading anything if the general code has to handle it.
+static
+int _scan_line_cached(qio_channel_t* restrict ch, int32_t term_chr, ssize_t maxlen_chars, ssize_t maxlen_bytes, char* restrict * restrict buf, size_t* restrict buf_len, size_t* restrict buf_max)
+{
+  const uint8_t* p = (const uint8_t*) ch->cached_cur;
+  const uint8_t* end = (const uint8_t*) ch->cached_end;
+  const uint8_t* found;
+  size_t len;
+  char* newbuf;
+
+  if( ! p || term_chr < 0 || term_chr >= 0x80 ) return 0;
+  if( ! _qio_ascii_bytes_are_chars() ) return 0;
+
+  found = memchr(p, term_chr, end - p);
+  if( ! found ) return 0;
+
+  // The line includes the terminator
+  len = found - p + 1;
+  if( (ssize_t) len > maxlen_chars || (ssize_t) len > maxlen_bytes ) return 0;
+  if( ! _qio_bytes_are_ascii(p, found) ) return 0;
+
+  if( *buf_len + len + 1 > *buf_max ) {
+    newbuf = qio_realloc(*buf, *buf_len + len + 1);
+    if( ! newbuf ) return 0;
+    *buf = newbuf;
+    *buf_max = *buf_len + len + 1;
+  }
+
+  qio_memcpy(*buf + *buf_len, p, len);
+  *buf_len += len;
+
+  ch->cached_cur = (void*) (found + 1);
+  return 1;
+}
+
 // allocates and returns a string.
 qioerr qio_channel_scan_string(const int threadsafe, qio_channel_t* restrict ch, const char* restrict * restrict out, int64_t* restrict len_out, ssize_t maxlen_bytes)
 {
@@ -558,6 +695,14 @@ qioerr qio_channel_scan_string(const int threadsafe, qio_channel_t* restrict ch,
   }
 
   err = 0;
+
+  if( style->string_format == QIO_STRING_FORMAT_TOEND &&
+      _scan_line_cached(ch, term_chr, maxlen_chars, maxlen_bytes,
+                        &ret, &ret_len, &ret_max) ) {
+    found_term = 1;
+    goto done;
+  }
+
   for( nread = 0;
       // limit # characters
       nread < maxlen_chars &&
@@ -720,6 +865,7 @@ qioerr qio_channel_scan_string(const int threadsafe, qio_channel_t* restrict ch,
     }
   }
 
+done:
   // Add the NULL... space for this is allocated in _append_char.
   ret[ret_len] = '\0';
 
@@ -2105,6 +2251,53 @@ error:
   return err;
 }
 
+// Scan a decimal integer that is entirely within the cached buffer,
+// for qio_channel_scan_int. Returns false, without consuming anything,
+// if _peek_number_unlocked should scan it instead.
+static
+int _scan_int_cached(qio_channel_t* restrict ch, number_reading_state_t* restrict st, unsigned long long int* restrict num_out, int* restrict sign_out)
+{
+  const uint8_t* p = (const uint8_t*) ch->cached_cur;
+  const uint8_t* end = (const uint8_t*) ch->cached_end;
+  unsigned long long int num = 0;
+  int sign = 0;
+  size_t ndigits;
+  size_t i;
+
+  if( ! p || ! _qio_ascii_bytes_are_chars() ) return 0;
+  if( st->base != 0 && st->base != 10 ) return 0;
+  if( st->allow_point ) return 0;
+
+  p = _qio_skip_ascii_space(p, end);
+  if( p == end ) return 0;
+
+  if( st->allow_pos_sign && tolower(*p) == st->positive_char ) {
+    sign = 1;
+    p++;
+  } else if( st->allow_neg_sign && tolower(*p) == st->negative_char ) {
+    sign = -1;
+    p++;
+  }
+
+  // Leave missing digits, numbers that might overflow, numbers that
+  // might continue past the cached buffer and prefixes like 0x to the
+  // general code.
+  ndigits = _qio_count_digits(p, end);
+  if( ndigits == 0 || ndigits > 19 || p + ndigits == end ) return 0;
+  if( st->allow_base && ndigits == 1 && p[0] == '0' ) {
+    int c = tolower(p[1]);
+    if( c == 'x' || c == 'o' || c == 'b' ) return 0;
+  }
+
+  for( i = 0; i < ndigits; i++ ) {
+    num = 10*num + (p[i] - '0');
+  }
+
+  ch->cached_cur = (void*) (p + ndigits);
+  *num_out = num;
+  *sign_out = sign;
+  return 1;
+}
 
 qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, void* restrict out, size_t len, int issigned)
 {
@@ -2144,6 +2337,11 @@ qioerr qio_channel_scan_int(const int threadsafe, qio_channel_t* restrict ch, vo
   st.positive_char = tolower(style->positive_char);
   st.negative_char = tolower(style->negative_char);
 
+  if( _scan_int_cached(ch, &st, &num, &sign) ) {
+    err = 0;
+    goto error;
+  }
+
   err = _peek_number_unlocked(ch, &st, &amount);
   if( qio_err_to_int(err) == EEOF && st.end > 0 ) err = 0; // we tolerate EOF if there's data.
   if( err ) goto error;
@@ -2261,6 +2459,78 @@ error:
   return err;
 }
 
+// Scan a decimal floating point number that is entirely within the
+// cached buffer, for qio_channel_scan_float_or_imag. Returns false,
+// without consuming anything, if _peek_number_unlocked should scan it
+// instead.
+static
+int _scan_float_cached(qio_channel_t* restrict ch, number_reading_state_t* restrict st, double* restrict num_out)
+{
+  const uint8_t* p = (const uint8_t*) ch->cached_cur;
+  const uint8_t* end = (const uint8_t*) ch->cached_end;
+  const uint8_t* start;
+  char buf[64];
+  char* end_conv;
+  double num;
+  int seen_point = 0;
+  int seen_exponent = 0;
+  size_t n;
+
+  if( ! p || ! _qio_ascii_bytes_are_chars() ) return 0;
+  if( st->base != 0 && st->base != 10 ) return 0;
+  if( st->allow_i_after ) return 0;
+  if( st->point_char != '.' || st->exponent_char != 'e' ||
+      st->positive_char != '+' || st->negative_char != '-' ) return 0;
+
+  p = _qio_skip_ascii_space(p, end);
+  start = p;
+
+  if( p < end && (*p == '+' || *p == '-') ) p++;
+  if( p == end ) return 0;
+
+  // Leave inf, nan, 0x and the like to the general code
+  if( ! ((*p >= '0' && *p <= '9') || *p == '.') ) return 0;
+  if( st->allow_base && p[0] == '0' && p + 1 < end ) {
+    int c = tolower(p[1]);
+    if( c == 'x' || c == 'o' || c == 'b' ) return 0;
+  }
+
+  // Accept the same characters as _peek_number_unlocked does for a
+  // decimal number.
+  while( 1 ) {
+    p += _qio_count_digits(p, end);
+    if( p == end ) return 0;
+    if( *p == '.' && ! seen_point ) {
+      seen_point = 1;
+      p++;
+    } else if( tolower(*p) == 'e' && ! seen_exponent ) {
+      seen_exponent = 1;
+      p++;
+      if( p < end && (*p == '+' || *p == '-') ) p++;
+      if( p == end ) return 0;
+    } else {
+      break;
+    }
+  }
+
+  n = p - start;
+  if( n >= sizeof(buf) ) return 0;
+  memcpy(buf, start, n);
+  buf[n] = '\0';
+
+  // Leave errors to the general code, so that they are reported the
+  // same way.
+  errno = 0;
+  num = strtod(buf, &end_conv);
+  if( end_conv == buf ) return 0;
+  if( (num == HUGE_VAL || num == -HUGE_VAL || num == 0.0) && errno == ERANGE )
+    return 0;
+
+  ch->cached_cur = (void*) p;
+  *num_out = num;
+  return 1;
+}
+
 static
 qioerr qio_channel_scan_float_or_imag(const int threadsafe, qio_channel_t* restrict ch, void* restrict out, size_t len, bool imag)
 {
@@ -2306,6 +2576,11 @@ qioerr qio_channel_scan_float_or_imag(const int threadsafe, qio_channel_t* restr
   st.allow_i_after = needs_i;
   st.i_char = style->i_char;
 
+  if( _scan_float_cached(ch, &st, &num) ) {
+    err = 0;
+    goto error;
+  }
+
   err = _peek_number_unlocked(ch, &st, &amount);
   if( qio_err_to_int(err) == EEOF && st.end > 0 ) err = 0; // we tolerate EOF if there's data.
   if( err ) goto error;
@@ -2472,6 +2747,409 @@ static inline int _ltoa_convert(char *tmp, int tmplen, uint64_t num, int base, i
   return at;
 }
 
+/* Fast paths for printing numbers.
+ *
+ * Decimal digits are written two at a time from a table, and digits in
+ * bases 2, 8 and 16 with shifts and masks.
+ *
+ * For reals, _ftoa_decimal produces exactly what snprintf does for %g,
+ * %f and %e without going through it. A double is m*2^e2 with an
+ * integer m, so the digits to print are m*2^e2*10^s for some s, rounded
+ * to an integer. When that fits in 128 bits it is computed exactly,
+ * including printf's round-half-even on ties. Other numbers (very large
+ * or very small ones, high precisions, inf and nan) are left to snprintf.
+ */
+
+static const char _qio_digit_pairs[201] =
+  "00010203040506070809"
+  "10111213141516171819"
+  "20212223242526272829"
+  "30313233343536373839"
+  "40414243444546474849"
+  "50515253545556575859"
+  "60616263646566676869"
+  "70717273747576777879"
+  "80818283848586878889"
+  "90919293949596979899";
+
+static const uint64_t _qio_pow10[20] = {
+  1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL,
+  10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL,
+  100000000000ULL, 1000000000000ULL, 10000000000000ULL,
+  100000000000000ULL, 1000000000000000ULL, 10000000000000000ULL,
+  100000000000000000ULL, 1000000000000000000ULL,
+  10000000000000000000ULL
+};
+
+// Writes the decimal digits of num so that they end just before end.
+// Returns a pointer to the first digit.
+static inline
+char* _qio_u64_to_dec(char* end, uint64_t num)
+{
+  char* p = end;
+
+  while( num >= 100 ) {
+    int pair = 2 * (int) (num % 100);
+    num /= 100;
+    p -= 2;
+    p[0] = _qio_digit_pairs[pair];
+    p[1] = _qio_digit_pairs[pair + 1];
+  }
+
+  if( num >= 10 ) {
+    p -= 2;
+    p[0] = _qio_digit_pairs[2 * num];
+    p[1] = _qio_digit_pairs[2 * num + 1];
+  } else {
+    *--p = '0' + num;
+  }
+
+  return p;
+}
+
+// Like _ltoa_convert, for bases 2, 8 and 16 (shift is 1, 3 or 4)
+static inline
+int _ltoa_convert_pow2(char *tmp, int tmplen, uint64_t num, int shift, int uppercase)
+{
+  const char* digits = uppercase ? "0123456789ABCDEF" : "0123456789abcdef";
+  const uint64_t mask = (1 << shift) - 1;
+  int at = tmplen - 1;
+
+  tmp[at] = '\0';
+  do {
+    tmp[--at] = digits[num & mask];
+    num >>= shift;
+  } while( num != 0 && at > 0 );
+
+  return (num == 0) ? at : -1;
+}
+
+// Like _ltoa_convert, for base 10
+static inline
+int _ltoa_convert_dec(char *tmp, int tmplen, uint64_t num)
+{
+  // 20 digits and the '\0'
+  if( tmplen < 21 ) return -1;
+
+  tmp[tmplen-1] = '\0';
+  return _qio_u64_to_dec(&tmp[tmplen-1], num) - tmp;
+}
+
+#ifdef __SIZEOF_INT128__
+
+typedef unsigned __int128 qio_uint128_t;
+
+#define QIO_UINT128_MAX (~(qio_uint128_t) 0)
+
+// Like _qio_u64_to_dec, for 128-bit numbers
+static
+char* _qio_u128_to_dec(char* end, qio_uint128_t num)
+{
+  char* p = end;
+  char* next;
+
+  while( num > UINT64_MAX ) {
+    uint64_t low = (uint64_t) (num % _qio_pow10[19]);
+    num /= _qio_pow10[19];
+    // The low part always has all 19 digits
+    next = _qio_u64_to_dec(p, low);
+    while( next > p - 19 ) *--next = '0';
+    p = next;
+  }
+
+  return _qio_u64_to_dec(p, (uint64_t) num);
+}
+
+// Computes m*2^e2*10^e10, with *q_out set to the integer part and
+// *round_up_out to whether rounding to nearest, with ties to even,
+// adds one to it. Returns 0 if the computation does not fit in 128 bits.
+static
+int _qio_scale_exact(uint64_t m, int e2, int e10,
+                     qio_uint128_t* q_out, int* round_up_out)
+{
+  qio_uint128_t num = m;
+  qio_uint128_t den = 1;
+  qio_uint128_t p10 = 1;
+  qio_uint128_t q, r;
+  int n;
+
+  if( e10 < -38 || e10 > 38 || e2 <= -128 || e2 >= 128 ) return 0;
+
+  n = (e10 < 0) ? -e10 : e10;
+  while( n > 19 ) {
+    p10 *= _qio_pow10[19];
+    n -= 19;
+  }
+  p10 *= _qio_pow10[n];
+
+  if( e10 >= 0 ) {
+    if( num > QIO_UINT128_MAX / p10 ) return 0;
+    num *= p10;
+  } else {
+    den = p10;
+  }
+
+  if( e2 >= 0 ) {
+    if( num > (QIO_UINT128_MAX >> e2) ) return 0;
+    num <<= e2;
+  } else {
+    if( den > (QIO_UINT128_MAX >> -e2) ) return 0;
+    den <<= -e2;
+  }
+
+  if( den == 1 ) {
+    q = num;
+    r = 0;
+  } else if( e10 >= 0 ) {
+    // den is a power of 2
+    q = num >> -e2;
+    r = num & (den - 1);
+  } else {
+    q = num / den;
+    r = num % den;
+  }
+
+  *q_out = q;
+  *round_up_out = (r > den - r) || (r == den - r && (q & 1));
+  return 1;
+}
+
+// Sets *m_out and *e2_out so that num, which must be finite and
+// nonzero, is *m_out * 2^*e2_out.
+static inline
+void _qio_decompose_double(double num, uint64_t* m_out, int* e2_out)
+{
+  uint64_t bits;
+  int biased;
+
+  memcpy(&bits, &num, sizeof(bits));
+  biased = (bits >> 52) & 0x7ff;
+
+  *m_out = bits & ((1ULL << 52) - 1);
+  if( biased == 0 ) {
+    // subnormal
+    *e2_out = -1074;
+  } else {
+    *m_out |= 1ULL << 52;
+    *e2_out = biased - 1075;
+  }
+}
+
+// Finds the first sig_digits significant digits of num, which must be
+// positive and finite. On return, *digits_out holds them as an integer
+// with exactly sig_digits digits and *exp10_out is the exponent of the
+// first one, as in %e. Returns 0 if that can't be computed exactly.
+static
+int _qio_sig_digits(double num, int sig_digits, uint64_t* digits_out,
+                    int* exp10_out)
+{
+  qio_uint128_t q;
+  int round_up;
+  int e2;
+  int exp2;
+  int exp10;
+  uint64_t m;
+
+  _qio_decompose_double(num, &m, &e2);
+
+  // num is in [2^exp2, 2^(exp2+1)), so its decimal exponent is
+  // floor(exp2*log10(2)) or one more. 78913/2^18 is close enough to
+  // log10(2) for the floor to be right for every double.
+  exp2 = e2 + 63 - __builtin_clzll(m);
+  if( exp2 >= 0 ) exp10 = (exp2 * 78913) >> 18;
+  else exp10 = -((-exp2 * 78913 + (1 << 18) - 1) >> 18);
+
+  // Fewer bits make more numbers fit in 128 bits
+  while( (m & 1) == 0 ) {
+    m >>= 1;
+    e2++;
+  }
+
+  if( ! _qio_scale_exact(m, e2, sig_digits - 1 - exp10, &q, &round_up) )
+    return 0;
+  if( q >= _qio_pow10[sig_digits] ) {
+    exp10++;
+    if( ! _qio_scale_exact(m, e2, sig_digits - 1 - exp10, &q, &round_up) )
+      return 0;
+  }
+
+  if( round_up ) {
+    q++;
+    // 9.99 rounds up to 10.0
+    if( q == _qio_pow10[sig_digits] ) {
+      q = _qio_pow10[sig_digits - 1];
+      exp10++;
+    }
+  }
+
+  *digits_out = (uint64_t) q;
+  *exp10_out = exp10;
+  return 1;
+}
+
+// Writes digits, which has num_digits digits, as %e would with
+// num_digits - 1 digits after the point. Returns the end of the output.
+static
+char* _qio_put_exponential(char* p, uint64_t digits, int num_digits,
+                           int exp10, int uppercase, int strip_zeros)
+{
+  char tmp[24];
+  char* d = _qio_u64_to_dec(&tmp[sizeof(tmp)], digits);
+  int i;
+
+  // digits is only short when it is 0
+  while( &tmp[sizeof(tmp)] - d < num_digits ) *--d = '0';
+
+  // %g removes trailing zeros
+  if( strip_zeros ) {
+    while( num_digits > 1 && d[num_digits - 1] == '0' ) num_digits--;
+  }
+
+  *p++ = d[0];
+  if( num_digits > 1 ) {
+    *p++ = '.';
+    for( i = 1; i < num_digits; i++ ) *p++ = d[i];
+  }
+
+  *p++ = uppercase ? 'E' : 'e';
+  if( exp10 < 0 ) {
+    *p++ = '-';
+    exp10 = -exp10;
+  } else {
+    *p++ = '+';
+  }
+  // At least 2 exponent digits
+  if( exp10 < 10 ) *p++ = '0';
+  d = _qio_u64_to_dec(&tmp[sizeof(tmp)], exp10);
+  while( d < &tmp[sizeof(tmp)] ) *p++ = *d++;
+
+  return p;
+}
+
+// Writes the integer num * 10^-frac_digits with frac_digits digits
+// after the point. Returns the end of the output.
+static
+char* _qio_put_fixed(char* p, qio_uint128_t num, int frac_digits,
+                     int strip_zeros)
+{
+  char tmp[48];
+  char* end = &tmp[sizeof(tmp)];
+  char* d = _qio_u128_to_dec(end, num);
+  int int_digits;
+
+  // Leading zeros so that there is at least one digit before the point
+  while( end - d < frac_digits + 1 ) *--d = '0';
+
+  if( strip_zeros ) {
+    while( frac_digits > 0 && end[-1] == '0' ) {
+      end--;
+      frac_digits--;
+    }
+  }
+
+  int_digits = (end - d) - frac_digits;
+  qio_memcpy(p, d, int_digits);
+  p += int_digits;
+  if( frac_digits > 0 ) {
+    *p++ = '.';
+    qio_memcpy(p, d + int_digits, frac_digits);
+    p += frac_digits;
+  }
+
+  return p;
+}
+
+// Converts num as _ftoa_core would for base 10, with the same return
+// value and the same truncation when buf_sz is too small. Returns -1 if
+// snprintf has to do the conversion instead.
+static
+int _ftoa_decimal(char* buf, size_t buf_sz, double num, int realfmt,
+                  int precision, int uppercase)
+{
+  char tmp[128];
+  char* p = tmp;
+  uint64_t digits;
+  int exp10;
+  int len;
+
+  if( ! isfinite(num) || signbit(num) ) return -1;
+
+  if( realfmt == 0 ) {
+    int sig_digits = precision < 0 ? 6 : (precision == 0 ? 1 : precision);
+
+    if( sig_digits > 19 ) return -1;
+
+    if( num == 0.0 ) {
+      digits = 0;
+      exp10 = 0;
+    } else if( ! _qio_sig_digits(num, sig_digits, &digits, &exp10) ) {
+      return -1;
+    }
+
+    if( (precision < 0 && num >= 100000.0 && num < 1000000.0) ||
+        exp10 < -4 || exp10 >= sig_digits ) {
+      // _ftoa_core prints 6-digit integers in exponential notation too
+      p = _qio_put_exponential(p, digits, sig_digits, exp10, uppercase, 1);
+    } else {
+      p = _qio_put_fixed(p, digits, sig_digits - 1 - exp10, 1);
+    }
+  } else if( realfmt == 1 ) {
+    qio_uint128_t q = 0;
+    int round_up = 0;
+    uint64_t m;
+    int e2;
+
+    if( precision < 0 ) precision = 6;
+    if( precision > 38 ) return -1;
+
+    if( num != 0.0 ) {
+      _qio_decompose_double(num, &m, &e2);
+      if( ! _qio_scale_exact(m, e2, precision, &q, &round_up) ) return -1;
+      if( round_up ) {
+        if( q == QIO_UINT128_MAX ) return -1;
+        q++;
+      }
+    }
+
+    p = _qio_put_fixed(p, q, precision, 0);
+  } else if( realfmt == 2 ) {
+    if( precision < 0 ) precision = 6;
+    if( precision > 18 ) return -1;
+
+    if( num == 0.0 ) {
+      digits = 0;
+      exp10 = 0;
+    } else if( ! _qio_sig_digits(num, precision + 1, &digits, &exp10) ) {
+      return -1;
+    }
+
+    p = _qio_put_exponential(p, digits, precision + 1, exp10, uppercase, 0);
+  } else {
+    return -1;
+  }
+
+  len = p - tmp;
+
+  if( buf_sz > 0 ) {
+    size_t n = ((size_t) len < buf_sz) ? (size_t) len : buf_sz - 1;
+    qio_memcpy(buf, tmp, n);
+    buf[n] = '\0';
+  }
+
+  return len;
+}
+
+#else
+
+static
+int _ftoa_decimal(char* buf, size_t buf_sz, double num, int realfmt,
+                  int precision, int uppercase)
+{
+  return -1;
+}
+
+#endif
+
 // dst must have room (at most 65 bytes for binary + '\0')
 // Returns the number of characters written (not including '\0')
 // or >= size if there wasn't room in the buffer (returns amt needed)
@@ -2493,13 +3171,13 @@ int _ltoa(char* restrict dst, size_t size, uint64_t num, int isnegative,
 
   // Optimize conversions for supported bases
   if( base == 2 )
-    tmp_skip = _ltoa_convert(tmp, sizeof(tmp), num, 2, 0);
+    tmp_skip = _ltoa_convert_pow2(tmp, sizeof(tmp), num, 1, 0);
   else if( base == 8 )
-    tmp_skip = _ltoa_convert(tmp, sizeof(tmp), num, 8, 0);
+    tmp_skip = _ltoa_convert_pow2(tmp, sizeof(tmp), num, 3, 0);
   else if( base == 10 )
-    tmp_skip = _ltoa_convert(tmp, sizeof(tmp), num, 10, 0);
+    tmp_skip = _ltoa_convert_dec(tmp, sizeof(tmp), num);
   else if( base == 16 )
-    tmp_skip = _ltoa_convert(tmp, sizeof(tmp), num, 16, style->uppercase);
+    tmp_skip = _ltoa_convert_pow2(tmp, sizeof(tmp), num, 4, style->uppercase);
   else
     tmp_skip = _ltoa_convert(tmp, sizeof(tmp), num, base, style->uppercase);
 
@@ -2641,6 +3319,7 @@ int _ftoa_core(char* buf, size_t buf_sz, double num,
                int *skip)
 {
   int got = 0;
+  char tmp[32];
 
   // Do the numeric conversion and figure out how big the output
   // is. This conversion must concern itself with precision but
@@ -2659,6 +3338,11 @@ int _ftoa_core(char* buf, size_t buf_sz, double num,
 
   *skip = 0;
 
+  if( base == 10 ) {
+    got = _ftoa_decimal(buf, buf_sz, num, realfmt, precision, uppercase);
+    if( got >= 0 ) return got;
+  }
+
   if( base == 16 ) {
     if( precision < 0 ) {
       if( uppercase ) {
@@ -2684,7 +3368,6 @@ int _ftoa_core(char* buf, size_t buf_sz, double num,
         // the decimal part because the integer part have
         // a number of digits equals to the standard precision.
         if(num >= 100000.0 && num < 1000000.0){
-          got = snprintf(buf, buf_sz, "%.5E", num);
           //Since we force the %.5e for maintain a precision of
           //6 digits, the output could include some trailing zeroes.
           //With _find_prec, we find how much digits we need.
@@ -2692,16 +3375,17 @@ int _ftoa_core(char* buf, size_t buf_sz, double num,
           //It can also be done starting from the number itself
           //but this way avoids to deal with the loss of precision
           //caused by floating point representation
-          if(buf_sz > 0)
-            got = snprintf(buf, buf_sz, "%.*E",_find_prec(buf, got), num);
+          //
+          //The %.5e goes in tmp since buf might be too small for it.
+          got = snprintf(tmp, sizeof(tmp), "%.5E", num);
+          got = snprintf(buf, buf_sz, "%.*E",_find_prec(tmp, got), num);
         }
         else
           got = snprintf(buf, buf_sz, "%G", num);
       } else {
         if(num >= 100000.0 && num < 1000000.0){
-          got = snprintf(buf, buf_sz, "%.5e", num);
-          if(buf_sz > 0)
-            got = snprintf(buf, buf_sz, "%.*e",_find_prec(buf, got), num);
+          got = snprintf(tmp, sizeof(tmp), "%.5e", num);
+          got = snprintf(buf, buf_sz, "%.*e",_find_prec(tmp, got), num);
         }
         else
           got = snprintf(buf, buf_sz, "%g", num);
@@ -0,0 +1,606 @@
+/*
+ * Copyright 2004-2017 Cray Inc.
+ * Other additional copyright holders may be indicated within.
+ *
+ * The entirety of this work is licensed under the Apache License,
+ * Version 2.0 (the "License"); you may not use this file except
+ * in compliance with the License.
+ *
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _GNU_SOURCE
+// get syscall()
+#define _GNU_SOURCE
+#endif
+
+#include "sys_basic.h"
+
+#ifndef CHPL_RT_UNIT_TEST
+#include "chplrt.h"
+#include "chpl-tasks.h"
+#endif
+
+#include "qio_uring.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sched.h>
+#include <sys/uio.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+// io_uring is used through the system calls directly, so that
+// the runtime does not need liburing.
+#ifdef __NR_io_uring_setup
+#define QIO_HAVE_URING 1
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#endif
+
+ssize_t qio_uring_readahead_iobufs = 8; // read 8 iobufs (512K) ahead
+
+#ifdef QIO_HAVE_URING
+
+// Requests in flight per channel; the ring holds as many.
+#define QIO_URING_DEPTH 64
+
+// Yield this many times before blocking in the kernel for a completion.
+#define QIO_URING_YIELDS 16
+
+typedef struct {
+  qbytes_t* bytes;     // retained until the request completes
+  struct iovec iov;    // the part of the request not yet done
+  int64_t offset;      // file offset of iov
+  int64_t start;       // file offset the request started at
+  int64_t total;       // bytes done by earlier parts of a short request
+  int32_t res;
+  char writing;
+  char done;
+} qio_uring_req_t;
+
+// A queue of request slots, oldest first
+typedef struct {
+  int slots[QIO_URING_DEPTH];
+  int head;
+  int count;
+} qio_uring_queue_t;
+
+struct qio_uring_s {
+  int fd;       // the ring
+  fd_t file_fd; // the file the requests go to
+
+  // submission queue
+  void* sq_ring;
+  size_t sq_ring_size;
+  unsigned* sq_head;
+  unsigned* sq_tail;
+  unsigned* sq_mask;
+  unsigned* sq_array;
+  struct io_uring_sqe* sqes;
+  size_t sqes_size;
+  unsigned to_submit;
+
+  // completion queue
+  void* cq_ring;
+  size_t cq_ring_size;
+  unsigned* cq_head;
+  unsigned* cq_tail;
+  unsigned* cq_mask;
+  struct io_uring_cqe* cqes;
+
+  qio_uring_req_t reqs[QIO_URING_DEPTH];
+  int free_slots[QIO_URING_DEPTH];
+  int num_free;
+
+  qio_uring_queue_t reads;
+  qio_uring_queue_t writes;
+
+  // first failed write, reported until the ring is destroyed
+  qioerr write_error;
+};
+
+static
+int sys_io_uring_setup(unsigned entries, struct io_uring_params* p)
+{
+  return (int) syscall(__NR_io_uring_setup, entries, p);
+}
+
+static
+int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                       unsigned flags)
+{
+  return (int) syscall(__NR_io_uring_enter, fd, to_submit, min_complete,
+                       flags, NULL, 0);
+}
+
+static
+void qio_uring_yield(void)
+{
+#ifdef CHPL_RT_UNIT_TEST
+  sched_yield();
+#else
+  chpl_task_yield();
+#endif
+}
+
+static inline
+void _queue_push(qio_uring_queue_t* q, int slot)
+{
+  q->slots[(q->head + q->count) % QIO_URING_DEPTH] = slot;
+  q->count++;
+}
+
+static inline
+int _queue_front(qio_uring_queue_t* q)
+{
+  return q->slots[q->head];
+}
+
+static inline
+void _queue_pop(qio_uring_queue_t* q)
+{
+  q->head = (q->head + 1) % QIO_URING_DEPTH;
+  q->count--;
+}
+
+int qio_uring_available(void)
+{
+  static int available = -1;
+
+  if( available == -1 ) {
+    struct io_uring_params p;
+    int fd;
+
+    memset(&p, 0, sizeof(p));
+    fd = sys_io_uring_setup(1, &p);
+    if( fd >= 0 ) close(fd);
+    available = (fd >= 0);
+  }
+
+  return available;
+}
+
+qioerr qio_uring_create(qio_uring_t** ring_out, fd_t fd)
+{
+  struct io_uring_params p;
+  qio_uring_t* ring;
+  char* sq;
+  char* cq;
+  int i;
+  qioerr err;
+
+  *ring_out = NULL;
+
+  ring = (qio_uring_t*) qio_calloc(1, sizeof(qio_uring_t));
+  if( ! ring ) return QIO_ENOMEM;
+
+  memset(&p, 0, sizeof(p));
+  ring->fd = sys_io_uring_setup(QIO_URING_DEPTH, &p);
+  if( ring->fd < 0 ) {
+    err = qio_mkerror_errno();
+    qio_free(ring);
+    return err;
+  }
+
+  ring->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+  ring->cq_ring_size = p.cq_off.cqes +
+                       p.cq_entries * sizeof(struct io_uring_cqe);
+  ring->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+
+  ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring->fd,
+                       IORING_OFF_SQ_RING);
+  ring->cq_ring = mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE,
+                       MAP_SHARED | MAP_POPULATE, ring->fd,
+                       IORING_OFF_CQ_RING);
+  ring->sqes = (struct io_uring_sqe*)
+               mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQES);
+
+  if( ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED ||
+      ring->sqes == MAP_FAILED ) {
+    err = qio_mkerror_errno();
+    if( ring->sq_ring != MAP_FAILED ) munmap(ring->sq_ring, ring->sq_ring_size);
+    if( ring->cq_ring != MAP_FAILED ) munmap(ring->cq_ring, ring->cq_ring_size);
+    if( ring->sqes != MAP_FAILED ) munmap(ring->sqes, ring->sqes_size);
+    close(ring->fd);
+    qio_free(ring);
+    return err;
+  }
+
+  sq = (char*) ring->sq_ring;
+  ring->sq_head = (unsigned*) (sq + p.sq_off.head);
+  ring->sq_tail = (unsigned*) (sq + p.sq_off.tail);
+  ring->sq_mask = (unsigned*) (sq + p.sq_off.ring_mask);
+  ring->sq_array = (unsigned*) (sq + p.sq_off.array);
+
+  cq = (char*) ring->cq_ring;
+  ring->cq_head = (unsigned*) (cq + p.cq_off.head);
+  ring->cq_tail = (unsigned*) (cq + p.cq_off.tail);
+  ring->cq_mask = (unsigned*) (cq + p.cq_off.ring_mask);
+  ring->cqes = (struct io_uring_cqe*) (cq + p.cq_off.cqes);
+
+  for( i = 0; i < QIO_URING_DEPTH; i++ ) {
+    ring->free_slots[i] = QIO_URING_DEPTH - 1 - i;
+  }
+  ring->num_free = QIO_URING_DEPTH;
+
+  ring->file_fd = fd;
+  ring->write_error = 0;
+
+  *ring_out = ring;
+  return 0;
+}
+
+// Put a submission queue entry for a slot in the ring.
+static
+void _prepare(qio_uring_t* ring, int slot)
+{
+  qio_uring_req_t* req = &ring->reqs[slot];
+  unsigned tail = *ring->sq_tail;
+  unsigned index = tail & *ring->sq_mask;
+  struct io_uring_sqe* sqe = &ring->sqes[index];
+
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = req->writing ? IORING_OP_WRITEV : IORING_OP_READV;
+  sqe->fd = ring->file_fd;
+  sqe->addr = (uint64_t) (uintptr_t) &req->iov;
+  sqe->len = 1;
+  sqe->off = (uint64_t) req->offset;
+  sqe->user_data = (uint64_t) slot;
+
+  req->done = 0;
+  req->res = 0;
+
+  ring->sq_array[index] = index;
+  // make the entry visible to the kernel before the new tail
+  __atomic_store_n(ring->sq_tail, tail + 1, __ATOMIC_RELEASE);
+  ring->to_submit++;
+}
+
+// Move completions into their requests.
+static
+void _reap(qio_uring_t* ring)
+{
+  unsigned head = *ring->cq_head;
+  unsigned tail = __atomic_load_n(ring->cq_tail, __ATOMIC_ACQUIRE);
+
+  while( head != tail ) {
+    struct io_uring_cqe* cqe = &ring->cqes[head & *ring->cq_mask];
+    qio_uring_req_t* req = &ring->reqs[cqe->user_data];
+
+    req->res = cqe->res;
+    req->done = 1;
+    head++;
+  }
+
+  __atomic_store_n(ring->cq_head, head, __ATOMIC_RELEASE);
+}
+
+qioerr qio_uring_submit(qio_uring_t* ring)
+{
+  while( ring->to_submit > 0 ) {
+    int rc = sys_io_uring_enter(ring->fd, ring->to_submit, 0, 0);
+    if( rc < 0 ) {
+      if( errno == EINTR ) continue;
+      if( errno == EAGAIN || errno == EBUSY ) {
+        // the kernel is short on resources; let some requests finish
+        _reap(ring);
+        qio_uring_yield();
+        continue;
+      }
+      return qio_mkerror_errno();
+    }
+    ring->to_submit -= rc;
+  }
+  return 0;
+}
+
+static
+qioerr _wait(qio_uring_t* ring, int slot)
+{
+  qio_uring_req_t* req = &ring->reqs[slot];
+  int yields = 0;
+  qioerr err;
+
+  err = qio_uring_submit(ring);
+  if( err ) return err;
+
+  while( ! req->done ) {
+    _reap(ring);
+    if( req->done ) break;
+
+    if( yields < QIO_URING_YIELDS ) {
+      // Let other tasks run while the kernel does the I/O.
+      yields++;
+      qio_uring_yield();
+    } else {
+      int rc = sys_io_uring_enter(ring->fd, 0, 1, IORING_ENTER_GETEVENTS);
+      if( rc < 0 && errno != EINTR ) return qio_mkerror_errno();
+    }
+  }
+
+  return 0;
+}
+
+// Queue the rest of a request that transferred n bytes.
+static
+void _continue(qio_uring_t* ring, int slot, int32_t n)
+{
+  qio_uring_req_t* req = &ring->reqs[slot];
+
+  req->iov.iov_base = qio_ptr_add(req->iov.iov_base, n);
+  req->iov.iov_len -= n;
+  req->offset += n;
+  req->total += n;
+  _prepare(ring, slot);
+}
+
+static
+void _release(qio_uring_t* ring, int slot)
+{
+  qio_uring_req_t* req = &ring->reqs[slot];
+
+  qbytes_release(req->bytes);
+  req->bytes = NULL;
+  ring->free_slots[ring->num_free++] = slot;
+}
+
+int qio_uring_can_submit(qio_uring_t* ring)
+{
+  return ring->num_free > 0;
+}
+
+static
+qioerr _queue(qio_uring_t* ring, int writing, qbytes_t* bytes,
+              void* ptr, int64_t len, int64_t offset)
+{
+  qio_uring_req_t* req;
+  int slot;
+
+  if( ring->num_free == 0 ) QIO_RETURN_CONSTANT_ERROR(EAGAIN, "ring full");
+
+  slot = ring->free_slots[--ring->num_free];
+  req = &ring->reqs[slot];
+
+  qbytes_retain(bytes);
+  req->bytes = bytes;
+  req->iov.iov_base = ptr;
+  req->iov.iov_len = len;
+  req->offset = offset;
+  req->start = offset;
+  req->total = 0;
+  req->writing = writing;
+
+  _prepare(ring, slot);
+
+  if( writing ) _queue_push(&ring->writes, slot);
+  else _queue_push(&ring->reads, slot);
+
+  return 0;
+}
+
+qioerr qio_uring_queue_read(qio_uring_t* ring, qbytes_t* bytes,
+                            void* ptr, int64_t len, int64_t offset)
+{
+  return _queue(ring, 0, bytes, ptr, len, offset);
+}
+
+qioerr qio_uring_queue_write(qio_uring_t* ring, qbytes_t* bytes,
+                             void* ptr, int64_t len, int64_t offset)
+{
+  if( ring->num_free == 0 ) {
+    qioerr err = qio_uring_finish_writes(ring, ring->writes.count - 1);
+    if( err ) return err;
+  }
+  return _queue(ring, 1, bytes, ptr, len, offset);
+}
+
+int qio_uring_num_reads(qio_uring_t* ring)
+{
+  return ring->reads.count;
+}
+
+int64_t qio_uring_reads_end(qio_uring_t* ring)
+{
+  qio_uring_queue_t* q = &ring->reads;
+  qio_uring_req_t* last;
+
+  if( q->count == 0 ) return -1;
+
+  last = &ring->reqs[q->slots[(q->head + q->count - 1) % QIO_URING_DEPTH]];
+  return last->offset + last->iov.iov_len;
+}
+
+qioerr qio_uring_wait_read(qio_uring_t* ring, int64_t* offset_out,
+                           ssize_t* num_read)
+{
+  int slot = _queue_front(&ring->reads);
+  qio_uring_req_t* req = &ring->reqs[slot];
+  qioerr err = 0;
+
+  while( 1 ) {
+    err = _wait(ring, slot);
+    if( err ) break;
+
+    if( req->res < 0 ) {
+      if( req->res == -EINTR || req->res == -EAGAIN ) {
+        _continue(ring, slot, 0);
+        continue;
+      }
+      err = qio_int_to_err(-req->res);
+      break;
+    }
+
+    if( req->res > 0 && (size_t) req->res < req->iov.iov_len ) {
+      // A short read is only the end of the file if the next read
+      // returns nothing.
+      _continue(ring, slot, req->res);
+      continue;
+    }
+
+    req->total += req->res;
+    if( req->res == 0 && req->iov.iov_len > 0 ) err = QIO_EEOF;
+    break;
+  }
+
+  *offset_out = req->start;
+  *num_read = req->total;
+
+  _queue_pop(&ring->reads);
+  _release(ring, slot);
+
+  return err;
+}
+
+void qio_uring_cancel_reads(qio_uring_t* ring)
+{
+  while( ring->reads.count > 0 ) {
+    int slot = _queue_front(&ring->reads);
+
+    // Nothing useful can be done about an error here.
+    _wait(ring, slot);
+    _queue_pop(&ring->reads);
+    _release(ring, slot);
+  }
+}
+
+qioerr qio_uring_finish_writes(qio_uring_t* ring, int max_pending)
+{
+  qioerr err = 0;
+
+  while( ring->writes.count > 0 ) {
+    int slot = _queue_front(&ring->writes);
+    qio_uring_req_t* req = &ring->reqs[slot];
+
+    if( ring->writes.count > max_pending ) {
+      err = _wait(ring, slot);
+      if( err ) return err;
+    } else {
+      _reap(ring);
+      if( ! req->done ) break;
+    }
+
+    if( req->res < 0 &&
+        (req->res == -EINTR || req->res == -EAGAIN) ) {
+      _continue(ring, slot, 0);
+      continue;
+    }
+
+    if( req->res > 0 && (size_t) req->res < req->iov.iov_len ) {
+      _continue(ring, slot, req->res);
+      continue;
+    }
+
+    if( ! ring->write_error ) {
+      if( req->res < 0 ) {
+        ring->write_error = qio_int_to_err(-req->res);
+      } else if( req->res == 0 && req->iov.iov_len > 0 ) {
+        QIO_GET_CONSTANT_ERROR(ring->write_error, EIO, "no progress writing");
+      }
+    }
+
+    _queue_pop(&ring->writes);
+    _release(ring, slot);
+  }
+
+  return ring->write_error;
+}
+
+qioerr qio_uring_destroy(qio_uring_t* ring)
+{
+  qioerr err;
+
+  qio_uring_cancel_reads(ring);
+  err = qio_uring_finish_writes(ring, 0);
+
+  munmap(ring->sqes, ring->sqes_size);
+  munmap(ring->cq_ring, ring->cq_ring_size);
+  munmap(ring->sq_ring, ring->sq_ring_size);
+  close(ring->fd);
+  qio_free(ring);
+
+  return err;
+}
+
+#else
+
+// io_uring is not available on this system.
+
+int qio_uring_available(void)
+{
+  return 0;
+}
+
+qioerr qio_uring_create(qio_uring_t** ring_out, fd_t fd)
+{
+  *ring_out = NULL;
+  QIO_RETURN_CONSTANT_ERROR(ENOSYS, "io_uring not supported");
+}
+
+qioerr qio_uring_destroy(qio_uring_t* ring)
+{
+  return 0;
+}
+
+int qio_uring_can_submit(qio_uring_t* ring)
+{
+  return 0;
+}
+
+qioerr qio_uring_queue_read(qio_uring_t* ring, qbytes_t* bytes,
+                            void* ptr, int64_t len, int64_t offset)
+{
+  QIO_RETURN_CONSTANT_ERROR(ENOSYS, "io_uring not supported");
+}
+
+qioerr qio_uring_queue_write(qio_uring_t* ring, qbytes_t* bytes,
+                             void* ptr, int64_t len, int64_t offset)
+{
+  QIO_RETURN_CONSTANT_ERROR(ENOSYS, "io_uring not supported");
+}
+
+qioerr qio_uring_submit(qio_uring_t* ring)
+{
+  return 0;
+}
+
+int qio_uring_num_reads(qio_uring_t* ring)
+{
+  return 0;
+}
+
+int64_t qio_uring_reads_end(qio_uring_t* ring)
+{
+  return -1;
+}
+
+qioerr qio_uring_wait_read(qio_uring_t* ring, int64_t* offset_out,
+                           ssize_t* num_read)
+{
+  *offset_out = 0;
+  *num_read = 0;
+  QIO_RETURN_CONSTANT_ERROR(ENOSYS, "io_uring not supported");
+}
+
+void qio_uring_cancel_reads(qio_uring_t* ring)
+{
+}
+
+qioerr qio_uring_finish_writes(qio_uring_t* ring, int max_pending)
+{
+  return 0;
+}
+
+#endif
@@ -23,6 +23,7 @@
 
 #include "chplrt.h"
 #include "chpl_rt_utils_static.h"
+#include "chpl-atomics.h"
 #include "chplcgfns.h"
 #include "chpl-comm.h"
 #include "chplexit.h"
@@ -46,7 +47,21 @@
 
 
 //
-// task pool: linked list of tasks
+// Task pool: per-thread work-stealing deques of tasks
+//
+// Each thread that creates tasks owns a Chase-Lev deque.  The owner
+// pushes and pops at the bottom without locking, and idle threads
+// steal from the top with a single CAS.  Because the old global pool
+// was a FIFO, thieves still see tasks in creation order; only the
+// owner, which runs its own most recently created task first, sees
+// LIFO order.
+//
+// Tasks created for a cobegin or coforall are also linked onto the
+// parent's task list, so that chpl_task_executeTasksInList() can run
+// any the pool threads haven't gotten to yet.  Such a task is thus
+// reachable from two places.  Whoever first sets its 'claimed' flag
+// runs it, and the descriptor is reference counted so that it can be
+// freed once both the deque entry and the list entry are gone.
 //
 typedef struct task_pool_struct* task_pool_p;
 
@@ -55,11 +70,10 @@ typedef struct {
 } chpl_task_prvDataImpl_t;
 
 typedef struct task_pool_struct {
-  task_pool_p*     p_list_head;  // task list we're on, if any
-  task_pool_p      list_next;    // double-link pointers for list
-  task_pool_p      list_prev;
-  task_pool_p      next;         // double-link pointers for pool
-  task_pool_p      prev;
+  task_pool_p      list_next;    // next task on the same task list
+  chpl_bool        in_task_list; // on a task list as well as a deque?
+  atomic_bool      claimed;      // set by whoever runs the task
+  atomic_int_least32_t refcnt;   // deque entry + list entry, if any
 
   chpl_task_prvDataImpl_t chpl_data;
 
@@ -67,6 +81,26 @@ typedef struct task_pool_struct {
 } task_pool_t;
 
 
+// Keep the owner's and the thieves' ends of a deque on separate lines.
+#define TASK_DEQUE_PAD_SIZE 64
+
+typedef struct task_deque_buf_struct {
+  int64_t                       size;   // always a power of 2
+  struct task_deque_buf_struct* prev;   // retired smaller buffer, if any
+  atomic_uintptr_t              tasks[]; // task_pool_p entries
+} task_deque_buf_t;
+
+typedef struct {
+  atomic_int_least64_t top;      // thieves take from here
+  char                 pad[TASK_DEQUE_PAD_SIZE - sizeof(atomic_int_least64_t)];
+  atomic_int_least64_t bottom;   // owner pushes and pops here
+  atomic_uintptr_t     buf;      // current task_deque_buf_t
+} task_deque_t;
+
+#define TASK_DEQUE_INIT_SIZE 256
+#define TASK_DEQUE_ABORT ((task_pool_p) (intptr_t) -1)
+
+
 typedef struct lockReport {
   int32_t            filename;
   int                lineno;
@@ -80,6 +114,8 @@ typedef struct lockReport {
 typedef struct {
   task_pool_p   ptask;
   lockReport_t* lockRprt;
+  task_deque_t* deque;           // created on first task creation
+  uint64_t      steal_seed;      // victim selection
 } thread_private_data_t;
 
 
@@ -87,22 +123,41 @@ static chpl_bool        initialized = false;
 
 static volatile chpl_bool canCountRunningTasks = false;
 
-static chpl_thread_mutex_t threading_lock;     // critical section lock
-static chpl_thread_mutex_t extra_task_lock;    // critical section lock
-static chpl_thread_mutex_t task_id_lock;       // critical section lock
-static chpl_thread_mutex_t task_list_lock;     // critical section lock
-static volatile task_pool_p
-                           task_pool_head;     // head of task pool
-static volatile task_pool_p
-                           task_pool_tail;     // tail of task pool
-
-static int                 queued_task_cnt;    // number of tasks in task pool
-static int                 running_task_cnt;   // number of running tasks
-static int64_t             extra_task_cnt;     // number of tasks being run by
+static chpl_thread_mutex_t threading_lock;     // serializes thread creation
+                                               //   and deque registration
+static atomic_uint_least64_t next_task_id;
+
+//
+// Task lists can be added to by any task within the dynamic scope of
+// the owning sync or coforall, so they need some protection.  Pool
+// threads never touch them, though, so a small set of locks hashed on
+// the list head's address keeps contention to a minimum.
+//
+#define NUM_TASK_LIST_LOCKS 64
+static chpl_thread_mutex_t task_list_locks[NUM_TASK_LIST_LOCKS];
+
+//
+// The deque registry, through which thieves find their victims.  It
+// only grows, and old copies are kept until exit because thieves may
+// still be reading them.
+//
+typedef struct deque_registry_struct {
+  int                           size;
+  struct deque_registry_struct* prev;
+  task_deque_t*                 deques[];
+} deque_registry_t;
+
+static atomic_uintptr_t    deque_registry;     // deque_registry_t*
+static atomic_int_least32_t num_deques;
+
+static atomic_int_least32_t queued_task_cnt;   // number of unclaimed tasks
+                                               //   in task pool
+static atomic_int_least32_t running_task_cnt;  // number of running tasks
+static atomic_int_least64_t extra_task_cnt;    // number of tasks being run by
                                                //   threads occupied already
 static int                 blocked_thread_cnt; // number of threads that
                                                //   cannot make progress
-static int                 idle_thread_cnt;    // number of threads looking
+static atomic_int_least32_t idle_thread_cnt;   // number of threads looking
                                                //   for work
 static uint64_t            progress_cnt;       // number of unblock operations,
                                                //   as a proxy for progress
@@ -119,8 +174,17 @@ static chpl_fn_p comm_task_fn;
 //
 // Internal functions.
 //
-static void                    enqueue_task(task_pool_p, task_pool_p*);
-static void                    dequeue_task(task_pool_p);
+static task_deque_t*           deque_new(void);
+static void                    deque_push(task_deque_t*, task_pool_p);
+static task_pool_p             deque_take(task_deque_t*);
+static task_pool_p             deque_steal(task_deque_t*);
+static task_deque_t*           get_my_deque(thread_private_data_t*);
+static void                    trim_claimed_tasks(task_deque_t*);
+static task_pool_p             find_task(thread_private_data_t*);
+static chpl_bool               claim_task(task_pool_p);
+static void                    release_task(task_pool_p);
+static chpl_thread_mutex_t*    task_list_lock(task_pool_p*);
+static chpl_bool               enqueue_task(task_pool_p, task_pool_p*);
 static void                    comm_task_wrapper(void*);
 static void                    taskCallBody(chpl_fn_int_t, chpl_fn_p,
                                             chpl_task_bundle_t*, size_t,
@@ -140,7 +204,7 @@ static void                    check_for_deadlock(void);
 static void                    thread_begin(void*);
 static void                    thread_end(void);
 static void                    maybe_add_thread(void);
-static task_pool_p             add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
+static void                    add_to_task_pool(chpl_fn_int_t, chpl_fn_p,
                                                 chpl_task_bundle_t*, size_t,
                                                 chpl_bool, chpl_bool, chpl_bool,
                                                 task_pool_p*, chpl_bool,
@@ -318,12 +382,12 @@ static void setup_main_thread_private_data(void)
                                            CHPL_RT_MD_TASK_POOL_DESC,
                                            0, 0);
   tp->lockRprt            = NULL;
+  tp->deque               = NULL;
+  tp->steal_seed          = 0;
 
-  tp->ptask->p_list_head  = NULL;
   tp->ptask->list_next    = NULL;
-  tp->ptask->list_prev    = NULL;
-  tp->ptask->next         = NULL;
-  tp->ptask->prev         = NULL;
+  tp->ptask->in_task_list = false;
+  memset(&tp->ptask->chpl_data, 0, sizeof(tp->ptask->chpl_data));
 
   // serial_state starts out true; it is set to false in chpl_std_module_init().
   tp->ptask->bundle.serial_state    = true;
@@ -344,16 +408,19 @@ static void setup_main_thread_private_data(void)
 // Tasks
 
 void chpl_task_init(void) {
+  int i;
+
   chpl_thread_mutexInit(&threading_lock);
-  chpl_thread_mutexInit(&extra_task_lock);
-  chpl_thread_mutexInit(&task_id_lock);
-  chpl_thread_mutexInit(&task_list_lock);
-  queued_task_cnt = 0;
-  running_task_cnt = 1;                     // only main task running
+  atomic_init_uint_least64_t(&next_task_id, chpl_nullTaskID + 1);
+  for (i = 0; i < NUM_TASK_LIST_LOCKS; i++)
+    chpl_thread_mutexInit(&task_list_locks[i]);
+  atomic_init_int_least32_t(&queued_task_cnt, 0);
+  atomic_init_int_least32_t(&running_task_cnt, 1); // only main task running
   blocked_thread_cnt = 0;
-  idle_thread_cnt = 0;
-  extra_task_cnt = 0;
-  task_pool_head = task_pool_tail = NULL;
+  atomic_init_int_least32_t(&idle_thread_cnt, 0);
+  atomic_init_int_least64_t(&extra_task_cnt, 0);
+  atomic_init_uintptr_t(&deque_registry, (uintptr_t) NULL);
+  atomic_init_int_least32_t(&num_deques, 0);
 
   chpl_thread_init(thread_begin, thread_end);
 
@@ -524,12 +591,12 @@ static void comm_task_wrapper(void* arg) {
                                            CHPL_RT_MD_TASK_POOL_DESC,
                                            0, 0);
   tp->lockRprt            = NULL;
+  tp->deque               = NULL;
+  tp->steal_seed          = 0;
 
-  tp->ptask->p_list_head  = NULL;
   tp->ptask->list_next    = NULL;
-  tp->ptask->list_prev    = NULL;
-  tp->ptask->next         = NULL;
-  tp->ptask->prev         = NULL;
+  tp->ptask->in_task_list = false;
+  memset(&tp->ptask->chpl_data, 0, sizeof(tp->ptask->chpl_data));
 
   tp->ptask->bundle.serial_state    = false;
   tp->ptask->bundle.countRunning    = false;
@@ -548,71 +615,313 @@ static void comm_task_wrapper(void* arg) {
 
 
 //
-// Enqueue and dequeue tasks from the pool.
+// Work-stealing deque operations.  This is the Chase-Lev deque, with
+// the memory orderings given by Le, Pop, Cohen and Zappa Nardelli,
+// "Correct and Efficient Work-Stealing for Weak Memory Models"
+// (PPoPP 2013).  Only the owning thread may push or take; any thread
+// may steal.
 //
+static task_deque_buf_t* deque_buf_new(int64_t size) {
+  task_deque_buf_t* a;
+  int64_t i;
+
+  a = (task_deque_buf_t*) chpl_mem_alloc(sizeof(task_deque_buf_t)
+                                         + size * sizeof(atomic_uintptr_t),
+                                         CHPL_RT_MD_TASK_DEQUE, 0, 0);
+  a->size = size;
+  a->prev = NULL;
+  for (i = 0; i < size; i++)
+    atomic_init_uintptr_t(&a->tasks[i], (uintptr_t) NULL);
+
+  return a;
+}
+
+
+static task_deque_t* deque_new(void) {
+  task_deque_t* d;
+
+  d = (task_deque_t*) chpl_mem_alloc(sizeof(task_deque_t),
+                                     CHPL_RT_MD_TASK_DEQUE, 0, 0);
+  atomic_init_int_least64_t(&d->top, 0);
+  atomic_init_int_least64_t(&d->bottom, 0);
+  atomic_init_uintptr_t(&d->buf,
+                        (uintptr_t) deque_buf_new(TASK_DEQUE_INIT_SIZE));
+
+  return d;
+}
+
+
 static inline
-void enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
-  queued_task_cnt++;
+void deque_push(task_deque_t* d, task_pool_p ptask) {
+  int64_t b, t;
+  task_deque_buf_t* a;
 
-  //
-  // Add to pool.
-  //
-  if (task_pool_tail)
-    task_pool_tail->next = ptask;
-  else
-    task_pool_head = ptask;
-  ptask->prev = task_pool_tail;
-  task_pool_tail = ptask;
+  b = atomic_load_explicit_int_least64_t(&d->bottom, memory_order_relaxed);
+  t = atomic_load_explicit_int_least64_t(&d->top, memory_order_acquire);
+  a = (task_deque_buf_t*) atomic_load_explicit_uintptr_t(&d->buf,
+                                                         memory_order_relaxed);
 
-  //
-  // Add to list, if any.
-  //
-  if (p_task_list_head == NULL) {
-    ptask->p_list_head = NULL;
+  if (b - t > a->size - 1) {
+    //
+    // Full.  Copy into one twice the size.  Thieves may still be
+    // reading the old one, so it is retired rather than freed.
+    //
+    task_deque_buf_t* na = deque_buf_new(2 * a->size);
+    int64_t i;
+
+    for (i = t; i < b; i++) {
+      uintptr_t v;
+      v = atomic_load_explicit_uintptr_t(&a->tasks[i & (a->size - 1)],
+                                         memory_order_relaxed);
+      atomic_store_explicit_uintptr_t(&na->tasks[i & (na->size - 1)], v,
+                                      memory_order_relaxed);
+    }
+    na->prev = a;
+    atomic_store_explicit_uintptr_t(&d->buf, (uintptr_t) na,
+                                    memory_order_release);
+    a = na;
   }
-  else {
-    ptask->p_list_head = p_task_list_head;
-    ptask->list_next = *p_task_list_head;
-    if (*p_task_list_head != NULL)
-      (*p_task_list_head)->list_prev = ptask;
-    ptask->list_prev = NULL;
-    *p_task_list_head = ptask;
+
+  atomic_store_explicit_uintptr_t(&a->tasks[b & (a->size - 1)],
+                                  (uintptr_t) ptask, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit_int_least64_t(&d->bottom, b + 1, memory_order_relaxed);
+}
+
+
+static inline
+task_pool_p deque_take(task_deque_t* d) {
+  int64_t b, t;
+  task_deque_buf_t* a;
+  task_pool_p ptask;
+
+  b = atomic_load_explicit_int_least64_t(&d->bottom, memory_order_relaxed) - 1;
+  a = (task_deque_buf_t*) atomic_load_explicit_uintptr_t(&d->buf,
+                                                         memory_order_relaxed);
+  atomic_store_explicit_int_least64_t(&d->bottom, b, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  t = atomic_load_explicit_int_least64_t(&d->top, memory_order_relaxed);
+
+  if (t > b) {
+    // empty
+    atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                        memory_order_relaxed);
+    return NULL;
+  }
+
+  ptask = (task_pool_p)
+          atomic_load_explicit_uintptr_t(&a->tasks[b & (a->size - 1)],
+                                         memory_order_relaxed);
+  if (t == b) {
+    // last one, so we have to race the thieves for it
+    if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+           &d->top, t, t + 1, memory_order_seq_cst))
+      ptask = NULL;
+    atomic_store_explicit_int_least64_t(&d->bottom, b + 1,
+                                        memory_order_relaxed);
   }
+
+  return ptask;
 }
 
 
+//
+// Returns NULL if the deque is empty and TASK_DEQUE_ABORT if another
+// thread got the task we were after.
+//
 static inline
-void dequeue_task(task_pool_p ptask) {
-  assert(queued_task_cnt > 0);
-  queued_task_cnt--;
+task_pool_p deque_steal(task_deque_t* d) {
+  int64_t b, t;
+  task_deque_buf_t* a;
+  task_pool_p ptask;
 
-  //
-  // Remove from pool.
-  //
-  if (ptask == task_pool_head) {
-    if ((task_pool_head = task_pool_head->next) == NULL)
-      task_pool_tail = NULL;
-    else
-      task_pool_head->prev = NULL;
+  t = atomic_load_explicit_int_least64_t(&d->top, memory_order_acquire);
+  atomic_thread_fence(memory_order_seq_cst);
+  b = atomic_load_explicit_int_least64_t(&d->bottom, memory_order_acquire);
+
+  if (t >= b)
+    return NULL;
+
+  a = (task_deque_buf_t*) atomic_load_explicit_uintptr_t(&d->buf,
+                                                         memory_order_acquire);
+  ptask = (task_pool_p)
+          atomic_load_explicit_uintptr_t(&a->tasks[t & (a->size - 1)],
+                                         memory_order_relaxed);
+  if (!atomic_compare_exchange_strong_explicit_int_least64_t(
+         &d->top, t, t + 1, memory_order_seq_cst))
+    return TASK_DEQUE_ABORT;
+
+  return ptask;
+}
+
+
+//
+// Get my thread's deque, creating and registering it if this is the
+// first task the thread has created.
+//
+static task_deque_t* get_my_deque(thread_private_data_t* tp) {
+  if (tp->deque == NULL) {
+    task_deque_t* d = deque_new();
+    deque_registry_t* r;
+    int32_t n;
+
+    // begin critical section
+    chpl_thread_mutexLock(&threading_lock);
+
+    r = (deque_registry_t*) atomic_load_uintptr_t(&deque_registry);
+    n = atomic_load_int_least32_t(&num_deques);
+    if (r == NULL || n == r->size) {
+      deque_registry_t* nr;
+      int size = (r == NULL) ? 64 : 2 * r->size;
+
+      nr = (deque_registry_t*) chpl_mem_alloc(sizeof(deque_registry_t)
+                                              + size * sizeof(task_deque_t*),
+                                              CHPL_RT_MD_TASK_DEQUE, 0, 0);
+      nr->size = size;
+      nr->prev = r;
+      if (n > 0)
+        memcpy(nr->deques, r->deques, n * sizeof(task_deque_t*));
+      atomic_store_uintptr_t(&deque_registry, (uintptr_t) nr);
+      r = nr;
+    }
+    r->deques[n] = d;
+    atomic_store_int_least32_t(&num_deques, n + 1);
+
+    // end critical section
+    chpl_thread_mutexUnlock(&threading_lock);
+
+    tp->deque = d;
   }
-  else {
-    if ((ptask->prev->next = ptask->next) == NULL)
-      task_pool_tail = ptask->prev;
-    else
-      ptask->next->prev = ptask->prev;
+
+  return tp->deque;
+}
+
+
+//
+// Try to take ownership of a task we found in a deque or on a task
+// list.  If we get it the caller should run it; if not, the caller's
+// reference to it is gone.
+//
+static inline
+chpl_bool claim_task(task_pool_p ptask) {
+  if (ptask->in_task_list
+      && atomic_exchange_bool(&ptask->claimed, true)) {
+    release_task(ptask);
+    return false;
   }
 
-  //
-  // Remove from list, if on one.
-  //
-  if (ptask->p_list_head != NULL) {
-    if (ptask == *(ptask->p_list_head))
-      *(ptask->p_list_head) = ptask->list_next;
-    else
-      ptask->list_prev->list_next = ptask->list_next;
-    if (ptask->list_next != NULL)
-      ptask->list_next->list_prev = ptask->list_prev;
+  (void) atomic_fetch_sub_int_least32_t(&queued_task_cnt, 1);
+  return true;
+}
+
+
+static inline
+void release_task(task_pool_p ptask) {
+  if (!ptask->in_task_list
+      || atomic_fetch_sub_int_least32_t(&ptask->refcnt, 1) == 1)
+    chpl_mem_free(ptask, 0, 0);
+}
+
+
+//
+// Find a task for an idle thread to run: first from its own deque,
+// newest first, then by stealing the oldest from the other threads,
+// starting with a randomly chosen one.
+//
+static task_pool_p find_task(thread_private_data_t* tp) {
+  task_pool_p ptask;
+  deque_registry_t* r;
+  int32_t n, start, i;
+
+  if (tp->deque != NULL) {
+    while ((ptask = deque_take(tp->deque)) != NULL) {
+      if (claim_task(ptask))
+        return ptask;
+    }
+  }
+
+  if ((n = atomic_load_int_least32_t(&num_deques)) == 0)
+    return NULL;
+  r = (deque_registry_t*) atomic_load_uintptr_t(&deque_registry);
+
+  tp->steal_seed = tp->steal_seed * 6364136223846793005ULL
+                   + 1442695040888963407ULL;
+  start = (int32_t) ((tp->steal_seed >> 33) % (uint64_t) n);
+
+  for (i = 0; i < n; i++) {
+    task_deque_t* victim = r->deques[(start + i) % n];
+
+    if (victim == tp->deque)
+      continue;
+
+    while ((ptask = deque_steal(victim)) != NULL) {
+      if (ptask != TASK_DEQUE_ABORT && claim_task(ptask))
+        return ptask;
+    }
+  }
+
+  return NULL;
+}
+
+
+//
+// Drop the entries at the bottom of my deque for tasks that have
+// already been run off a task list, so they don't hold on to memory.
+//
+static void trim_claimed_tasks(task_deque_t* d) {
+  task_pool_p ptask;
+
+  while ((ptask = deque_take(d)) != NULL) {
+    if (!ptask->in_task_list || !atomic_load_bool(&ptask->claimed)) {
+      deque_push(d, ptask);
+      return;
+    }
+    release_task(ptask);
+  }
+}
+
+
+static inline
+chpl_thread_mutex_t* task_list_lock(task_pool_p* p_task_list_head) {
+  uintptr_t h = (uintptr_t) p_task_list_head;
+  return &task_list_locks[((h >> 4) ^ (h >> 12)) % NUM_TASK_LIST_LOCKS];
+}
+
+
+//
+// Put a task in the pool, and on a task list if we're given one.
+// Returns whether there were already other tasks on that list.
+//
+static inline
+chpl_bool enqueue_task(task_pool_p ptask, task_pool_p* p_task_list_head) {
+  chpl_bool has_siblings = false;
+
+  if (p_task_list_head == NULL) {
+    ptask->in_task_list = false;
+    ptask->list_next = NULL;
+  }
+  else {
+    chpl_thread_mutex_t* lock = task_list_lock(p_task_list_head);
+
+    ptask->in_task_list = true;
+    atomic_init_bool(&ptask->claimed, false);
+    atomic_init_int_least32_t(&ptask->refcnt, 2);
+
+    // begin critical section
+    chpl_thread_mutexLock(lock);
+
+    ptask->list_next = *p_task_list_head;
+    *p_task_list_head = ptask;
+    has_siblings = (ptask->list_next != NULL);
+
+    // end critical section
+    chpl_thread_mutexUnlock(lock);
   }
+
+  (void) atomic_fetch_add_int_least32_t(&queued_task_cnt, 1);
+  deque_push(get_my_deque(get_thread_private_data()), ptask);
+
+  return has_siblings;
 }
 
 
@@ -634,14 +943,11 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
     return;
   }
 
-  // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
-
   if (task_list_locale == chpl_nodeID) {
-    (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
-                            false, false, false,
-                            (task_pool_p*) p_task_list_void, is_begin_stmt,
-                            lineno, filename);
+    add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
+                     false, false, false,
+                     (task_pool_p*) p_task_list_void, is_begin_stmt,
+                     lineno, filename);
 
   }
   else {
@@ -651,20 +957,20 @@ void chpl_task_addToTaskList(chpl_fn_int_t fid,
     // the context of a cobegin or coforall statement.
     //
     assert(is_begin_stmt);
-    (void) add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
-                            false, false, false,
-                            NULL, true, 0, CHPL_FILE_IDX_UNKNOWN);
+    add_to_task_pool(fid, chpl_ftable[fid], arg, arg_size,
+                     false, false, false,
+                     NULL, true, 0, CHPL_FILE_IDX_UNKNOWN);
   }
-
-  // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
 void chpl_task_executeTasksInList(void** p_task_list_void) {
   task_pool_p* p_task_list_head = (task_pool_p*) p_task_list_void;
+  chpl_thread_mutex_t* lock;
+  thread_private_data_t* tp;
   task_pool_p curr_ptask;
   task_pool_p child_ptask;
+  task_pool_p next_ptask;
 
   //
   // If we're serial, all the tasks have already been executed.
@@ -672,86 +978,89 @@ void chpl_task_executeTasksInList(void** p_task_list_void) {
   if (chpl_task_getSerial())
     return;
 
-  curr_ptask = get_current_ptask();
+  tp = get_thread_private_data();
+  curr_ptask = tp->ptask;
+  lock = task_list_lock(p_task_list_head);
 
   while (*p_task_list_head != NULL) {
-    chpl_fn_p task_to_run_fun = NULL;
+    //
+    // Take the whole list.  Tasks added to it while we're working
+    // through this part will be picked up on the next trip around.
+    //
 
     // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    chpl_thread_mutexLock(lock);
 
-    if ((child_ptask = *p_task_list_head) != NULL) {
-      task_to_run_fun = child_ptask->bundle.requested_fn;
-      dequeue_task(child_ptask);
-    }
+    child_ptask = *p_task_list_head;
+    *p_task_list_head = NULL;
 
     // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
-
-    if (task_to_run_fun == NULL)
-      continue;
-
-    set_current_ptask(child_ptask);
+    chpl_thread_mutexUnlock(lock);
 
-    // begin critical section
-    chpl_thread_mutexLock(&extra_task_lock);
+    for ( ; child_ptask != NULL; child_ptask = next_ptask) {
+      next_ptask = child_ptask->list_next;
 
-    extra_task_cnt++;
+      if (!claim_task(child_ptask))
+        continue;
 
-    // end critical section
-    chpl_thread_mutexUnlock(&extra_task_lock);
-
-    if (do_taskReport) {
-      chpl_thread_mutexLock(&taskTable_lock);
-      chpldev_taskTable_set_suspended(curr_ptask->bundle.id);
-      chpldev_taskTable_set_active(child_ptask->bundle.id);
-      chpl_thread_mutexUnlock(&taskTable_lock);
-    }
+      set_current_ptask(child_ptask);
 
-    if (blockreport)
-      initializeLockReportForThread();
+      (void) atomic_fetch_add_int_least64_t(&extra_task_cnt, 1);
 
-    chpl_task_do_callbacks(chpl_task_cb_event_kind_begin,
-                           child_ptask->bundle.requested_fid,
-                           child_ptask->bundle.filename,
-                           child_ptask->bundle.lineno,
-                           child_ptask->bundle.id,
-                           child_ptask->bundle.is_executeOn);
+      if (do_taskReport) {
+        chpl_thread_mutexLock(&taskTable_lock);
+        chpldev_taskTable_set_suspended(curr_ptask->bundle.id);
+        chpldev_taskTable_set_active(child_ptask->bundle.id);
+        chpl_thread_mutexUnlock(&taskTable_lock);
+      }
 
-    if (child_ptask->bundle.countRunning)
-        chpl_taskRunningCntInc(0, 0);
+      if (blockreport)
+        initializeLockReportForThread();
 
-    (*task_to_run_fun)(&child_ptask->bundle);
+      chpl_task_do_callbacks(chpl_task_cb_event_kind_begin,
+                             child_ptask->bundle.requested_fid,
+                             child_ptask->bundle.filename,
+                             child_ptask->bundle.lineno,
+                             child_ptask->bundle.id,
+                             child_ptask->bundle.is_executeOn);
 
-    if (child_ptask->bundle.countRunning)
-        chpl_taskRunningCntDec(0, 0);
+      if (child_ptask->bundle.countRunning)
+          chpl_taskRunningCntInc(0, 0);
 
-    chpl_task_do_callbacks(chpl_task_cb_event_kind_end,
-                           child_ptask->bundle.requested_fid,
-                           child_ptask->bundle.filename,
-                           child_ptask->bundle.lineno,
-                           child_ptask->bundle.id,
-                           child_ptask->bundle.is_executeOn);
+      (*child_ptask->bundle.requested_fn)(&child_ptask->bundle);
 
-    if (do_taskReport) {
-      chpl_thread_mutexLock(&taskTable_lock);
-      chpldev_taskTable_set_active(curr_ptask->bundle.id);
-      chpldev_taskTable_remove(child_ptask->bundle.id);
-      chpl_thread_mutexUnlock(&taskTable_lock);
-    }
+      chpl_mem_arena_taskEnd(&child_ptask->chpl_data.prvdata.mem_arena);
 
-    // begin critical section
-    chpl_thread_mutexLock(&extra_task_lock);
+      if (child_ptask->bundle.countRunning)
+          chpl_taskRunningCntDec(0, 0);
 
-    extra_task_cnt--;
+      chpl_task_do_callbacks(chpl_task_cb_event_kind_end,
+                             child_ptask->bundle.requested_fid,
+                             child_ptask->bundle.filename,
+                             child_ptask->bundle.lineno,
+                             child_ptask->bundle.id,
+                             child_ptask->bundle.is_executeOn);
 
-    // end critical section
-    chpl_thread_mutexUnlock(&extra_task_lock);
+      if (do_taskReport) {
+        chpl_thread_mutexLock(&taskTable_lock);
+        chpldev_taskTable_set_active(curr_ptask->bundle.id);
+        chpldev_taskTable_remove(child_ptask->bundle.id);
+        chpl_thread_mutexUnlock(&taskTable_lock);
+      }
 
-    set_current_ptask(curr_ptask);
-    chpl_mem_free(child_ptask, 0, 0);
+      (void) atomic_fetch_sub_int_least64_t(&extra_task_cnt, 1);
 
+      set_current_ptask(curr_ptask);
+      release_task(child_ptask);
+    }
   }
+
+  //
+  // The tasks we just ran are probably still sitting at the bottom of
+  // our own deque.
+  //
+  if (tp->deque != NULL)
+    trim_claimed_tasks(tp->deque);
 }
 
 
@@ -768,15 +1077,9 @@ void taskCallBody(chpl_fn_int_t fid, chpl_fn_p fp,
                   chpl_task_bundle_t* arg, size_t arg_size,
                   c_sublocid_t subloc, chpl_bool serial_state,
                   int lineno, int32_t filename) {
-  // begin critical section
-  chpl_thread_mutexLock(&threading_lock);
-
-  (void) add_to_task_pool(fid, fp, arg, arg_size,
-                          serial_state, canCountRunningTasks, true,
-                          NULL, false, lineno, filename);
-
-  // end critical section
-  chpl_thread_mutexUnlock(&threading_lock);
+  add_to_task_pool(fid, fp, arg, arg_size,
+                   serial_state, canCountRunningTasks, true,
+                   NULL, false, lineno, filename);
 }
 
 
@@ -890,14 +1193,22 @@ c_sublocid_t chpl_task_getNumSublocales(void) {
 }
 
 chpl_task_prvData_t* chpl_task_getPrvData(void) {
-  return & get_current_ptask()->chpl_data.prvdata;
+  thread_private_data_t* tp =
+    (thread_private_data_t*) chpl_thread_getPrivateData();
+
+  if (tp == NULL || tp->ptask == NULL)
+    return NULL;
+  return & tp->ptask->chpl_data.prvdata;
 }
 
 size_t chpl_task_getCallStackSize(void) {
   return chpl_thread_getCallStackSize();
 }
 
-uint32_t chpl_task_getNumQueuedTasks(void) { return queued_task_cnt; }
+uint32_t chpl_task_getNumQueuedTasks(void) {
+  int32_t cnt = atomic_load_int_least32_t(&queued_task_cnt);
+  return (cnt < 0) ? 0 : (uint32_t) cnt;
+}
 
 uint32_t chpl_task_getNumRunningTasks(void) {
   chpl_internal_error("chpl_task_getNumRunningTasks() called");
@@ -909,14 +1220,13 @@ int32_t  chpl_task_getNumBlockedTasks(void) {
     int numBlockedTasks;
 
     // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
     chpl_thread_mutexLock(&block_report_lock);
 
-    numBlockedTasks = blocked_thread_cnt - idle_thread_cnt;
+    numBlockedTasks = blocked_thread_cnt
+                      - atomic_load_int_least32_t(&idle_thread_cnt);
 
     // end critical section
     chpl_thread_mutexUnlock(&block_report_lock);
-    chpl_thread_mutexUnlock(&threading_lock);
 
     assert(numBlockedTasks >= 0);
     return numBlockedTasks;
@@ -932,15 +1242,7 @@ int32_t  chpl_task_getNumBlockedTasks(void) {
 // Get a new task ID.
 //
 static chpl_taskID_t get_next_task_id(void) {
-  static chpl_taskID_t       id = chpl_nullTaskID + 1;
-
-  chpl_taskID_t              next_id;
-
-  chpl_thread_mutexLock(&task_id_lock);
-  next_id = id++;
-  chpl_thread_mutexUnlock(&task_id_lock);
-
-  return next_id;
+  return atomic_fetch_add_uint_least64_t(&next_task_id, 1);
 }
 
 
@@ -1006,17 +1308,34 @@ static void report_locked_threads(void) {
 // pending tasks and those that are running.
 //
 static void report_all_tasks(void) {
-  task_pool_p pendingTask = task_pool_head;
+  deque_registry_t* r;
+  int32_t n, i;
 
   printf("Task report\n");
   printf("--------------------------------\n");
 
   // print out pending tasks
   printf("Pending tasks:\n");
-  while (pendingTask != NULL) {
-    printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
-           pendingTask->bundle.lineno);
-    pendingTask = pendingTask->next;
+  n = atomic_load_int_least32_t(&num_deques);
+  r = (deque_registry_t*) atomic_load_uintptr_t(&deque_registry);
+  for (i = 0; i < n; i++) {
+    task_deque_t* d = r->deques[i];
+    task_deque_buf_t* a = (task_deque_buf_t*) atomic_load_uintptr_t(&d->buf);
+    int64_t b = atomic_load_int_least64_t(&d->bottom);
+    int64_t t;
+
+    for (t = atomic_load_int_least64_t(&d->top); t < b; t++) {
+      task_pool_p pendingTask;
+
+      pendingTask = (task_pool_p)
+                    atomic_load_uintptr_t(&a->tasks[t & (a->size - 1)]);
+      if (pendingTask == NULL
+          || (pendingTask->in_task_list
+              && atomic_load_bool(&pendingTask->claimed)))
+        continue;
+      printf("- %s:%d\n", chpl_lookupFilename(pendingTask->bundle.filename),
+             pendingTask->bundle.lineno);
+    }
   }
   printf("\n");
 
@@ -1177,7 +1496,10 @@ thread_begin(void* ptask_void) {
                                                0, 0);
   chpl_thread_setPrivateData(tp);
 
+  tp->ptask = NULL;
   tp->lockRprt = NULL;
+  tp->deque = NULL;
+  tp->steal_seed = (uint64_t) (intptr_t) tp;
   if (blockreport)
     initializeLockReportForThread();
 
@@ -1196,7 +1518,7 @@ thread_begin(void* ptask_void) {
     // that were waiting on the signal, but since there was a performance
     // impact from keeping it as a hybrid as opposed to merely yielding,
     // it was decided that we would return to the simple yield case.
-    while (!task_pool_head) {
+    while (atomic_load_int_least32_t(&queued_task_cnt) <= 0) {
       if (set_block_loc(0, CHPL_FILE_IDX_IDLE_TASK)) {
         // all other tasks appear to be blocked
         struct timeval deadline, now;
@@ -1204,34 +1526,31 @@ thread_begin(void* ptask_void) {
         deadline.tv_sec += 1;
         do {
           chpl_thread_yield();
-          if (!task_pool_head)
+          if (atomic_load_int_least32_t(&queued_task_cnt) <= 0)
             gettimeofday(&now, NULL);
-        } while (!task_pool_head
+        } while (atomic_load_int_least32_t(&queued_task_cnt) <= 0
                  && (now.tv_sec < deadline.tv_sec
                      || (now.tv_sec == deadline.tv_sec
                          && now.tv_usec < deadline.tv_usec)));
-        if (!task_pool_head) {
+        if (atomic_load_int_least32_t(&queued_task_cnt) <= 0) {
           check_for_deadlock();
         }
       }
       else {
         do {
           chpl_thread_yield();
-        } while (!task_pool_head);
+        } while (atomic_load_int_least32_t(&queued_task_cnt) <= 0);
       }
 
       unset_block_loc();
     }
  
     //
-    // Just now the pool had at least one task in it.  Lock and see if
-    // there's something still there.
+    // Just now the pool had at least one task in it.  See if we can
+    // get one, either from our own deque or by stealing.
     //
-    chpl_thread_mutexLock(&threading_lock);
-    if (!task_pool_head) {
-      chpl_thread_mutexUnlock(&threading_lock);
+    if ((ptask = find_task(tp)) == NULL)
       continue;
-    }
 
     //
     // We've found a task to run.
@@ -1241,19 +1560,12 @@ thread_begin(void* ptask_void) {
       progress_cnt++;
 
     //
-    // start new task; increment running count and remove task from pool
-    // also add to task to task-table (structure in ChapelRuntime that keeps
-    // track of currently running tasks for task-reports on deadlock or
-    // Ctrl+C).
+    // start new task; increment running count.  Also add to task to
+    // task-table (structure in ChapelRuntime that keeps track of
+    // currently running tasks for task-reports on deadlock or Ctrl+C).
     //
-    ptask = task_pool_head;
-    idle_thread_cnt--;
-    running_task_cnt++;
-
-    dequeue_task(ptask);
-
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+    (void) atomic_fetch_sub_int_least32_t(&idle_thread_cnt, 1);
+    (void) atomic_fetch_add_int_least32_t(&running_task_cnt, 1);
 
     tp->ptask = ptask;
 
@@ -1275,6 +1587,8 @@ thread_begin(void* ptask_void) {
 
     (ptask->bundle.requested_fn)(&ptask->bundle);
 
+    chpl_mem_arena_taskEnd(&ptask->chpl_data.prvdata.mem_arena);
+
     if (ptask->bundle.countRunning)
         chpl_taskRunningCntDec(0, 0);
 
@@ -1292,20 +1606,14 @@ thread_begin(void* ptask_void) {
     }
 
     tp->ptask = NULL;
-    chpl_mem_free(ptask, 0, 0);
-
-    // begin critical section
-    chpl_thread_mutexLock(&threading_lock);
+    release_task(ptask);
 
     //
     // finished task; decrement running count and increment idle count
     //
-    assert(running_task_cnt > 0);
-    running_task_cnt--;
-    idle_thread_cnt++;
-
-    // end critical section
-    chpl_thread_mutexUnlock(&threading_lock);
+    assert(atomic_load_int_least32_t(&running_task_cnt) > 0);
+    (void) atomic_fetch_sub_int_least32_t(&running_task_cnt, 1);
+    (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
   }
 }
 
@@ -1335,9 +1643,19 @@ static void thread_end(void)
 static void maybe_add_thread(void) {
   static chpl_bool warning_issued = false;
 
-  if (!warning_issued && chpl_thread_canCreate()) {
+  // begin critical section
+  chpl_thread_mutexLock(&threading_lock);
+
+  //
+  // Another task may have started a thread for this work while we
+  // were waiting for the lock, so check again.
+  //
+  if (!warning_issued
+      && atomic_load_int_least32_t(&queued_task_cnt)
+         > atomic_load_int_least32_t(&idle_thread_cnt)
+      && chpl_thread_canCreate()) {
     if (chpl_thread_create(NULL) == 0) {
-      idle_thread_cnt++;
+      (void) atomic_fetch_add_int_least32_t(&idle_thread_cnt, 1);
     }
     else {
       int32_t max_threads = chpl_thread_getMaxThreads();
@@ -1357,26 +1675,29 @@ static void maybe_add_thread(void) {
       warning_issued = true;
     }
   }
+
+  // end critical section
+  chpl_thread_mutexUnlock(&threading_lock);
 }
 
 
 // create a task from the given function pointer and arguments
-// and append it to the end of the task pool
-// assumes threading_lock has already been acquired!
+// and push it onto the calling thread's deque
 static inline
-task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
-                             chpl_task_bundle_t* a, size_t a_size,
-                             chpl_bool serial_state,
-                             chpl_bool countRunningTasks,
-                             chpl_bool is_executeOn,
-                             task_pool_p* p_task_list_head,
-                             chpl_bool is_begin_stmt,
-                             int lineno, int32_t filename) {
+void add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
+                      chpl_task_bundle_t* a, size_t a_size,
+                      chpl_bool serial_state,
+                      chpl_bool countRunningTasks,
+                      chpl_bool is_executeOn,
+                      task_pool_p* p_task_list_head,
+                      chpl_bool is_begin_stmt,
+                      int lineno, int32_t filename) {
 
 
   size_t payload_size;
   task_pool_p ptask;
   chpl_task_prvDataImpl_t pv;
+  chpl_bool has_siblings;
 
   memset(&pv, 0, sizeof(pv));
 
@@ -1389,11 +1710,8 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
 
   memcpy(&ptask->bundle, a, a_size);
 
-  ptask->p_list_head            = NULL;
   ptask->list_next              = NULL;
-  ptask->list_prev              = NULL;
-  ptask->next                   = NULL;
-  ptask->prev                   = NULL;
+  ptask->in_task_list           = false;
   ptask->chpl_data              = pv;
   ptask->bundle.serial_state    = serial_state;
   ptask->bundle.countRunning    = countRunningTasks;
@@ -1405,8 +1723,10 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
   ptask->bundle.requested_fn    = fp;
   ptask->bundle.id              = get_next_task_id();
 
-  enqueue_task(ptask, p_task_list_head);
-
+  //
+  // Once the task is in the pool another thread may run and free it
+  // at any time, so do everything that refers to it beforehand.
+  //
   chpl_task_do_callbacks(chpl_task_cb_event_kind_create,
                          ptask->bundle.requested_fid,
                          ptask->bundle.filename,
@@ -1422,18 +1742,19 @@ task_pool_p add_to_task_pool(chpl_fn_int_t fid, chpl_fn_p fp,
     chpl_thread_mutexUnlock(&taskTable_lock);
   }
 
+  has_siblings = enqueue_task(ptask, p_task_list_head);
+
   //
   // If we now have more tasks than threads to run them on (taking
   // into account that the current parent of a structured parallel
   // construct can run at least one of that construct's children),
   // try to start another thread.
   //
-  if (queued_task_cnt > idle_thread_cnt &&
-      (p_task_list_head == NULL || ptask->list_next != NULL || is_begin_stmt)) {
+  if (atomic_load_int_least32_t(&queued_task_cnt)
+      > atomic_load_int_least32_t(&idle_thread_cnt) &&
+      (p_task_list_head == NULL || has_siblings || is_begin_stmt)) {
     maybe_add_thread();
   }
-
-  return ptask;
 }
 
 
@@ -1444,5 +1765,5 @@ uint32_t chpl_task_getNumThreads(void) {
 }
 
 uint32_t chpl_task_getNumIdleThreads(void) {
-  return idle_thread_cnt;
+  return atomic_load_int_least32_t(&idle_thread_cnt);
 }
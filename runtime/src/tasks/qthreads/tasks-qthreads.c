@@ -38,6 +38,7 @@
 #include "arg.h"
 #include "error.h"
 #include "chplcgfns.h"
+#include "chpl-cache.h"
 #include "chpl-comm.h"
 #include "chplexit.h"
 #include "chpl-locale-model.h"
@@ -187,13 +188,43 @@ static syncvar_t exit_ret = SYNCVAR_STATIC_EMPTY_INITIALIZER;
 
 static volatile chpl_bool canCountRunningTasks = false;
 
+//
+// With one worker per shepherd a yielding task comes back on the same
+// worker, so the remote cache only needs to check for a move when it
+// resumes.  With several workers per shepherd another worker may resume
+// it, so let the cache complete this pthread's PUTs first.  A task in
+// the middle of a cache operation must stay on this pthread, and these
+// schedulers can only pin a task to a shepherd, not to a worker, so in
+// that case just give up the CPU instead.
+//
+static inline void chpl_qt_yield(void)
+{
+    if (CHPL_QTHREAD_SCHEDULER_ONE_WORKER_PER_SHEPHERD) {
+        qthread_yield();
+        chpl_cache_task_resumed();
+    } else if (chpl_cache_task_may_migrate()) {
+        qthread_yield();
+        chpl_cache_task_resumed();
+    } else {
+        sched_yield();
+    }
+}
+
 void chpl_task_yield(void)
 {
     PROFILE_INCR(profile_task_yield,1);
     if (qthread_shep() == NO_SHEPHERD) {
         sched_yield();
     } else {
-        qthread_yield();
+        chpl_qt_yield();
+    }
+}
+
+void chpl_qthread_migrate_to(qthread_shepherd_id_t shep)
+{
+    if (chpl_cache_task_may_migrate()) {
+        qthread_migrate_to(shep);
+        chpl_cache_task_resumed();
     }
 }
 
@@ -221,12 +252,12 @@ void chpl_sync_lock(chpl_sync_aux_t *s)
 
     while (l != s->lockers_out) {
         uncontested_lock = false;
-        qthread_yield();
+        chpl_qt_yield();
     }
 
     if (uncontested_lock) {
         if ((++s->uncontested_locks & 0x5F) == 0) {
-            qthread_yield();
+            chpl_qt_yield();
         }
     }
 }
@@ -813,6 +844,8 @@ static aligned_t chapel_wrapper(void *arg)
 
     (bundle->requested_fn)(arg);
 
+    chpl_mem_arena_taskEnd(&tls->prvdata.mem_arena);
+
     wrap_callbacks(chpl_task_cb_event_kind_end, bundle);
 
     if (bundle->countRunning)
@@ -1070,7 +1103,7 @@ void chpl_task_sleep(double secs)
         qtimer_t t = qtimer_create();
         qtimer_start(t);
         do {
-            qthread_yield();
+            chpl_qt_yield();
             qtimer_stop(t);
         } while (qtimer_secs(t) < secs);
         qtimer_destroy(t);
@@ -0,0 +1,7 @@
+// Prints a value from a header on the -I path, so that changing the
+// header has to invalidate the cached program.
+require "externHeader.h";
+
+extern const HEADER_VALUE: c_int;
+
+writeln(HEADER_VALUE);
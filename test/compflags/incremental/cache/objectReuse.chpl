@@ -0,0 +1,7 @@
+// Prints a value from a module that the test changes between compiles,
+// so that only the generated files for that module have to be rebuilt.
+use ObjectReuseValue;
+
+proc main() {
+  writeln(value());
+}
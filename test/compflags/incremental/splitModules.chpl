@@ -0,0 +1,54 @@
+// With --incremental, the generated code is split into several
+// separately compiled files.  Use enough of the modules to need more
+// than one, with task functions, nested functions and dynamic dispatch
+// calling across them.
+use BlockDist, Sort;
+
+class Shape {
+  proc area(): real { return 0.0; }
+}
+
+class Square: Shape {
+  var side: real;
+  proc area(): real { return side * side; }
+}
+
+class Circle: Shape {
+  var r: real;
+  proc area(): real { return 3.0 * r * r; }
+}
+
+config const n = 100;
+
+proc sumOfSquares(m: int) {
+  var total = 0;
+
+  proc addSquare(i: int) {
+    total += i * i;
+  }
+
+  for i in 1..m do addSquare(i);
+  return total;
+}
+
+const D = {1..n} dmapped Block({1..n});
+var A: [D] int;
+
+forall i in D do A[i] = n + 1 - i;
+sort(A);
+writeln(A[1], " ", A[n], " ", + reduce A);
+
+var shapes: [1..2] Shape = [new Square(2.0): Shape, new Circle(1.0): Shape];
+var areas: [1..2] real;
+
+coforall i in 1..2 do areas[i] = shapes[i].area();
+writeln(areas);
+
+var x, y: int;
+cobegin with (ref x, ref y) {
+  x = sumOfSquares(10);
+  y = sumOfSquares(20);
+}
+writeln(x, " ", y);
+
+for s in shapes do delete s;
@@ -17,3 +17,8 @@ proc clearPrivatized(pid:int) {
   extern proc chpl_clearPrivatizedClass(pid:int);
   chpl_clearPrivatizedClass(pid);
 }
+
+proc numPrivatized(): int {
+  extern proc chpl_numPrivatizedClasses(): int;
+  return chpl_numPrivatizedClasses();
+}
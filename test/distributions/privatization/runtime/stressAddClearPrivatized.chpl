@@ -0,0 +1,48 @@
+use PrivatizationWrappers;
+use Time;
+
+//
+// Every task registers, reads back, and clears its own interleaved set
+// of pids, so all cores are growing the table and clearing entries at
+// the same time.  Later rounds use higher pids than earlier ones, as
+// when a program keeps creating and destroying distributed arrays.
+//
+
+config const rounds = 4;
+config const pidsPerTask = 10000;
+config const printTimings = false;
+
+proc main() {
+  const numTasks = here.maxTaskPar;
+  const pidsPerRound = numTasks * pidsPerTask;
+  var bad: atomic int;
+  var t: Timer;
+
+  t.start();
+  for r in 0..#rounds {
+    const base = r * pidsPerRound;
+    coforall tid in 0..#numTasks with (ref bad) {
+      for i in 0..#pidsPerTask {
+        const pid = base + i*numTasks + tid;
+        insertPrivatized(new C(pid), pid);
+      }
+      for i in 0..#pidsPerTask {
+        const pid = base + i*numTasks + tid;
+        var c = getPrivatized(pid);
+        if c.i != pid then bad.add(1);
+        delete c;
+        clearPrivatized(pid);
+      }
+    }
+  }
+  t.stop();
+
+  if printTimings then
+    writeln("privatized add+clear/sec: ", rounds * pidsPerRound / t.elapsed());
+
+  if bad.read() != 0 then
+    writeln(bad.read(), " privatized lookups returned the wrong object");
+  if numPrivatized() != 0 then
+    writeln(numPrivatized(), " privatized objects leaked");
+  writeln("OK");
+}
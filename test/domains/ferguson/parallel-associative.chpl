@@ -0,0 +1,81 @@
+config const timing = true;
+config const perf = false;
+config const correctness = false;
+config const n = 1000000;
+
+use Time;
+
+// Add, look up and remove n keys in a parSafe associative domain using
+// 1, 2, 4, ... tasks, checking the contents (and an array over the
+// domain, which has to survive the resizes) along the way.
+
+proc check(cond: bool, msg: string) {
+  if !cond then halt(msg);
+}
+
+var numTasks = 1;
+while numTasks <= here.maxTaskPar {
+  const size = if correctness then n / 10 else n;
+  var D: domain(int, parSafe=true);
+  var A: [D] int;
+  var found: atomic int;
+
+  var tAdd, tLookup, tRemove: Timer;
+
+  tAdd.start();
+  coforall tid in 0..#numTasks with (ref D) {
+    for i in tid..size-1 by numTasks {
+      D += i*7;
+    }
+  }
+  tAdd.stop();
+
+  check(D.size == size, "wrong size after adding");
+  forall i in D do A[i] = i + 1;
+
+  tLookup.start();
+  coforall tid in 0..#numTasks {
+    var myFound = 0;
+    for i in tid..2*size-1 by numTasks {
+      if D.member(i*7) then myFound += 1;
+    }
+    found.add(myFound);
+  }
+  tLookup.stop();
+
+  check(found.read() == size, "wrong number of members found");
+
+  tRemove.start();
+  coforall tid in 0..#numTasks with (ref D) {
+    for i in tid..size-1 by numTasks {
+      if i % 2 == 1 then D -= i*7;
+    }
+  }
+  tRemove.stop();
+
+  check(D.size == size - size/2, "wrong size after removing");
+  forall i in D do check(i % 14 == 0 && A[i] == i + 1, "wrong element");
+
+  if timing {
+    if perf {
+      // Report the serial run and the run using every core
+      for which in ("serial", "parallel") {
+        if (which == "serial" && numTasks == 1) ||
+           (which == "parallel" && numTasks*2 > here.maxTaskPar) {
+          writef("%s add: % 6.3r\n", which, tAdd.elapsed());
+          writef("%s lookup: % 6.3r\n", which, tLookup.elapsed());
+          writef("%s remove: % 6.3r\n", which, tRemove.elapsed());
+        }
+      }
+    } else {
+      writef("%i tasks: add % 6.3r lookup % 6.3r remove % 6.3r\n",
+             numTasks, tAdd.elapsed(), tLookup.elapsed(), tRemove.elapsed());
+    }
+  }
+
+  numTasks *= 2;
+}
+
+if perf || correctness {
+  writeln("SUCCESS");
+}
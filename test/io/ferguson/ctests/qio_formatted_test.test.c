@@ -699,6 +699,197 @@ void test_printscan_float(void)
 #undef NSTYLES
 }
 
+// What _ftoa_core printed for base 10 before it had its own conversion
+int printf_ftoa(char* buf, size_t buf_sz, double num,
+                int realfmt, int precision, int uppercase)
+{
+  char fmt[8];
+  char* f = fmt;
+  int got;
+
+  *f++ = '%';
+  *f++ = '.';
+  *f++ = '*';
+  if( realfmt == 0 ) *f++ = uppercase ? 'G' : 'g';
+  if( realfmt == 1 ) *f++ = uppercase ? 'F' : 'f';
+  if( realfmt == 2 ) *f++ = uppercase ? 'E' : 'e';
+  *f = '\0';
+
+  if( realfmt == 0 && precision < 0 && num >= 100000.0 && num < 1000000.0 ) {
+    // 6-digit integers are printed in exponential notation
+    // without trailing zeros
+    char* p;
+    int prec = 0;
+    fmt[3] = uppercase ? 'E' : 'e';
+    got = snprintf(buf, buf_sz, fmt, 5, num);
+    p = strchr(buf, '.');
+    for( int i = 1; p[i] != fmt[3]; i++ ) {
+      if( p[i] != '0' ) prec = i;
+    }
+    return snprintf(buf, buf_sz, fmt, prec, num);
+  }
+
+  return snprintf(buf, buf_sz, fmt, precision < 0 ? 6 : precision, num);
+}
+
+unsigned long long test_rand_state = 88172645463325252ULL;
+
+unsigned long long test_rand(void)
+{
+  // xorshift64
+  test_rand_state ^= test_rand_state << 13;
+  test_rand_state ^= test_rand_state >> 7;
+  test_rand_state ^= test_rand_state << 17;
+  return test_rand_state;
+}
+
+// Check that reals and integers print just as printf would print them,
+// for special values and many random ones in every base 10 format.
+void test_print_like_printf(void)
+{
+  qioerr err;
+  qio_file_t* f;
+  qio_channel_t* writing;
+  qio_channel_t* reading;
+  qio_style_t style;
+#define NNUMS 4000
+  double nums[NNUMS] = {0.0, -0.0, 1.0, 0.5, 0.125, 0.375, 2.5, 3.5, 0.05,
+                        1e-5, 1e-4, 0.0001234565, 99999.95, 100000.0,
+                        123456.5, 999999.4, 999999.5, 9.9999996, 9.5,
+                        1e15, 1e16, 1e17, 1e22, 1e23, 18446744073709551616.0,
+                        DBL_MAX, DBL_MIN, 4.9406564584124654e-324,
+                        2.2250738585072009e-308, 1.0/3.0, 2.0/3.0,
+                        HUGE_VAL, -HUGE_VAL, NAN};
+  int nspecial = 34;
+  double pow10[16] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+                      1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15};
+  int precisions[] = {-1, 0, 1, 2, 3, 6, 10, 15, 16, 17, 20, 40};
+  int nprecisions = sizeof(precisions)/sizeof(precisions[0]);
+  size_t max = 64 * NNUMS;
+  char* expect = qio_malloc(max);
+  char* got = qio_malloc(max);
+  size_t len;
+  ssize_t amt_read;
+  int i, realfmt, p, upper;
+
+  for( i = nspecial; i < NNUMS; i++ ) {
+    unsigned long long r = test_rand();
+    if( i % 4 == 0 ) {
+      // any bit pattern
+      memcpy(&nums[i], &r, sizeof(double));
+    } else if( i % 4 == 1 ) {
+      // a short decimal
+      nums[i] = (double) (r % 10000000) / pow10[(r >> 40) % 16];
+    } else {
+      // mostly somewhere in 1e-8..1e7
+      nums[i] = (double) (r % 1000000007) * 1e-17 * pow10[(r >> 40) % 16];
+      if( r & (1ULL << 62) ) nums[i] = -nums[i];
+    }
+  }
+
+  for( realfmt = 0; realfmt <= 2; realfmt++ ) {
+    for( p = 0; p < nprecisions; p++ ) {
+      for( upper = 0; upper <= 1; upper++ ) {
+        qio_style_init_default(&style);
+        style.showpointzero = 0;
+        style.realfmt = realfmt;
+        style.precision = precisions[p];
+        style.uppercase = upper;
+
+        err = qio_file_open_tmp(&f, 0, NULL);
+        assert(!err);
+
+        err = qio_channel_create(&writing, f, QIO_CH_BUFFERED, 0, 1, 0, INT64_MAX, &style);
+        assert(!err);
+
+        len = 0;
+        for( i = 0; i < NNUMS; i++ ) {
+          double num = nums[i];
+          // qio prints the sign itself, and no sign for nan
+          if( signbit(num) && !isnan(num) ) expect[len++] = '-';
+          len += printf_ftoa(&expect[len], max - len, fabs(num),
+                             realfmt, precisions[p], upper);
+          expect[len++] = '\n';
+          assert(len < max);
+
+          err = qio_channel_print_float(true, writing, &num, 8);
+          assert(!err);
+          err = qio_channel_write_amt(true, writing, "\n", 1);
+          assert(!err);
+        }
+
+        qio_channel_release(writing);
+
+        err = qio_channel_create(&reading, f, QIO_CH_BUFFERED, 1, 0, 0, INT64_MAX, &style);
+        assert(!err);
+
+        memset(got, 0, max);
+        err = qio_channel_read(true, reading, got, max, &amt_read);
+        assert(qio_err_to_int(err) == EEOF);
+        qio_channel_release(reading);
+        qio_file_release(f);
+
+        if( amt_read != len || memcmp(got, expect, len) != 0 ) {
+          size_t at = 0;
+          while( at < len && got[at] == expect[at] ) at++;
+          while( at > 0 && expect[at-1] != '\n' ) at--;
+          fprintf(stderr, "realfmt=%i precision=%i uppercase=%i\n",
+                  realfmt, precisions[p], upper);
+          fprintf(stderr, "Got    '%.*s'\n", (int) strcspn(&got[at], "\n"), &got[at]);
+          fprintf(stderr, "Expect '%.*s'\n", (int) strcspn(&expect[at], "\n"), &expect[at]);
+          assert(0);
+        }
+      }
+    }
+  }
+
+  // Integers in each base with a fast conversion
+  for( int b = 0; b < 4; b++ ) {
+    int bases[] = {10, 8, 16, 16};
+    const char* fmts[] = {"%llu\n", "%llo\n", "%llx\n", "%llX\n"};
+
+    qio_style_init_default(&style);
+    style.base = bases[b];
+    style.uppercase = (b == 3);
+    style.prefix_base = 0;
+
+    err = qio_file_open_tmp(&f, 0, NULL);
+    assert(!err);
+
+    err = qio_channel_create(&writing, f, QIO_CH_BUFFERED, 0, 1, 0, INT64_MAX, &style);
+    assert(!err);
+
+    len = 0;
+    for( i = 0; i < NNUMS; i++ ) {
+      unsigned long long num = test_rand() >> (i % 64);
+      len += snprintf(&expect[len], max - len, fmts[b], num);
+      err = qio_channel_print_int(true, writing, &num, 8, 0);
+      assert(!err);
+      err = qio_channel_write_amt(true, writing, "\n", 1);
+      assert(!err);
+    }
+
+    qio_channel_release(writing);
+
+    err = qio_channel_create(&reading, f, QIO_CH_BUFFERED, 1, 0, 0, INT64_MAX, &style);
+    assert(!err);
+
+    memset(got, 0, max);
+    err = qio_channel_read(true, reading, got, max, &amt_read);
+    assert(qio_err_to_int(err) == EEOF);
+    qio_channel_release(reading);
+    qio_file_release(f);
+
+    assert(amt_read == len && memcmp(got, expect, len) == 0);
+  }
+
+  qio_free(expect);
+  qio_free(got);
+
+  if( verbose ) printf("PASS: printing like printf\n");
+#undef NNUMS
+}
+
 void test_verybasic()
 {
 	qio_file_t *f = NULL;
@@ -1535,6 +1726,8 @@ int main(int argc, char** argv)
     test_quoted_string_maxlength();
   }
 
+  test_print_like_printf();
+
   printf("qio_formatted_test PASS\n");
 
   return 0;
@@ -0,0 +1,51 @@
+// Zipper the parallel lines of two different files. Small files are
+// read as one range each, so their lines line up. Large files are split
+// into byte ranges that hold different lines in each file, so zippering
+// them has to halt rather than pair up the wrong lines.
+
+use IO;
+
+config const n = 200000;
+
+proc writeLines(path, prefix, count) {
+  var f = open(path, iomode.cw);
+  var w = f.writer();
+  for i in 1..count do
+    w.writeln(prefix, i);
+  w.close();
+  f.close();
+}
+
+writeLines("lines-parallel-zip-a.txt", "a", 4);
+writeLines("lines-parallel-zip-b.txt", "b", 4);
+
+{
+  var f = open("lines-parallel-zip-a.txt", iomode.r);
+  var g = open("lines-parallel-zip-b.txt", iomode.r);
+  var numPairs, numMatched: atomic int;
+
+  forall (x, y) in zip(f.lines(), g.lines()) {
+    numPairs.add(1);
+    if x[2..] == y[2..] && x[1] == "a" && y[1] == "b" then
+      numMatched.add(1);
+  }
+  writeln("small: ", numMatched.read(), " of ", numPairs.read(),
+          " pairs line up");
+
+  f.close();
+  g.close();
+}
+
+writeLines("lines-parallel-zip-a.txt", "a", n);
+writeLines("lines-parallel-zip-b.txt", "bb", n);
+
+{
+  var f = open("lines-parallel-zip-a.txt", iomode.r);
+  var g = open("lines-parallel-zip-b.txt", iomode.r);
+
+  forall (x, y) in zip(f.lines(), g.lines()) do
+    if x[2..] != y[3..] then
+      writeln("mismatched: ", x.strip(), " ", y.strip());
+
+  writeln("large: should have halted");
+}
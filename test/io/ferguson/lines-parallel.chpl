@@ -0,0 +1,65 @@
+// Read the lines of a file in a forall loop, including lines that
+// span the byte ranges the file is split into, empty lines and a last
+// line without a newline. Each line must be read exactly once.
+
+use IO;
+
+config const n = 200000;
+config const path = "lines-parallel.txt";
+
+// Line i holds i, except that every 1000th line is empty
+proc lineFor(i) return if i % 1000 == 999 then "" else i:string;
+
+{
+  var f = open(path, iomode.cw);
+  var w = f.writer();
+  for i in 0..#n {
+    w.write(lineFor(i));
+    if i != n-1 then w.write("\n");
+  }
+  w.close();
+  f.close();
+}
+
+var f = open(path, iomode.r);
+var seen:[0..#n] atomic int;
+var numEmpty:atomic int;
+
+proc check(line:string) {
+  if line == "\n" then
+    numEmpty.add(1);
+  else
+    seen[line.strip():int].add(1);
+}
+
+forall line in f.lines() do check(line);
+
+var missing = 0, duplicated = 0;
+for i in 0..#n {
+  const expect = if lineFor(i) == "" then 0 else 1;
+  const got = seen[i].read();
+  if got < expect then missing += 1;
+  if got > expect then duplicated += 1;
+}
+
+writeln("standalone: ", missing, " missing, ", duplicated, " duplicated, ",
+        numEmpty.read(), " empty");
+
+// A region that starts and ends in the middle of lines
+const start = 100003, end = f.length() - 1234;
+var numRead:atomic int;
+var numSerial = 0;
+
+forall line in f.lines(start=start, end=end) do numRead.add(1);
+for line in f.lines(start=start, end=end) do numSerial += 1;
+
+writeln("region: ", numRead.read() == numSerial);
+
+// Zippered forall uses the leader and follower iterators. Lines only
+// line up with the lines of the same region.
+var numZip:atomic int;
+forall (a, b) in zip(f.lines(), f.lines()) do
+  if a == b then numZip.add(1);
+writeln("leader/follower: ", numZip.read());
+
+f.close();
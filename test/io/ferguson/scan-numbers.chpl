@@ -0,0 +1,116 @@
+/*
+ * Time reading text integers, reals and lines, which scan the channel
+ * buffer directly when a whole token is in it.  The file is large enough
+ * that tokens also straddle buffer boundaries and take the general path.
+ *
+ * Each pass checks what it reads against the values that were written.
+ */
+
+use IO, Time, FileSystem;
+
+config const n = 200000;        // values of each kind
+config const printTimes = false;
+
+const path = "scan-numbers.tmp";
+
+// Values with varied lengths, signs and exponents.  The reals are exact
+// in binary, so reading them back must give the same value.
+proc intValue(i: int) return (if i % 3 == 0 then -1 else 1) * (i * 7919) ** (i % 3);
+proc realValue(i: int) return (if i % 2 == 0 then -1.0 else 1.0) * i / 8.0 * 10.0 ** (i % 7);
+
+proc main() {
+  writeFile();
+
+  var t: Timer;
+
+  t.start();
+  const intsOK = readInts();
+  t.stop();
+  report("ints", t.elapsed(), intsOK);
+
+  t.clear();
+  t.start();
+  const realsOK = readReals();
+  t.stop();
+  report("reals", t.elapsed(), realsOK);
+
+  t.clear();
+  t.start();
+  const linesOK = readLines();
+  t.stop();
+  report("lines", t.elapsed(), linesOK);
+
+  remove(path);
+}
+
+proc report(pass, time, ok) {
+  if !ok then
+    writeln(pass, " read the wrong data");
+  else if printTimes then
+    writeln(pass, ": ", time);
+  else
+    writeln(pass, " ok");
+}
+
+// n ints on lines of 10, then n reals with %.12er formatting on lines of 10
+proc writeFile() {
+  var w = open(path, iomode.cw).writer(locking=false);
+
+  for i in 1..n {
+    w.write(intValue(i));
+    w.write(if i % 10 == 0 then "\n" else " ");
+  }
+  for i in 1..n {
+    w.writef("%.12er", realValue(i));
+    w.write(if i % 10 == 0 then "\n" else "\t");
+  }
+
+  w.close();
+}
+
+proc readInts() {
+  var r = open(path, iomode.r).reader(locking=false);
+  var ok = true;
+
+  for i in 1..n {
+    var x: int;
+    r.read(x);
+    if x != intValue(i) then ok = false;
+  }
+
+  r.close();
+  return ok;
+}
+
+proc readReals() {
+  var r = open(path, iomode.r).reader(locking=false);
+  var ok = true;
+  var x: int;
+
+  for i in 1..n do r.read(x);
+
+  for i in 1..n {
+    var y: real;
+    r.read(y);
+    if y != realValue(i) then ok = false;
+  }
+
+  r.close();
+  return ok;
+}
+
+// Lines keep their newlines, so together they are the whole file
+proc readLines() {
+  var f = open(path, iomode.r);
+  var r = f.reader(locking=false);
+  var line: string;
+  var count, size = 0;
+
+  while r.readline(line) {
+    count += 1;
+    size += line.length;
+  }
+
+  r.close();
+  return count == 2 * n / 10 && size == f.length();
+}
@@ -0,0 +1,97 @@
+/*
+ * Compare channels using io_uring (QIO_METHOD_URING) with channels
+ * using preadv/pwritev (QIO_METHOD_PREADPWRITE) for writing a file
+ * and for reading it sequentially and in strided regions.
+ *
+ * Each pass checks the data it reads, and each read pass reads a file
+ * written with the other method.
+ */
+
+use IO, Time, FileSystem;
+
+config const mb = 8;            // file size in megabytes
+config const chunk = 4096;      // bytes per readBytes/writeBytes call
+config const regionChunks = 64; // strided passes read 1 region in 4
+config const printTimes = false;
+
+const path = "uring-read.tmp";
+const size = mb * 1024 * 1024;
+const wordsPerChunk = chunk / 8;
+
+proc main() {
+  // Each method reads the file written with the other one
+  for (writeMethod, readMethod) in [(QIO_METHOD_URING, QIO_METHOD_PREADPWRITE),
+                                    (QIO_METHOD_PREADPWRITE, QIO_METHOD_URING)] {
+    var t: Timer;
+
+    t.start();
+    writeFile(writeMethod);
+    t.stop();
+    report(writeMethod, "write", t.elapsed(), true);
+
+    t.clear();
+    t.start();
+    const seqOK = readRegions(readMethod, size);
+    t.stop();
+    report(readMethod, "sequential", t.elapsed(), seqOK);
+
+    t.clear();
+    t.start();
+    const stridedOK = readRegions(readMethod, regionChunks * chunk);
+    t.stop();
+    report(readMethod, "strided", t.elapsed(), stridedOK);
+  }
+
+  remove(path);
+}
+
+proc report(method, pass, time, ok) {
+  const name = if method == QIO_METHOD_URING then "uring" else "preadv";
+
+  if !ok then
+    writeln(name, " ", pass, " read the wrong data");
+  else if printTimes then
+    writeln(name, " ", pass, ": ", time);
+  else
+    writeln(name, " ", pass, " ok");
+}
+
+// Word i of the file holds i
+proc writeFile(method) {
+  var f = open(path, iomode.cw, hints=method);
+  var w = f.writer(locking=false, hints=method);
+  var buf: [0..#wordsPerChunk] uint;
+
+  for off in 0..#size by chunk {
+    const first = (off / 8): uint;
+    for j in buf.domain do buf[j] = first + j:uint;
+    w.writeBytes(c_ptrTo(buf[0]), chunk);
+  }
+
+  w.close();
+  f.close();
+}
+
+// Read regions of regionSize bytes that start every 4*regionSize bytes,
+// or the whole file when regionSize is the file size.
+proc readRegions(method, regionSize) {
+  var f = open(path, iomode.r, hints=method);
+  var buf: [0..#wordsPerChunk] uint;
+  var ok = true;
+
+  const stride = if regionSize == size then size else 4 * regionSize;
+  for start in 0..#size by stride {
+    var r = f.reader(locking=false, start=start, end=start+regionSize,
+                     hints=method);
+    for off in start..#regionSize by chunk {
+      r.readBytes(c_ptrTo(buf[0]), chunk);
+      const first = (off / 8): uint;
+      for j in buf.domain do
+        if buf[j] != first + j:uint then ok = false;
+    }
+    r.close();
+  }
+
+  f.close();
+  return ok;
+}
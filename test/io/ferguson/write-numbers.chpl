@@ -0,0 +1,102 @@
+/*
+ * Time writing reals and integers as text: reals with the default
+ * format (as writeln(A) prints them), reals with enough digits to read
+ * back exactly, and integers.
+ *
+ * The exact reals and the integers are read back and checked. The C
+ * test ctests/qio_formatted_test checks the formats against printf.
+ */
+
+use IO, Time, FileSystem;
+
+config const n = 200000;        // values in each pass
+config const printTimes = false;
+
+const path = "write-numbers.tmp";
+
+proc realValue(i: int) {
+  const x = i * 0.6180339887498949, frac = x - floor(x);
+  return (if i % 2 == 0 then -frac else frac) * 10.0 ** (i % 13 - 4);
+}
+proc intValue(i: int) return (i * 0x9E3779B97F4A7C15:int) >> (i % 64);
+
+proc main() {
+  var t: Timer;
+
+  t.start();
+  writeReals("");
+  t.stop();
+  report("default reals", t.elapsed(), true);
+
+  t.clear();
+  t.start();
+  writeReals("%.16er");
+  t.stop();
+  report("exact reals", t.elapsed(), readReals());
+
+  t.clear();
+  t.start();
+  writeInts();
+  t.stop();
+  report("ints", t.elapsed(), readInts());
+
+  remove(path);
+}
+
+proc report(pass, time, ok) {
+  if !ok then
+    writeln(pass, " read the wrong data");
+  else if printTimes then
+    writeln(pass, ": ", time);
+  else
+    writeln(pass, " ok");
+}
+
+// With no format, write them as writeln does
+proc writeReals(fmt: string) {
+  var w = open(path, iomode.cw).writer(locking=false);
+  const fmtLine = fmt + "\n";
+
+  if fmt == "" then
+    for i in 1..n do w.writeln(realValue(i));
+  else
+    for i in 1..n do w.writef(fmtLine, realValue(i));
+
+  w.close();
+}
+
+proc writeInts() {
+  var w = open(path, iomode.cw).writer(locking=false);
+
+  for i in 1..n do w.writeln(intValue(i));
+
+  w.close();
+}
+
+proc readReals() {
+  var r = open(path, iomode.r).reader(locking=false);
+  var ok = true;
+
+  for i in 1..n {
+    var x: real;
+    r.read(x);
+    if x != realValue(i) then ok = false;
+  }
+
+  r.close();
+  return ok;
+}
+
+proc readInts() {
+  var r = open(path, iomode.r).reader(locking=false);
+  var ok = true;
+
+  for i in 1..n {
+    var x: int;
+    r.read(x);
+    if x != intValue(i) then ok = false;
+  }
+
+  r.close();
+  return ok;
+}
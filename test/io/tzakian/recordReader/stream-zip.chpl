@@ -0,0 +1,53 @@
+// Zipper parallel streams of records. A reader zippered with itself
+// follows its own byte ranges. Small files are read as one range, so
+// readers of different files line up too. Large files are split into
+// ranges holding different records in each file, so zippering two
+// readers of them has to halt rather than pair up the wrong records.
+
+use IO, RecordParser;
+
+record Item {
+  var key: string;
+  var value: int;
+}
+
+config const n = 100000;
+const pattern = "\\s*(\\w+) (\\d+)";
+
+proc writeItems(path, key, count) {
+  var f = open(path, iomode.cw);
+  var w = f.writer();
+  for i in 1..count do
+    w.writeln(key, " ", i);
+  w.close();
+  f.close();
+}
+
+proc zipped(pathA, pathB, count) {
+  writeItems(pathA, "a", count);
+  if pathB != pathA then
+    writeItems(pathB, "b", count);
+
+  var f = open(pathA, iomode.r);
+  var g = open(pathB, iomode.r);
+  var r = new RecordReader(Item, f.reader(), pattern);
+  var s = if pathB == pathA then r
+          else new RecordReader(Item, g.reader(), pattern);
+  var numPairs, numMatched: atomic int;
+
+  forall (x, y) in zip(r.stream(), s.stream()) {
+    numPairs.add(1);
+    if x.value == y.value then
+      numMatched.add(1);
+  }
+  writeln(numMatched.read(), " of ", numPairs.read(), " pairs line up");
+
+  if s != r then delete s;
+  delete r;
+  f.close();
+  g.close();
+}
+
+zipped("stream-zip-a.txt", "stream-zip-a.txt", n);
+zipped("stream-zip-a.txt", "stream-zip-b.txt", 4);
+zipped("stream-zip-a.txt", "stream-zip-b.txt", n);
@@ -0,0 +1,64 @@
+//
+// STREAM triad, run concurrently on each sublocale with arrays
+// allocated there, and then once over arrays allocated at the top
+// level of the locale.  With the NUMA-bound allocator arenas each
+// sublocale's arrays come from its own NUMA domain, so the per
+// sublocale bandwidths should add up to about the whole locale's.
+//
+use Time;
+
+config const m = 1 << 22;       // elements per array, per sublocale
+config const alpha = 3.0;
+config const numTrials = 10;
+config const printStats = false;
+
+const numSublocs = here.getChildCount();
+const numDomains = max(1, numSublocs);
+const bytesPerTriad = 3 * numBytes(real) * m;
+
+var bestTime: [0..#numDomains] real;
+var validated: [0..#numDomains] bool;
+
+coforall s in 0..#numDomains do
+  on (if numSublocs > 0 then here.getChild(s) else here) {
+    var A, B, C: [1..m] real;
+    B = 2.0;
+    C = 1.0;
+    bestTime[s] = triad(A, B, C);
+    validated[s] = && reduce (A == 2.0 + alpha * 1.0);
+  }
+
+{
+  const D = {1..m * numDomains};
+  var A, B, C: [D] real;
+  B = 2.0;
+  C = 1.0;
+  const wholeTime = triad(A, B, C);
+  const ok = && reduce (A == 2.0 + alpha * 1.0);
+
+  writeln("Validation: ", if ok && && reduce validated
+                          then "SUCCESS" else "FAILURE");
+
+  if printStats {
+    for s in 0..#numDomains do
+      writeln("Sublocale ", s, " bandwidth (GB/s) = ",
+              gbPerSec(bytesPerTriad, bestTime[s]));
+    writeln("Sum of sublocale bandwidths (GB/s) = ",
+            + reduce [t in bestTime] gbPerSec(bytesPerTriad, t));
+    writeln("Whole locale bandwidth (GB/s) = ",
+            gbPerSec(bytesPerTriad * numDomains, wholeTime));
+  }
+}
+
+proc triad(A, B, C) {
+  var best = max(real);
+  for 1..numTrials {
+    const start = getCurrentTime();
+    forall (a, b, c) in zip(A, B, C) do
+      a = b + alpha * c;
+    best = min(best, getCurrentTime() - start);
+  }
+  return best;
+}
+
+proc gbPerSec(bytes, secs) return bytes / secs * 1e-9;
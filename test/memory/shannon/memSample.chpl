@@ -0,0 +1,21 @@
+//
+// Sample every allocation with --memSampleRate=1, which makes the heap
+// profile printed at exit exact, and check the entries for the arrays
+// allocated here.
+//
+config const n = 10;
+
+class C {
+  var A: [1..500] real;
+}
+
+proc churn() {
+  for i in 1..n {
+    var A: [1..1000] int;       // freed at the end of each iteration
+    A[i] = i;
+  }
+}
+
+churn();
+var c = new C();                // leaked, so live at exit
+writeln(c.A.size);
@@ -0,0 +1,15 @@
+//
+// Sample one allocation per 4K bytes on average and check that the heap
+// profile's estimates for the arrays allocated here are close to their
+// actual total size and number.  See the .prediff for the check.
+//
+config const n = 20000;
+
+proc churn() {
+  for i in 1..n {
+    var A: [1..125] int;        // 1000 bytes of elements
+    A[1] = i;
+  }
+}
+
+churn();
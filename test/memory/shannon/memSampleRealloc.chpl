@@ -0,0 +1,17 @@
+//
+// Grow a string until its buffer has been reallocated many times, with
+// --memSampleRate=1 so that the heap profile printed at exit is exact.
+// A reallocated buffer is still one allocation, so its entry should
+// show one live and one total allocation, with the live bytes of the
+// final buffer.
+//
+config const n = 1000;
+
+class C {
+  var s: string;
+}
+
+var c = new C();                // leaked, so live at exit
+for i in 1..n do
+  c.s += "x";
+writeln(c.s.length);
@@ -0,0 +1,41 @@
+//
+// Allocate and free from many tasks at once with --memTrack, and check
+// that memoryUsed() accounts for every allocation exactly.
+//
+use Memory, Time;
+
+extern proc chpl_mem_allocMany(number, size, description, lineno=-1, filename=0): c_void_ptr;
+extern proc chpl_mem_free(ptr, lineno=-1, filename=0);
+
+config const n = 100000;
+config const printTimes = false;
+
+proc numWords(i) return (i % 100 + 1):uint;
+
+var ptrs: [1..n] c_void_ptr;
+const expected = + reduce [i in 1..n] numWords(i) * numBytes(int):uint;
+const odd = + reduce [i in 1..n by 2] numWords(i) * numBytes(int):uint;
+const start = memoryUsed();
+
+var t: Timer;
+t.start();
+
+forall i in 1..n do
+  ptrs[i] = chpl_mem_allocMany(numWords(i), numBytes(int), 0);
+const allocated = memoryUsed() - start == expected;
+
+forall i in 1..n by 2 do
+  chpl_mem_free(ptrs[i]);
+const halfFreed = memoryUsed() - start == expected - odd;
+
+forall i in 2..n by 2 do
+  chpl_mem_free(ptrs[i]);
+const allFreed = memoryUsed() == start;
+t.stop();
+
+// Print only after measuring, since writeln allocates the stdout buffer
+writeln("allocated: ", allocated);
+writeln("half freed: ", halfFreed);
+writeln("all freed: ", allFreed);
+if printTimes then
+  writeln("time: ", t.elapsed());
@@ -0,0 +1,56 @@
+//
+// Check that objects allocated by tasks using arenas stay valid after
+// those tasks end, that growing them moves them out of the arena
+// intact, and that everything is accounted for once they're freed.
+//
+use Memory;
+
+config const n = 10000;
+
+class C {
+  var x: int;
+}
+
+var escaped: [1..4*n] C;
+var grown: [1..4] string;
+
+const start = memoryUsed();
+
+coforall t in 1..4 {
+  useTaskArena();
+  useTaskArena();   // no effect the second time
+
+  for i in 1..n do
+    escaped[(t-1)*n + i] = new C((t-1)*n + i);
+
+  // Short-lived strings that die inside the task
+  var len = 0;
+  for i in 1..n do
+    len += ("item " + i:string).length;
+
+  // A string that keeps growing, and outlives the task
+  var s = "";
+  for i in 1..100 do
+    s += i:string;
+
+  grown[t] = s;
+  if len != 5*n + 38894 then
+    writeln("unexpected length ", len);
+}
+
+var sum = 0;
+for c in escaped do
+  sum += c.x;
+const sameStrings = && reduce [s in grown] s == grown[1];
+const grownLength = grown[1].length;
+
+for c in escaped do
+  delete c;
+grown = "";
+
+// Print only after measuring, since writeln allocates the stdout buffer
+const leftOver = memoryUsed() - start;
+writeln(sum == (4*n) * (4*n + 1) / 2);
+writeln(sameStrings);
+writeln(grownLength);
+writeln(leftOver);
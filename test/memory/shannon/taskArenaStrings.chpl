@@ -0,0 +1,38 @@
+//
+// Build short-lived strings in a forall loop, first with every
+// allocation going to the heap and then with each task using an arena.
+//
+use Memory, Time;
+
+config const n = 100000;
+config const printTimes = false;
+
+proc build(useArena: bool) {
+  var total = 0;
+  forall i in 1..n with (+ reduce total) {
+    if useArena then
+      useTaskArena();
+    const s = "item " + i:string + ": " + (3*i):string;
+    total += s.length;
+  }
+  return total;
+}
+
+var t: Timer;
+
+t.start();
+const heapTotal = build(useArena=false);
+t.stop();
+const heapTime = t.elapsed();
+
+t.clear();
+t.start();
+const arenaTotal = build(useArena=true);
+t.stop();
+const arenaTime = t.elapsed();
+
+writeln(heapTotal == arenaTotal);
+if printTimes {
+  writeln("heap: ", heapTime);
+  writeln("arena: ", arenaTime);
+}
@@ -0,0 +1,79 @@
+use Gather, BlockDist, CyclicDist, BlockCycDist;
+
+config const n = 100;
+
+const D = {1..n};
+const D2 = {1..n/10, 1..10};
+
+proc test(name, A: [], inds: []) {
+  const res = gather(A, inds);
+  var ok = res.domain == inds.domain;
+  for (r, i) in zip(res, inds) do
+    ok &&= r == A[i];
+
+  var res2: [inds.domain] A.eltType;
+  gather(res2, A, inds);
+  ok &&= && reduce (res2 == res);
+
+  writeln(name, ": ", if ok then "ok" else "FAILED");
+}
+
+proc fill(A: []) {
+  for (a, i) in zip(A, 1..) do
+    a = i * 10;
+}
+
+// Reversed and repeated 1-D indices, stored in Block arrays
+const I = D dmapped Block(boundingBox=D);
+var inds: [I] int;
+forall i in I do
+  inds[i] = if i % 3 == 0 then 1 else n+1-i;
+
+// 2-D indices, stored locally
+var inds2: [1..n] 2*int;
+for (x, i) in zip(inds2, 1..) do
+  x = (1 + (i*7) % (n/10), 1 + (i*3) % 10);
+
+{
+  var A: [D] int;
+  fill(A);
+  test("DR", A, inds);
+}
+{
+  var A: [D dmapped Block(boundingBox=D)] int;
+  fill(A);
+  test("Block", A, inds);
+}
+{
+  var A: [D dmapped Cyclic(startIdx=D.low)] int;
+  fill(A);
+  test("Cyclic", A, inds);
+}
+{
+  var A: [D dmapped BlockCyclic(startIdx=D.low, blocksize=7)] int;
+  fill(A);
+  test("BlockCyclic", A, inds);
+}
+{
+  var A: [D2 dmapped Block(boundingBox=D2)] real;
+  fill(A);
+  test("Block 2-D", A, inds2);
+}
+{
+  var A: [D2 dmapped Cyclic(startIdx=D2.low)] real;
+  fill(A);
+  test("Cyclic 2-D", A, inds2);
+}
+{
+  var A: [D2 dmapped BlockCyclic(startIdx=D2.low, blocksize=(2, 3))] real;
+  fill(A);
+  test("BlockCyclic 2-D", A, inds2);
+}
+{
+  // indices stored in a BlockCyclic array
+  const BCI = D dmapped BlockCyclic(startIdx=D.low, blocksize=4);
+  var bcInds: [BCI] int = inds;
+  var A: [D dmapped Block(boundingBox=D)] int;
+  fill(A);
+  test("BlockCyclic indices", A, bcInds);
+}
@@ -0,0 +1,45 @@
+//
+// Random gather from a Block-distributed array, done one element at a
+// time in a forall loop and in bulk with Gather.gather().
+//
+use Gather, BlockDist, Random, Time;
+
+config const n = 1 << 20;       // elements per locale
+config const numTrials = 3;
+config const printStats = false;
+
+const m = n * numLocales;
+const D = {0..#m} dmapped Block(boundingBox={0..#m});
+
+var A: [D] int;
+var inds: [D] int;
+var x1, x2: [D] int;
+
+forall (a, i) in zip(A, D) do
+  a = i;
+
+var rand: [D] real;
+fillRandom(rand, 314159265);
+forall (r, i) in zip(rand, inds) do
+  i = min((r * m): int, m-1);
+
+var eltTime, bulkTime = max(real);
+for 1..numTrials {
+  var start = getCurrentTime();
+  forall (x, i) in zip(x1, inds) do
+    x = A[i];
+  eltTime = min(eltTime, getCurrentTime() - start);
+
+  start = getCurrentTime();
+  gather(x2, A, inds);
+  bulkTime = min(bulkTime, getCurrentTime() - start);
+}
+
+writeln("Validation: ", if && reduce (x1 == inds) && && reduce (x2 == inds)
+                        then "SUCCESS" else "FAILURE");
+
+if printStats {
+  writeln("Element-wise gather time (s) = ", eltTime);
+  writeln("Bulk gather time (s) = ", bulkTime);
+  writeln("Speedup = ", eltTime / bulkTime);
+}
@@ -0,0 +1,187 @@
+/*
+ *  Check correctness of radixSort, sampleSort and the parallel paths of
+ *  sort() on local, strided, Block- and Cyclic-distributed arrays. Output
+ *  nothing if correct.
+ */
+
+use Sort;
+use Random;
+use BlockDist;
+use CyclicDist;
+
+config const n = 20000;
+
+proc main() {
+  const absKey = new AbsKeyCmp(),
+        absComp = new AbsCompCmp(),
+        revAbsKey = new ReverseComparator(absKey),
+        tupleKey = new TupleCmp();
+
+  // Element types radixSort handles
+  testRadix(int, defaultComparator);
+  testRadix(int(8), defaultComparator);
+  testRadix(uint(16), defaultComparator);
+  testRadix(uint, defaultComparator);
+  testRadix(real, defaultComparator);
+  testRadix(real(32), defaultComparator);
+
+  // Comparators radixSort handles
+  testRadix(int, reverseComparator);
+  testRadix(real, reverseComparator);
+  testRadix(int, absKey);
+  testRadix(int, revAbsKey);
+
+  // Comparators only sampleSort handles
+  testSample(int, absComp);
+  testSample(int, tupleKey);
+  testSample(string, defaultComparator);
+
+  // Data with few distinct values
+  {
+    var A: [1..n] int;
+    fillRandom(A, seed=17);
+    A = abs(A) % 3;
+    check(A, "radixSort", "few values", defaultComparator);
+    check(A, "sampleSort", "few values", defaultComparator);
+  }
+
+  // Already sorted and tiny arrays
+  for size in (0, 1, 2, 1000, n) {
+    var A: [1..size] int = 1..size;
+    check(A, "radixSort", "presorted", defaultComparator);
+    check(A, "sampleSort", "presorted", defaultComparator);
+  }
+
+  // radixSort is stable
+  {
+    var A: [1..n] (int, int);
+    var Keys: [1..n] int;
+    fillRandom(Keys, seed=23);
+    for i in 1..n do A[i] = (abs(Keys[i]) % 100, i);
+    radixSort(A, comparator=new FirstCmp());
+    for i in 1..n-1 do
+      if A[i](1) == A[i+1](1) && A[i](2) > A[i+1](2) {
+        writeln("radixSort is not stable");
+        break;
+      }
+  }
+}
+
+proc testRadix(type eltType, cmp) {
+  testOne(eltType, cmp, "radixSort");
+  testOne(eltType, cmp, "sampleSort");
+  testOne(eltType, cmp, "sort");
+}
+
+proc testSample(type eltType, cmp) {
+  testOne(eltType, cmp, "sampleSort");
+  testOne(eltType, cmp, "sort");
+}
+
+/* Sort random data of eltType in a local array, and for ints also in
+   strided, Block and Cyclic arrays */
+proc testOne(type eltType, cmp, param sortName: string) {
+  var Data: [1..n] eltType;
+  fillData(Data);
+
+  {
+    var A = Data;
+    check(A, sortName, "local", cmp);
+  }
+  if eltType == int {
+    {
+      var A: [1..2*n by 2] eltType = Data;
+      check(A, sortName, "strided", cmp);
+    }
+    {
+      var A: [2..2*n by -2] eltType = Data;
+      check(A, sortName, "reverse strided", cmp);
+    }
+    {
+      const D = {1..n} dmapped Block({1..n});
+      var A: [D] eltType = Data;
+      check(A, sortName, "Block", cmp);
+    }
+    {
+      const D = {1..2*n by 2} dmapped Block({1..2*n});
+      var A: [D] eltType = Data;
+      check(A, sortName, "strided Block", cmp);
+    }
+    {
+      const D = {0..n+1} dmapped Block({0..n+1});
+      var A: [D] eltType;
+      A[1..n] = Data;
+      check(A[1..n], sortName, "sliced Block", cmp);
+    }
+    {
+      const D = {1..n} dmapped Cyclic(startIdx=1);
+      var A: [D] eltType = Data;
+      check(A, sortName, "Cyclic", cmp);
+    }
+  }
+}
+
+/* Sort A and compare the result against quickSort */
+proc check(A, param sortName: string, desc: string, cmp) {
+  var Expected: [1..A.size] A.eltType = A;
+  quickSort(Expected, comparator=cmp);
+
+  if sortName == "radixSort" then
+    radixSort(A, comparator=cmp);
+  else if sortName == "sampleSort" then
+    sampleSort(A, comparator=cmp);
+  else
+    sort(A, comparator=cmp);
+
+  const eltType = A.eltType:string;
+  if !isSorted(A, comparator=cmp) then
+    writeln(sortName, " failed to sort ", desc, " ", eltType, " array");
+  else {
+    // Sorting must not lose or duplicate elements. Comparators that
+    // consider different elements equal only allow checking the keys.
+    const D = A.domain.dim(1),
+          stride = if A.domain.stridable then abs(D.stride) else 1;
+    for (i, e) in zip(D.alignedLow..D.alignedHigh by stride, Expected) {
+      if chpl_compare(A[i], e, cmp) != 0 {
+        writeln(sortName, " changed the elements of ", desc, " ", eltType,
+                " array");
+        break;
+      }
+    }
+  }
+}
+
+proc fillData(A: [] ?t) where isNumericType(t) {
+  var R: [A.domain] int;
+  fillRandom(R, seed=42);
+  if isRealType(t) then
+    A = ((R:real / max(int)) * 1e10):t;
+  else
+    A = R:t;
+}
+
+proc fillData(A: [] string) {
+  var R: [A.domain] int;
+  fillRandom(R, seed=42);
+  A = (R % 1000000):string;
+}
+
+/* Key Sort by absolute value */
+record AbsKeyCmp {
+  proc key(a) { return abs(a); }
+}
+
+/* Compare Sort by absolute value */
+record AbsCompCmp {
+  proc compare(a, b) { return abs(a) - abs(b); }
+}
+
+/* Key method returning a non-numeric type */
+record TupleCmp {
+  proc key(a) { return (a % 7, a); }
+}
+
+/* Sort tuples by their first element only */
+record FirstCmp {
+  proc key(a) { return a(1); }
+}
@@ -11,7 +11,9 @@ use Time;
 
 config const M: int = 6,                    // 2**M bytes
              correctness: bool = true,      // Disables output
-             sorts: string = 'qhims';       // Sorts to use (first letter)
+             sorts: string = 'qhimsrpd';    // Sorts to use (first letter,
+                                            // 'p' for sampleSort and 'd' for
+                                            // the default sort())
 
 // Array properties
 config type T = int;                // Type of array
@@ -107,6 +109,42 @@ proc gatherTimings(const ref A) {
       print('selectionSort (seconds): ', t.elapsed());
     t.clear();
   }
+  if sorts.find('r')
+  {
+    var B = A;
+    t.start();
+    radixSort(B);
+    t.stop();
+    if !isSorted(B) then
+      writeln('radixSort failed to sort data');
+    else
+      print('radixSort (seconds): ', t.elapsed());
+    t.clear();
+  }
+  if sorts.find('p')
+  {
+    var B = A;
+    t.start();
+    sampleSort(B);
+    t.stop();
+    if !isSorted(B) then
+      writeln('sampleSort failed to sort data');
+    else
+      print('sampleSort (seconds): ', t.elapsed());
+    t.clear();
+  }
+  if sorts.find('d')
+  {
+    var B = A;
+    t.start();
+    sort(B);
+    t.stop();
+    if !isSorted(B) then
+      writeln('sort failed to sort data');
+    else
+      print('sort (seconds): ', t.elapsed());
+    t.clear();
+  }
   if sorts.find('b')
   {
     var B = A;
@@ -266,6 +266,57 @@ config const verbose=false;
   assertEqual(dot(v13, v31), S, "dot(Matrix(1, 3), Matrix(3, 1))");
 }
 
+/* dot - native and Block-distributed matrix multiplication */
+{
+  use BlockDist;
+
+  proc refMatMult(A: [?Adom] ?t, B: [?Bdom] t) {
+    var C: [Adom.dim(1), Bdom.dim(2)] t;
+    for (i, j) in C.domain do
+      for (k, l) in zip(Adom.dim(2), Bdom.dim(1)) do
+        C[i, j] += A[i, k]*B[l, j];
+    return C;
+  }
+
+  proc refMatVecMult(A: [?Adom] ?t, X: [?Xdom] t) {
+    var Y: [Adom.dim(1)] t;
+    for i in Adom.dim(1) do
+      for (k, l) in zip(Adom.dim(2), Xdom.dim(1)) do
+        Y[i] += A[i, k]*X[l];
+    return Y;
+  }
+
+  proc test_matmat(type t, m, n, p) {
+    // Sizes that don't fill the tiles, and indices that don't start at 0
+    var A: [1..m, 0..#p] t, B: [3..#p, 2..#n] t;
+    for (i, j) in A.domain do A[i, j] = ((i*7 + j*3) % 11 - 5): t;
+    for (i, j) in B.domain do B[i, j] = ((i*5 + j*2) % 13 - 6): t;
+
+    const C = refMatMult(A, B);
+    assertEqual(dot(A, B), C, "dot(A, B) " + m + "x" + p + "x" + n);
+
+    const DA = {A.domain.dim(1), A.domain.dim(2)}
+                 dmapped Block(boundingBox=A.domain);
+    const DB = {B.domain.dim(1), B.domain.dim(2)}
+                 dmapped Block(boundingBox=B.domain);
+    var BA: [DA] t = A, BB: [DB] t = B;
+    const BC = dot(BA, BB);
+    assertTrue(BC.domain == C.domain, "dot(Block, Block).domain");
+    assertTrue(&& reduce (BC == C), "dot(Block, Block) " + m + "x" + p + "x" + n);
+
+    var X: [5..#p] t;
+    for i in X.domain do X[i] = (i % 7 - 3): t;
+    assertEqual(dot(A, X), refMatVecMult(A, X), "dot(A, X)");
+    var AT = transpose(A);
+    assertEqual(dot(X, AT), refMatVecMult(A, X), "dot(X, A.T)");
+  }
+
+  for (m, n, p) in [(1, 1, 1), (3, 5, 7), (67, 65, 130), (130, 3, 261)] {
+    test_matmat(int, m, n, p);
+    test_matmat(real, m, n, p);
+  }
+}
+
 /* outer */
 {
   var v = Vector(3);
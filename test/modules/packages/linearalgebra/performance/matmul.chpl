@@ -0,0 +1,81 @@
+//
+// Matrix multiplication with LinearAlgebra.dot, compared with the
+// naive algorithm it used to have.  Integer matrices go through the
+// native cache-blocked multiply, real matrices through BLAS gemm, and
+// Block-distributed real matrices through the distributed multiply.
+//
+use LinearAlgebra, BlockDist, Time;
+
+config const n = 512;
+config const numTrials = 3;
+config const printStats = false;
+config const doNaive = true;
+
+const D = {0..#n, 0..#n};
+const BD = D dmapped Block(boundingBox=D);
+
+var ok = true;
+
+proc fill(ref A: [?D]) {
+  forall (i, j) in D do
+    A[i, j] = ((i*7 + j*3) % 11 - 5): A.eltType;
+}
+
+proc naiveMatMult(A: [?Adom] ?t, B: [?Bdom] t) {
+  var C: [Adom.dim(1), Bdom.dim(2)] t;
+  forall (i, j) in C.domain do
+    C[i, j] = + reduce (A[i, ..]*B[.., j]);
+  return C;
+}
+
+proc run(name, A, B) {
+  var best = max(real);
+  var C: [A.domain] A.eltType;
+  for 1..numTrials {
+    const start = getCurrentTime();
+    C = dot(A, B);
+    best = min(best, getCurrentTime() - start);
+  }
+
+  var naiveBest = max(real);
+  if doNaive {
+    var refC: [D] A.eltType;
+    for 1..numTrials {
+      const start = getCurrentTime();
+      refC = naiveMatMult(A, B);
+      naiveBest = min(naiveBest, getCurrentTime() - start);
+    }
+    ok &&= && reduce (C == refC);
+  }
+
+  if printStats {
+    writeln(name, " GFLOP/s = ", gflops(best));
+    if doNaive then
+      writeln(name, " naive GFLOP/s = ", gflops(naiveBest));
+  }
+}
+
+proc gflops(secs) return 2.0 * n**3 / secs * 1e-9;
+
+{
+  var A, B: [D] int;
+  fill(A);
+  fill(B);
+  run("int", A, B);
+}
+
+{
+  var A, B: [D] real;
+  fill(A);
+  fill(B);
+  run("real", A, B);
+}
+
+{
+  var A, B: [BD] real;
+  fill(A);
+  fill(B);
+  run("Block real", A, B);
+}
+
+writeln("Validation: ", if ok then "SUCCESS" else "FAILURE");
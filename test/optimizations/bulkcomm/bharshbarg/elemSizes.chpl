@@ -0,0 +1,60 @@
+//
+// Strided assignments between arrays whose elements are 1, 2, 4, 8, 16
+// and 24 bytes, in up to 6 dimensions, checked element by element.
+//
+
+record triple {
+  var a, b, c : int;
+}
+
+proc toElt(type t, x : int) : t {
+  if t == triple then return new triple(x, -x, 2*x);
+  else if isComplexType(t) then return (x + 0.5*x*1.0i) : t;
+  else return (x % 100) : t;
+}
+
+proc check(type t, ref A : [?AD] t, ref B : [?BD] t, left, right) {
+  for (b, k) in zip(B, 1..) do b = toElt(t, k);
+  forall a in A do a = toElt(t, -1);
+
+  A[left] = B[right];
+
+  var expected : [AD] t = toElt(t, -1);
+  for (l, r) in zip(left, right) do expected[l] = B[r];
+
+  if && reduce (A == expected) then
+    writeln("ok: ", t:string, " ", left, " = ", right);
+  else
+    writeln("FAILED: ", t:string, " ", left, " = ", right);
+}
+
+proc testType(type t) {
+  {
+    var A, B : [1..20] t;
+    check(t, A, B, {1..20 by 2}, {2..20 by 2});
+    check(t, A, B, {1..10}, {11..20});
+  }
+  {
+    var A, B : [1..8, 1..12] t;
+    check(t, A, B, {1..8, 1..10 by 3}, {1..8, 3..12 by 3});
+    check(t, A, B, {1..8 by 2, 1..12}, {1..4, 1..12});
+    check(t, A, B, {1..8, 1..6}, {1..8, 7..12});
+  }
+  {
+    var A, B : [1..4, 1..5, 1..6] t;
+    check(t, A, B, {1..4 by 2, 1..5, 1..6 by 2}, {3..4, 1..5, 2..6 by 2});
+    check(t, A, B, {1..4, 2..3, 1..6}, {1..4, 4..5, 1..6});
+  }
+  {
+    var A, B : [1..3, 1..2, 1..3, 1..2, 1..3, 1..4] t;
+    check(t, A, B, {1..3, 1..2, 1..3 by 2, 1..2, 1..3, 1..4 by 2},
+                   {1..3, 1..2, 2..3, 1..2, 1..3, 3..4});
+  }
+}
+
+testType(int(8));
+testType(int(16));
+testType(int(32));
+testType(int(64));
+testType(complex(128));
+testType(triple);
@@ -0,0 +1,45 @@
+// Exercise a non-default cache geometry (see geometry.execenv):
+// sequential, reverse and strided reads and writes of remote data.
+config const n = 40000;
+config const stride = 37;
+
+proc doit(memory:locale, running:locale) {
+  on memory {
+    var A:[1..n] int;
+    for i in 1..n {
+      A[i] = i;
+    }
+    on running {
+      // sequential read, enough to trigger readahead
+      for i in 1..n {
+        assert(A[i] == i);
+      }
+      // reverse read
+      for i in 1..n by -1 {
+        assert(A[i] == i);
+      }
+      // strided read
+      for i in 1..n by stride {
+        assert(A[i] == i);
+      }
+      // sequential write followed by readback
+      for i in 1..n {
+        A[i] = 2*i;
+      }
+      for i in 1..n {
+        assert(A[i] == 2*i);
+      }
+      // strided write
+      for i in 1..n by stride {
+        A[i] = -i;
+      }
+    }
+    for i in 1..n {
+      if (i-1) % stride == 0 then assert(A[i] == -i);
+      else assert(A[i] == 2*i);
+    }
+  }
+}
+
+doit(Locales[0], Locales[1]);
+writeln("OK");
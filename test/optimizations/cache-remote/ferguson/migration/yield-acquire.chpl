@@ -0,0 +1,37 @@
+//
+// A consumer that spins with chpl_task_yield() may move between worker
+// threads while it waits.  Data it pulled into one thread's cache before
+// moving must not be reused after the producer publishes new values, and
+// the producer's writes must not be stranded in the cache of the thread
+// it left.
+//
+extern proc chpl_task_yield();
+
+config const rounds = 200;
+config const n = 64;
+
+var data: [0..#n] int;
+var flag: atomic int;
+
+on Locales[numLocales-1] {
+  cobegin {
+    // producer
+    for r in 1..rounds {
+      while flag.read() != 2*r - 2 do chpl_task_yield();
+      for i in 0..#n do data[i] = r;
+      chpl_task_yield();
+      flag.write(2*r - 1);
+    }
+
+    // consumer
+    for r in 1..rounds {
+      while flag.read() != 2*r - 1 do chpl_task_yield();
+      for i in 0..#n do
+        if data[i] != r then
+          halt("round ", r, ": data[", i, "] is ", data[i]);
+      flag.write(2*r);
+    }
+  }
+}
+
+writeln("OK");
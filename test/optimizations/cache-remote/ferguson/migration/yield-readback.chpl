@@ -0,0 +1,32 @@
+//
+// Tasks that yield while using remote data may be resumed on a different
+// worker thread.  Each task writes remote elements, yields, and reads its
+// writes back.  The readback and the final values must be coherent even
+// when the write is still pending in another thread's cache.
+//
+extern proc chpl_task_yield();
+
+config const n = 1000;
+config const tasksPerLocale = 4 * here.maxTaskPar;
+config const yields = 4;
+
+var A: [1..n*tasksPerLocale] int;
+
+on Locales[numLocales-1] {
+  coforall t in 0..#tasksPerLocale {
+    for i in 1..n {
+      const idx = t*n + i;
+      A[idx] = idx;
+      for j in 1..yields do chpl_task_yield();
+      if A[idx] != idx then
+        halt("task ", t, " read back ", A[idx], " for A[", idx, "]");
+      A[idx] += 1;
+    }
+  }
+}
+
+for (a, i) in zip(A, A.domain) do
+  if a != i + 1 then
+    halt("A[", i, "] is ", a, ", expected ", i + 1);
+
+writeln("OK");
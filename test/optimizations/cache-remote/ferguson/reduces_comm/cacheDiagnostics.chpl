@@ -0,0 +1,44 @@
+// Check that the remote cache counters reported by CommDiagnostics
+// reflect a sequential read and a write of remote data.
+use CommDiagnostics;
+
+config const n = 100000;
+
+var A:[1..n] int;
+
+for i in 1..n {
+  A[i] = i;
+}
+
+on Locales[1] {
+  resetCacheDiagnosticsHere();
+
+  var sum = 0;
+  for i in 1..n {
+    sum += A[i];
+  }
+  assert(sum == n*(n+1)/2);
+
+  var cd = getCacheDiagnosticsHere();
+  // Sequential reads should mostly hit in the cache, thanks to readahead.
+  assert(cd.get_hits > cd.get_misses);
+  assert(cd.prefetches > 0);
+  assert(cd.prefetch_hits > 0);
+  assert(cd.dirty_flushes == 0);
+
+  for i in 1..n {
+    A[i] = -i;
+  }
+
+  cd = getCacheDiagnosticsHere();
+  assert(cd.dirty_flushes > 0);
+}
+
+for i in 1..n {
+  assert(A[i] == -i);
+}
+
+// Locale 0 did not access remote data through its cache.
+const D = getCacheDiagnostics();
+assert(D[0].get_hits == 0 && D[0].get_misses == 0);
+writeln("OK");
@@ -0,0 +1,55 @@
+use Time;
+
+//
+// Spawn/join throughput as the number of tasks doing the spawning
+// grows.  Each spawner repeatedly runs a small coforall and waits for
+// it, so the tasking layer sees many concurrent creators and joiners
+// at once.  That is where a single shared task pool falls over.
+//
+
+config const joinsPerSpawner = 2000;
+config const fanout = 4;
+config const printTimings = false;
+
+proc main() {
+  const maxSpawners = here.maxTaskPar;
+  var numSpawners = 1;
+  var ok = true;
+
+  while numSpawners <= maxSpawners {
+    const (ran, rate) = spawnJoin(numSpawners);
+    ok &&= ran == numSpawners * joinsPerSpawner * fanout;
+
+    if printTimings {
+      if numSpawners == 1 then
+        writeln("single spawner tasks/sec: ", rate);
+      writeln(numSpawners, " spawners tasks/sec: ", rate);
+    }
+
+    if numSpawners == maxSpawners then break;
+    numSpawners = min(2 * numSpawners, maxSpawners);
+  }
+
+  if printTimings then
+    writeln("maxTaskPar spawners tasks/sec: ",
+            spawnJoin(maxSpawners)(2));
+
+  writeln(if ok then "all tasks ran" else "some tasks did not run");
+}
+
+proc spawnJoin(numSpawners) {
+  var ran: atomic int;
+  var t: Timer;
+
+  t.start();
+  coforall 1..numSpawners {
+    for 1..joinsPerSpawner {
+      coforall 1..fanout do
+        ran.add(1);
+    }
+  }
+  t.stop();
+
+  const numTasks = numSpawners * joinsPerSpawner * fanout;
+  return (ran.read(), numTasks / t.elapsed());
+}
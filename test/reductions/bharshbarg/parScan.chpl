@@ -0,0 +1,121 @@
+//
+// Scans of 1-D arrays run in parallel, block by block.  Check them
+// against serial loops for the built-in operators and for user-defined
+// ones, over local, strided and distributed arrays.
+//
+use BlockDist, CyclicDist;
+
+config const n = 1000;
+
+// Not commutative: the result is the last element seen so far.
+class lastOp: ReduceScanOp {
+  type eltType;
+  var value: eltType;
+  proc accumulate(x) { value = x; }
+  proc combine(x) { if x.numSeen > 0 then value = x.value; numSeen += x.numSeen; }
+  var numSeen = 0;
+  proc generate() return value;
+  proc clone() return new lastOp(eltType=eltType);
+}
+
+// Counts the elements so far that are greater than the previous one.
+// It has no clone(), so scans with it stay serial.
+class ascentsOp: ReduceScanOp {
+  type eltType;
+  var count = 0;
+  var prev = min(eltType);
+  var first = true;
+  proc accumulate(x) {
+    if !first && x > prev then count += 1;
+    first = false;
+    prev = x;
+  }
+  proc combine(x) { halt("unexpected combine"); }
+  proc generate() return count;
+}
+
+proc test(name, A) {
+  var expectSum: [A.domain] int, expectMax: [A.domain] int,
+      expectMin: [A.domain] int, expectXor: [A.domain] int;
+  var sum, xor = 0, mx = min(int), mn = max(int);
+  for (a, s, x, mxe, mne) in zip(A, expectSum, expectXor,
+                                 expectMax, expectMin) {
+    sum += a; s = sum;
+    xor ^= a; x = xor;
+    mx = max(mx, a); mxe = mx;
+    mn = min(mn, a); mne = mn;
+  }
+
+  check(name, "+", + scan A, expectSum);
+  check(name, "^", ^ scan A, expectXor);
+  check(name, "max", max scan A, expectMax);
+  check(name, "min", min scan A, expectMin);
+  check(name, "last", lastOp scan A, A);
+  writeln(name, ": done");
+}
+
+proc check(name, opName, res, expect) {
+  if ! && reduce (res == expect) then
+    writeln(name, ": ", opName, " scan is WRONG");
+}
+
+proc fill(A) {
+  for (a, i) in zip(A, 1..) do
+    a = (i * 7919) % 1009 - 500;
+}
+
+{
+  var A: [1..n] int;
+  fill(A);
+  test("DR", A);
+}
+{
+  var A: [0..#3*n by 3] int;
+  fill(A);
+  test("DR strided", A);
+}
+{
+  var A: [1..n by -1] int;
+  fill(A);
+  test("DR backwards", A);
+}
+{
+  var A: [1..1] int;
+  fill(A);
+  test("DR single", A);
+}
+{
+  const D = {1..n} dmapped Block(boundingBox={1..n});
+  var A: [D] int;
+  fill(A);
+  test("Block", A);
+}
+{
+  const D = {1..n} dmapped Cyclic(startIdx=1);
+  var A: [D] int;
+  fill(A);
+  test("Cyclic", A);
+}
+{
+  const D = {1..3*n by 3} dmapped Cyclic(startIdx=1);
+  var A: [D] int;
+  fill(A);
+  test("Cyclic strided", A);
+}
+
+{
+  var A: [1..n] int;
+  fill(A);
+  var expect: [1..n] int;
+  for i in 2..n do
+    expect[i] = expect[i-1] + (A[i] > A[i-1]);
+  check("DR", "ascents", ascentsOp scan A, expect);
+  writeln("DR ascents: done");
+}
+
+// The scan of a 1-D array is an array over the same domain.
+{
+  var A: [3..5] int = [1, 2, 3];
+  const S = + scan A;
+  writeln(S.domain, " ", S);
+}
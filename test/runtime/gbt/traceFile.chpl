@@ -0,0 +1,16 @@
+// Check that CHPL_RT_TRACE_FILE produces a well-formed trace with a
+// begin and an end event for every task the program creates.
+
+config const n = 10;
+
+var total: atomic int;
+
+sync {
+  for i in 1..n do
+    begin total.add(i);
+}
+
+coforall i in 1..n do
+  total.add(i);
+
+writeln(total.read());
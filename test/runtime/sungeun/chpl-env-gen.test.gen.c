@@ -0,0 +1,72 @@
+#ifndef CHPL_WIDE_POINTERS_STRUCT
+#error "struct undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_LOCALE_MODEL_FLAT
+#error "flat undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_NETWORK_ATOMICS_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_HOST_PLATFORM_LINUX64
+#error "linux64 undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_TARGET_COMPILER_GNU
+#error "gnu undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_TARGET_ARCH_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_GMP_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_REGEXP_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_COMM_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_GASNET_SEGMENT_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_COMM_SUBSTRATE_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_MEM_CSTDLIB
+#error "cstdlib undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_MAKE_GMAKE
+#error "gmake undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_TASKS_FIFO
+#error "fifo undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_TIMERS_GENERIC
+#error "generic undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_TARGET_PLATFORM_LINUX64
+#error "linux64 undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_UNWIND_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_AUX_FILESYS_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_HOST_COMPILER_GNU
+#error "gnu undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_HWLOC_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_LLVM_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_JEMALLOC_NONE
+#error "none undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_ATOMICS_INTRINSICS
+#error "intrinsics undefined or does not match runtime definition"
+#endif
+#ifndef CHPL_LAUNCHER_NONE
+#error "none undefined or does not match runtime definition"
+#endif
@@ -0,0 +1,64 @@
+//
+// Short strings are kept in the string record itself, so an array of
+// them shouldn't hold on to any memory beyond the array's own, however
+// the strings were made.
+//
+use impl;
+use memTrackSupport;
+
+config const n = 1000;
+
+const longStr: string_impl = "a string that is too long to be kept in the record";
+
+var A: [1..n] string_impl;
+var B: [1..n] string_impl;
+
+proc heapUsed(m0) {
+  const m1 = allMemoryUsed(false);
+  return if CHPL_COMM=="none" then m1-m0 else + reduce (m1-m0);
+}
+
+proc report(what: string, m0) {
+  writeln(what, ": ", heapUsed(m0), " bytes");
+  A = "";
+  B = "";
+}
+
+var m0 = allMemoryUsed();
+for i in 1..n do A[i] = "s" + i;
+report("concatenation", m0);
+
+m0 = allMemoryUsed();
+for i in 1..n do A[i] = longStr[i%longStr.length + 1];
+report("indexing", m0);
+
+m0 = allMemoryUsed();
+for i in 1..n do A[i] = longStr[i%10 + 1..#10];
+report("slicing", m0);
+
+m0 = allMemoryUsed();
+for i in 1..n {
+  A[i] = "x";
+  A[i] += i:string;
+}
+report("appending", m0);
+
+m0 = allMemoryUsed();
+var nWords = 0;
+for w in longStr.split() {
+  nWords += 1;
+  A[nWords] = w;
+}
+report("splitting", m0);
+
+m0 = allMemoryUsed();
+for i in 1..n do A[i] = "copied";
+B = A;
+on Locales[numLocales-1] do
+  for i in 1..n do B[i] = A[i];
+report("copying", m0);
+
+m0 = allMemoryUsed();
+for i in 1..n do A[i] = longStr + i;
+writeln("long strings use the heap: ", heapUsed(m0) > 0);
+A = "";
@@ -0,0 +1,53 @@
+use Time;
+
+config const n = 10000000;
+config const timing = true;
+config const sourcePath = "moby.txt";
+
+var mobyFile = open(sourcePath, iomode.r);
+var moby: string;
+mobyFile.reader().readstring(moby);
+
+const reps = max(1, n / 100000);
+
+// find, for a word that is there and one that isn't
+var tFind: Timer;
+if timing then tFind.start();
+var found = 0;
+for i in 1..reps {
+  if moby.find("Queequeg") > 0 then found += 1;
+  if moby.find("Stubb's pipe") == 0 then found += 1;
+}
+if timing then tFind.stop();
+
+// rfind
+var tRFind: Timer;
+if timing then tRFind.start();
+for i in 1..reps do
+  if moby.rfind("Ishmael") > moby.find("Ishmael") then found += 1;
+if timing then tRFind.stop();
+
+// count
+var tCount: Timer;
+if timing then tCount.start();
+var whales = 0;
+for i in 1..reps do
+  whales = moby.count("whale");
+if timing then tCount.stop();
+
+// replace
+var tReplace: Timer;
+if timing then tReplace.start();
+var replaced: string;
+for i in 1..reps do
+  replaced = moby.replace("whale", "WHALE");
+if timing then tReplace.stop();
+
+if timing {
+  writeln("find: ", tFind.elapsed());
+  writeln("rfind: ", tRFind.elapsed());
+  writeln("count: ", tCount.elapsed());
+  writeln("replace: ", tReplace.elapsed());
+}
+if found == reps * 3 && whales > 0 && replaced.count("whale") == 0 then
+  writeln("SUCCESS");
@@ -0,0 +1,55 @@
+use Time;
+
+config const n = 10000000;
+config const timing = true;
+
+const word = "harpooneer";
+
+// copy
+var tCopy: Timer;
+if timing then tCopy.start();
+var keepAlive: int;
+for i in 1..n {
+  var copy = new string(word);
+  keepAlive += copy.len;
+}
+if timing then tCopy.stop();
+
+// index
+var tIndex: Timer;
+if timing then tIndex.start();
+var c: string;
+for i in 1..n {
+  c = word[i % word.len + 1];
+  keepAlive += c.len;
+}
+if timing then tIndex.stop();
+
+// slice
+var tSlice: Timer;
+if timing then tSlice.start();
+var s: string;
+for i in 1..n {
+  s = word[1..i % word.len + 1];
+  keepAlive += s.len;
+}
+if timing then tSlice.stop();
+
+// split
+var tSplit: Timer;
+if timing then tSplit.start();
+const sentence = "Call me Ishmael. Some years ago never mind how long";
+var words = 0;
+for i in 1..n/10 do
+  for w in sentence.split() do
+    words += 1;
+if timing then tSplit.stop();
+
+if timing {
+  writeln("copy: ", tCopy.elapsed());
+  writeln("index: ", tIndex.elapsed());
+  writeln("slice: ", tSlice.elapsed());
+  writeln("split: ", tSplit.elapsed());
+}
+if keepAlive > 0 && words == n/10 * 10 then
+  writeln("SUCCESS");
@@ -0,0 +1 @@
+/root/repo/third-party/hwloc/hwloc-src/src/topology-opencl.c
\ No newline at end of file
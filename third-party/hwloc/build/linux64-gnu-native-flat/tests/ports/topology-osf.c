@@ -0,0 +1 @@
+/root/repo/third-party/hwloc/hwloc-src/src/topology-osf.c
\ No newline at end of file
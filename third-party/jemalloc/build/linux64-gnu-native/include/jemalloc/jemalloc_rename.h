@@ -0,0 +1,29 @@
+/*
+ * Name mangling for public symbols is controlled by --with-mangling and
+ * --with-jemalloc-prefix.  With default settings the je_ prefix is stripped by
+ * these macro definitions.
+ */
+#ifndef JEMALLOC_NO_RENAME
+#  define je_malloc_conf chpl_je_malloc_conf
+#  define je_malloc_message chpl_je_malloc_message
+#  define je_malloc chpl_je_malloc
+#  define je_calloc chpl_je_calloc
+#  define je_posix_memalign chpl_je_posix_memalign
+#  define je_aligned_alloc chpl_je_aligned_alloc
+#  define je_realloc chpl_je_realloc
+#  define je_free chpl_je_free
+#  define je_mallocx chpl_je_mallocx
+#  define je_rallocx chpl_je_rallocx
+#  define je_xallocx chpl_je_xallocx
+#  define je_sallocx chpl_je_sallocx
+#  define je_dallocx chpl_je_dallocx
+#  define je_sdallocx chpl_je_sdallocx
+#  define je_nallocx chpl_je_nallocx
+#  define je_mallctl chpl_je_mallctl
+#  define je_mallctlnametomib chpl_je_mallctlnametomib
+#  define je_mallctlbymib chpl_je_mallctlbymib
+#  define je_malloc_stats_print chpl_je_malloc_stats_print
+#  define je_malloc_usable_size chpl_je_malloc_usable_size
+#  define je_memalign chpl_je_memalign
+#  define je_valloc chpl_je_valloc
+#endif
@@ -0,0 +1,768 @@
+/* include/config.h.  Generated from config.h.in by configure.  */
+/* include/config.h.in.  Generated from configure.ac by autoheader.  */
+
+/* Define if bitfields are in forward order */
+/* #undef BITFIELD_ORDER_FORWARD */
+
+/* Define if bitfields are in reverse order */
+#define BITFIELD_ORDER_REVERSE 1
+
+/* The cacheline width */
+#define CACHELINE_WIDTH 64
+
+/* Support dynamic profile of CAS steal infomation */
+/* #undef CAS_STEAL_PROFILE */
+
+/* if the compiler supports inline assembly, we can prevent reordering */
+#define COMPILER_FENCE __asm__ __volatile__ ("":::"memory")
+
+/* solaris 8 requires argc be one larger than the actual count of arguments */
+/* #undef EXTRA_MAKECONTEXT_ARGC */
+
+/* define if compiler supports __builtin_prefetch */
+#define HAS_BUILTIN_PREFETCH 1
+
+/* Define if `calloc'ing more than 16 bytes always returns a 16-byte-aligned
+   address (common practice on MacOS X). */
+#define HAVE_16ALIGNED_CALLOC 1
+
+/* Define if `malloc'ing more than 16 bytes always returns a 16-byte-aligned
+   address (common practice on MacOS X). */
+#define HAVE_16ALIGNED_MALLOC 1
+
+/* Define to 1 if you have the <assert.h> header file. */
+#define HAVE_ASSERT_H 1
+
+/* Define if the compiler supports GNU-style __FUNCTION__. */
+/* #undef HAVE_C99_FUNC */
+
+/* Define if the compiler supports C99 variadic macros. */
+#define HAVE_C99_VAMACROS 1
+
+/* Define to 1 if you have the declaration of `MADV_ACCESS_LWP', and to 0 if
+   you don't. */
+#define HAVE_DECL_MADV_ACCESS_LWP 0
+
+/* Define to 1 if you have the declaration of `SYS_accept', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_ACCEPT */
+
+/* Define to 1 if you have the declaration of `SYS_connect', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_CONNECT */
+
+/* Define to 1 if you have the declaration of `SYS_nanosleep', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_NANOSLEEP */
+
+/* Define to 1 if you have the declaration of `SYS_poll', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_POLL */
+
+/* Define to 1 if you have the declaration of `SYS_pread', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_PREAD */
+
+/* Define to 1 if you have the declaration of `SYS_pwrite', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_PWRITE */
+
+/* Define to 1 if you have the declaration of `SYS_read', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_READ */
+
+/* Define to 1 if you have the declaration of `SYS_select', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_SELECT */
+
+/* Define to 1 if you have the declaration of `SYS_sleep', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_SLEEP */
+
+/* Define to 1 if you have the declaration of `SYS_system', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_SYSTEM */
+
+/* Define to 1 if you have the declaration of `SYS_usleep', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_USLEEP */
+
+/* Define to 1 if you have the declaration of `SYS_wait4', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_WAIT4 */
+
+/* Define to 1 if you have the declaration of `SYS_write', and to 0 if you
+   don't. */
+/* #undef HAVE_DECL_SYS_WRITE */
+
+/* Define to 1 if you have the <dlfcn.h> header file. */
+#define HAVE_DLFCN_H 1
+
+/* Define to 1 if you don't have `vprintf' but do have `_doprnt.' */
+/* #undef HAVE_DOPRNT */
+
+/* Define to 1 if you have the <fcntl.h> header file. */
+#define HAVE_FCNTL_H 1
+
+/* Define to 1 if you have the `fstat64' function. */
+#define HAVE_FSTAT64 1
+
+/* Whether C compiler supports GCC style inline assembly */
+#define HAVE_GCC_INLINE_ASSEMBLY 1
+
+/* Define to 1 if you have the `getcontext' function. */
+#define HAVE_GETCONTEXT 1
+
+/* Define to 1 if you have the `getpagesize' function. */
+#define HAVE_GETPAGESIZE 1
+
+/* Define to 1 if you have the `getrlimit' function. */
+/* #undef HAVE_GETRLIMIT */
+
+/* Define if the compiler supports GNU-style __FUNCTION__. */
+#define HAVE_GNU_FUNCTION 1
+
+/* Define if the compiler supports GNU-style variadic macros. */
+#define HAVE_GNU_VAMACROS 1
+
+/* Define to 1 if you have the <hwloc.h> header file. */
+#define HAVE_HWLOC_H 1
+
+/* define if you have HW_NCPU and CTL_HW */
+/* #undef HAVE_HW_NCPU */
+
+/* Define to 1 if you have the <ia32intrin.h> header file. */
+/* #undef HAVE_IA32INTRIN_H */
+
+/* Define to 1 if you have the <ia64intrin.h> header file. */
+/* #undef HAVE_IA64INTRIN_H */
+
+/* Define to 1 if you have the <inttypes.h> header file. */
+#define HAVE_INTTYPES_H 1
+
+/* Have math library */
+#define HAVE_LIBM 1
+
+/* Define to 1 if you have the <linux/mmtimer.h> header file. */
+#define HAVE_LINUX_MMTIMER_H 1
+
+/* Define to 1 if you have the `lseek64' function. */
+#define HAVE_LSEEK64 1
+
+/* Define to 1 if you have the <mach/mach_init.h> header file. */
+/* #undef HAVE_MACH_MACH_INIT_H */
+
+/* Define to 1 if you have the <mach/mach_time.h> header file. */
+/* #undef HAVE_MACH_MACH_TIME_H */
+
+/* Define to 1 if you have the <mach/thread_policy.h> header file. */
+/* #undef HAVE_MACH_THREAD_POLICY_H */
+
+/* Define to 1 if you have the `madvise' function. */
+#define HAVE_MADVISE 1
+
+/* Define to 1 if you have the `makecontext' function. */
+#define HAVE_MAKECONTEXT 1
+
+/* Define to 1 if you have the <malloc.h> header file. */
+#define HAVE_MALLOC_H 1
+
+/* Define to 1 if you have the <math.h> header file. */
+#define HAVE_MATH_H 1
+
+/* Define to 1 if you have the `memalign' function. */
+#define HAVE_MEMALIGN 1
+
+/* Define to 1 if you have the `memcpy' function. */
+#define HAVE_MEMCPY 1
+
+/* Define to 1 if you have the `memmove' function. */
+#define HAVE_MEMMOVE 1
+
+/* Define to 1 if you have the <memory.h> header file. */
+#define HAVE_MEMORY_H 1
+
+/* Define to 1 if you have the `memset' function. */
+#define HAVE_MEMSET 1
+
+/* Define to 1 if you have a working `mmap' system call. */
+#define HAVE_MMAP 1
+
+/* Define to 1 if you have the `munmap' function. */
+#define HAVE_MUNMAP 1
+
+/* The system provides functional native make/swap/get-context functions */
+/* #undef HAVE_NATIVE_MAKECONTEXT */
+
+/* Define to 1 if you have the `numa_bitmask_nbytes' function. */
+/* #undef HAVE_NUMA_BITMASK_NBYTES */
+
+/* Define to 1 if you have the `numa_distance' function. */
+/* #undef HAVE_NUMA_DISTANCE */
+
+/* Define to 1 if you have the <numa.h> header file. */
+/* #undef HAVE_NUMA_H */
+
+/* Define to 1 if you have the `numa_num_configured_cpus' function. */
+/* #undef HAVE_NUMA_NUM_CONFIGURED_CPUS */
+
+/* Define to 1 if you have the `numa_num_thread_cpus' function. */
+/* #undef HAVE_NUMA_NUM_THREAD_CPUS */
+
+/* Define if `malloc'ing more than one page always returns a page-aligned
+   address. */
+/* #undef HAVE_PAGE_ALIGNED_MALLOC */
+
+/* Define to 1 if you have the `posix_memalign' function. */
+#define HAVE_POSIX_MEMALIGN 1
+
+/* Define to 1 if you have the `processor_bind' function. */
+/* #undef HAVE_PROCESSOR_BIND */
+
+/* have access to the PTHREAD_PROCESS_PRIVATE constant */
+#define HAVE_PTHREAD_PROCESS_PRIVATE 1
+
+/* Define to 1 if you have the `pthread_spin_init' function. */
+#define HAVE_PTHREAD_SPIN_INIT 1
+
+/* Define to 1 if you have the `pthread_yield' function. */
+/* #undef HAVE_PTHREAD_YIELD */
+
+/* Define to 1 if you have the `qsort_r' function. */
+#define HAVE_QSORT_R 1
+
+/* Define to 1 if you have the <sched.h> header file. */
+#define HAVE_SCHED_H 1
+
+/* Define to 1 if you have the `sched_yield' function. */
+#define HAVE_SCHED_YIELD 1
+
+/* Define if _SC_CLK_TCK is available. */
+#define HAVE_SC_CLK_TCK 1
+
+/* define if you have _SC_NPROCESSORS_CONF */
+/* #undef HAVE_SC_NPROCESSORS_CONF */
+
+/* Define to 1 if you have the `setrlimit' function. */
+/* #undef HAVE_SETRLIMIT */
+
+/* Define to 1 if you have the <signal.h> header file. */
+#define HAVE_SIGNAL_H 1
+
+/* Define to 1 if you have the <sn/mmtimer.h> header file. */
+/* #undef HAVE_SN_MMTIMER_H */
+
+/* Define to 1 if you have the <stdarg.h> header file. */
+#define HAVE_STDARG_H 1
+
+/* Define to 1 if you have the <stdint.h> header file. */
+#define HAVE_STDINT_H 1
+
+/* Define to 1 if you have the <stdlib.h> header file. */
+#define HAVE_STDLIB_H 1
+
+/* Define to 1 if you have the <strings.h> header file. */
+#define HAVE_STRINGS_H 1
+
+/* Define to 1 if you have the <string.h> header file. */
+#define HAVE_STRING_H 1
+
+/* Define to 1 if you have the `strtol' function. */
+#define HAVE_STRTOL 1
+
+/* Define to 1 if you have the `swapcontext' function. */
+#define HAVE_SWAPCONTEXT 1
+
+/* Define to 1 if you have the `syscall' function. */
+#define HAVE_SYSCALL 1
+
+/* Define to 1 if you have the `sysconf' function. */
+#define HAVE_SYSCONF 1
+
+/* Define to 1 if you have the `sysctl' function. */
+/* #undef HAVE_SYSCTL */
+
+/* Define to 1 if you have the <sys/inttypes.h> header file. */
+/* #undef HAVE_SYS_INTTYPES_H */
+
+/* Define to 1 if you have the <sys/ioctl.h> header file. */
+#define HAVE_SYS_IOCTL_H 1
+
+/* Define to 1 if you have the <sys/lgrp_user.h> header file. */
+/* #undef HAVE_SYS_LGRP_USER_H */
+
+/* Define to 1 if you have the <sys/mman.h> header file. */
+#define HAVE_SYS_MMAN_H 1
+
+/* Define to 1 if you have the <sys/param.h> header file. */
+#define HAVE_SYS_PARAM_H 1
+
+/* Define to 1 if you have the <sys/resource.h> header file. */
+#define HAVE_SYS_RESOURCE_H 1
+
+/* Define to 1 if you have the <sys/stat.h> header file. */
+#define HAVE_SYS_STAT_H 1
+
+/* Define to 1 if you have the <sys/syscall.h> header file. */
+#define HAVE_SYS_SYSCALL_H 1
+
+/* Define to 1 if you have the <sys/sysctl.h> header file. */
+/* #undef HAVE_SYS_SYSCTL_H */
+
+/* Define to 1 if you have the <sys/time.h> header file. */
+#define HAVE_SYS_TIME_H 1
+
+/* Define to 1 if you have the <sys/types.h> header file. */
+#define HAVE_SYS_TYPES_H 1
+
+/* Define to 1 if you have the <sys/ucontext.h> header file. */
+#define HAVE_SYS_UCONTEXT_H 1
+
+/* Define to 1 if you have the <sys/utsname.h> header file. */
+#define HAVE_SYS_UTSNAME_H 1
+
+/* Define to 1 if you have <sys/wait.h> that is POSIX.1 compatible. */
+#define HAVE_SYS_WAIT_H 1
+
+/* Define to 1 if you have the <tmc/cpus.h> header file. */
+/* #undef HAVE_TMC_CPUS_H */
+
+/* Define to 1 if you have the <ucontext.h> header file. */
+#define HAVE_UCONTEXT_H 1
+
+/* Define to 1 if you have the <unistd.h> header file. */
+#define HAVE_UNISTD_H 1
+
+/* compiler understands __attribute__((unused)) */
+#define HAVE_UNUSED 1
+
+/* Define to 1 if you have the <valgrind/memcheck.h> header file. */
+/* #undef HAVE_VALGRIND_MEMCHECK_H */
+
+/* Define to 1 if you have the `vprintf' function. */
+#define HAVE_VPRINTF 1
+
+/* Define if `valloc'ed memory can be `free'd. */
+#define HAVE_WORKING_VALLOC 1
+
+/* make the ss_sp member of uc_stack be the high-address of the stack, rather
+   than the low-address of the stack */
+/* #undef INVERSE_STACK_POINTER */
+
+/* Define to use a lock-free hash table for FEB metadata. */
+/* #undef LOCK_FREE_FEBS */
+
+/* Define to the sub-directory where libtool stores uninstalled libraries. */
+#define LT_OBJDIR ".libs/"
+
+/* if the compiler supports __sync_synchronize (fallback to COMPILER_FENCE) */
+#define MACHINE_FENCE __sync_synchronize()
+
+/* Whether the library should use get/set rlimit functions */
+/* #undef NEED_RLIMIT */
+
+/* Define to the address where bug reports for this package should be sent. */
+#define PACKAGE_BUGREPORT "wg-qthread@sandia.gov"
+
+/* Define to the full name of this package. */
+#define PACKAGE_NAME "qthread"
+
+/* Define to the full name and version of this package. */
+#define PACKAGE_STRING "qthread 1.12"
+
+/* Define to the one symbol short name of this package. */
+#define PACKAGE_TARNAME "qthread"
+
+/* Define to the home page for this package. */
+#define PACKAGE_URL ""
+
+/* Define to the version of this package. */
+#define PACKAGE_VERSION "1.12"
+
+/* this signifies that pthread_mutex_t is small enough to fit in the existing
+   data structures */
+#define PTHREAD_MUTEX_SMALL_ENOUGH 1
+
+/* Allow function inlining to be toggled */
+#define QINLINE inline
+
+/* specifying data alignment is allowed */
+#define QTHREAD_ALIGNEDDATA_ALLOWED 1
+
+/* alignment of aligned_t */
+#define QTHREAD_ALIGNMENT_ALIGNED_T 8
+
+/* Support HPCToolkit stack unwinding */
+/* #undef QTHREAD_ALLOW_HPCTOOLKIT_STACK_UNWINDING */
+
+/* Architecture type of assembly to use */
+#define QTHREAD_ASSEMBLY_ARCH QTHREAD_AMD64
+
+/* if the compiler supports __sync_val_compare_and_swap */
+#define QTHREAD_ATOMIC_CAS 1
+
+/* if the compiler supports __sync_val_compare_and_swap on 32-bit ints */
+#define QTHREAD_ATOMIC_CAS32 1
+
+/* if the compiler supports __sync_val_compare_and_swap on 64-bit ints */
+#define QTHREAD_ATOMIC_CAS64 1
+
+/* if the compiler supports __sync_val_compare_and_swap on pointers */
+#define QTHREAD_ATOMIC_CAS_PTR 1
+
+/* if the compiler supports __sync_fetch_and_add */
+#define QTHREAD_ATOMIC_INCR 1
+
+/* use pthread-based condwait for lf queue */
+#define QTHREAD_CONDWAIT_BLOCKING_QUEUE 1
+
+/* keeps track of the number of threads */
+/* #undef QTHREAD_COUNT_THREADS */
+
+/* enables printing debugging information at runtime */
+/* #undef QTHREAD_DEBUG */
+
+/* prints out affinity debugging information at runtime */
+/* #undef QTHREAD_DEBUG_AFFINITY */
+
+/* prints out barrier debugging information at runtime */
+/* #undef QTHREAD_DEBUG_BARRIER */
+
+/* prints out core debugging information at runtime */
+/* #undef QTHREAD_DEBUG_CORE */
+
+/* prints out feb debugging information at runtime */
+/* #undef QTHREAD_DEBUG_FEBS */
+
+/* prints out futurelib debugging information at runtime */
+/* #undef QTHREAD_DEBUG_FUTURELIB */
+
+/* prints out I/O debugging information at runtime */
+/* #undef QTHREAD_DEBUG_IO */
+
+/* prints out loop debugging information at runtime */
+/* #undef QTHREAD_DEBUG_LOOPS */
+
+/* prints out memory pool debugging information at runtime */
+/* #undef QTHREAD_DEBUG_MPOOL */
+
+/* prints out multinode debugging information at runtime */
+/* #undef QTHREAD_DEBUG_MULTINODE */
+
+/* prints out qarray debugging information at runtime */
+/* #undef QTHREAD_DEBUG_QARRAY */
+
+/* prints out rcrtool debugging information at runtime */
+/* #undef QTHREAD_DEBUG_RCRTOOL */
+
+/* prints out shepherd debugging information at runtime */
+/* #undef QTHREAD_DEBUG_SHEPHERD */
+
+/* prints out syncvar debugging information at runtime */
+/* #undef QTHREAD_DEBUG_SYNCVARS */
+
+/* prints out syscall debugging information at runtime */
+/* #undef QTHREAD_DEBUG_SYSCALLS */
+
+/* prints out team debugging information at runtime */
+/* #undef QTHREAD_DEBUG_TEAM */
+
+/* prints out threadqueue debugging information at runtime */
+/* #undef QTHREAD_DEBUG_THREADQUEUES */
+
+/* prints out thread debugging information at runtime */
+/* #undef QTHREAD_DEBUG_THREADS */
+
+/* prints out xomp debugging information at runtime */
+/* #undef QTHREAD_DEBUG_XOMP */
+
+/* What size stacks to use by default */
+#define QTHREAD_DEFAULT_STACK_SIZE 4096
+
+/* If __builtin_expect can be used */
+#define QTHREAD_EXPECT_OKAY 1
+
+/* adds code to monitor how much time is spent waiting for FEB states */
+/* #undef QTHREAD_FEB_PROFILING */
+
+/* Use guard pages to detect stack overruns */
+#define QTHREAD_GUARD_PAGES 1
+
+/* if I can use the hwloc topology interface */
+#define QTHREAD_HAVE_HWLOC 1
+
+/* Hwloc has distances */
+#define QTHREAD_HAVE_HWLOC_DISTS 1
+
+/* if the machine has a Solaris-style liblgrp topology interface */
+/* #undef QTHREAD_HAVE_LGRP */
+
+/* if libnuma is available */
+/* #undef QTHREAD_HAVE_LIBNUMA */
+
+/* if the machine has a MacOS-style Mach topology interface */
+/* #undef QTHREAD_HAVE_MACHTOPO */
+
+/* if the machine has a Tilera-style topology interface */
+/* #undef QTHREAD_HAVE_TILETOPO */
+
+/* if libnuma provides numa_allocate_nodemask */
+/* #undef QTHREAD_LIBNUMA_V2 */
+
+/* Enable multiple-dequeuer support for lifo scheduler */
+/* #undef QTHREAD_LIFO_MULTI_DEQUEUER */
+
+/* makecontext()passes args as int-size, not long-size */
+/* #undef QTHREAD_MAKECONTEXT_SPLIT */
+
+/* turns on memory scribbling */
+/* #undef QTHREAD_MEMORY_SCRIBBLING */
+
+/* Defined if multinode support desired */
+/* #undef QTHREAD_MULTINODE */
+
+/* Use mutexes instead of assembly for atomic increment */
+/* #undef QTHREAD_MUTEX_INCREMENT */
+
+/* if this header is necessary for builtin atomics */
+/* #undef QTHREAD_NEEDS_IA64INTRIN */
+
+/* Do not check the alignment of synchronization addresses */
+#define QTHREAD_NOALIGNCHECK 1
+
+/* makes sure every thread gets an id at creation time */
+/* #undef QTHREAD_NONLAZY_THREADIDS */
+
+/* removes sanity checks from most qthread functions */
+#define QTHREAD_NO_ASSERTS 1
+
+/* if libnuma's numa_distance() function works */
+/* #undef QTHREAD_NUMA_DISTANCE_WORKING */
+
+/* Enable experimental OpenMP affinity extensions. Under development */
+/* #undef QTHREAD_OMP_AFFINITY */
+
+/* call into the OS scheduler when possible */
+/* #undef QTHREAD_OVERSUBSCRIPTION */
+
+/* expensive sanity checks */
+/* #undef QTHREAD_PARANOIA */
+
+/* Define to specify the PPC ABI */
+/* #undef QTHREAD_PPC_ABI */
+
+/* Constant for the AIX PPC ABI */
+/* #undef QTHREAD_PPC_ABI_AIX */
+
+/* Constant for the Darwin PPC ABI */
+/* #undef QTHREAD_PPC_ABI_DARWIN */
+
+/* Constant for the SysV PPC ABI */
+/* #undef QTHREAD_PPC_ABI_SYSV */
+
+/* Constant for an unknown PPC ABI */
+/* #undef QTHREAD_PPC_ABI_UNKNOWN */
+
+/* Precache guard pages in pooled stacks */
+/* #undef QTHREAD_PRECACHE_GUARD_PAGES */
+
+/* Define for BSD-style qsort_r */
+/* #undef QTHREAD_QSORT_BSD */
+
+/* Define for glibc-style qsort_r */
+#define QTHREAD_QSORT_GLIBC 1
+
+/* enables RCR logging and scheduling */
+/* #undef QTHREAD_RCRTOOL */
+
+/* logs RCR stats */
+/* #undef QTHREAD_RCRTOOL_STAT */
+
+/* adds code to monitor how much time shepherds spend idle */
+/* #undef QTHREAD_SHEPHERD_PROFILING */
+
+/* use a shift-based gcd algorithm */
+/* #undef QTHREAD_SHIFT_GCD */
+
+/* size of aligned_t */
+#define QTHREAD_SIZEOF_ALIGNED_T 8
+
+/* How to align the stacks. */
+#define QTHREAD_STACK_ALIGNMENT 16
+
+/* If __builtin_trap can be used */
+#define QTHREAD_TRAP_OKAY 1
+
+/* the uc_stack structure in ucontext_t has an ss_flags structure that needs
+   to be initialized */
+/* #undef QTHREAD_UCSTACK_HAS_SSFLAGS */
+
+/* Define to use eurekas */
+/* #undef QTHREAD_USE_EUREKAS */
+
+/* define to 1 if PLPA is available and works */
+/* #undef QTHREAD_USE_PLPA */
+
+/* Define to enable ROSE extensions */
+/* #undef QTHREAD_USE_ROSE_EXTENSIONS */
+
+/* Define to use worker-specific spawn cache */
+/* #undef QTHREAD_USE_SPAWNCACHE */
+
+/* Use Valgrind Macros */
+/* #undef QTHREAD_USE_VALGRIND */
+
+/* socklen_t compatible uint */
+/* #undef QT_SOCKLENTYPE_T */
+
+/* if the compiler supports __attribute__((deprecated)) */
+#define Q_DEPRECATED __attribute__((deprecated))
+
+/* if the compiler supports __attribute__((malloc)) */
+#define Q_MALLOC __attribute__((malloc))
+
+/* if the compiler supports __attribute__((NOINLINE)) */
+#define Q_NOINLINE __attribute__((noinline))
+
+/* most gcc compilers know a function __attribute__((unused)) */
+#define Q_UNUSED __attribute__((unused))
+
+/* Support dynamic profile of sincs infomation */
+/* #undef SINCS_PROFILE */
+
+/* The size of `char', as computed by sizeof. */
+/* #undef SIZEOF_CHAR */
+
+/* The size of `int', as computed by sizeof. */
+#define SIZEOF_INT 4
+
+/* The size of `long', as computed by sizeof. */
+#define SIZEOF_LONG 8
+
+/* The size of `pthread_mutex_t', as computed by sizeof. */
+#define SIZEOF_PTHREAD_MUTEX_T 40
+
+/* The size of `short', as computed by sizeof. */
+/* #undef SIZEOF_SHORT */
+
+/* The size of `socklen_t', as computed by sizeof. */
+/* #undef SIZEOF_SOCKLEN_T */
+
+/* The size of `void*', as computed by sizeof. */
+#define SIZEOF_VOIDP 8
+
+/* The size of `void *', as computed by sizeof. */
+#define SIZEOF_VOID_P 8
+
+/* Support dynamic profile of SPR infomation */
+/* #undef SPR_PROFILE */
+
+/* Define to 1 if you have the ANSI C header files. */
+#define STDC_HEADERS 1
+
+/* Support dynamic profile of steal infomation */
+/* #undef STEAL_PROFILE */
+
+/* Support dynamic profile of teams infomation */
+/* #undef TEAM_PROFILE */
+
+/* Define to 1 if you can safely include both <sys/time.h> and <time.h>. */
+#define TIME_WITH_SYS_TIME 1
+
+/* If the compiler supports a TLS storage class define it to that here */
+#define TLS __thread
+
+/* prevents most uses of memory pools */
+/* #undef UNPOOLED */
+
+/* Define to allow blocking syscalls to be mangled into qthread-specific
+   variants */
+/* #undef USE_HEADER_SYSCALLS */
+
+/* Use Porterfield spinlock */
+#define USE_INTERNAL_SPINLOCK 1
+
+/* Enable extensions on AIX 3, Interix.  */
+#ifndef _ALL_SOURCE
+# define _ALL_SOURCE 1
+#endif
+/* Enable GNU extensions on systems that have them.  */
+#ifndef _GNU_SOURCE
+# define _GNU_SOURCE 1
+#endif
+/* Enable threading extensions on Solaris.  */
+#ifndef _POSIX_PTHREAD_SEMANTICS
+# define _POSIX_PTHREAD_SEMANTICS 1
+#endif
+/* Enable extensions on HP NonStop.  */
+#ifndef _TANDEM_SOURCE
+# define _TANDEM_SOURCE 1
+#endif
+/* Enable general extensions on Solaris.  */
+#ifndef __EXTENSIONS__
+# define __EXTENSIONS__ 1
+#endif
+
+
+/* Enable large inode numbers on Mac OS X 10.5.  */
+#ifndef _DARWIN_USE_64_BIT_INODE
+# define _DARWIN_USE_64_BIT_INODE 1
+#endif
+
+/* Number of bits in a file offset, on hosts where this is settable. */
+/* #undef _FILE_OFFSET_BITS */
+
+/* Define for large files, on AIX-style hosts. */
+/* #undef _LARGE_FILES */
+
+/* Define to 1 if on MINIX. */
+/* #undef _MINIX */
+
+/* Define to 2 if the system does not provide POSIX.1 features except with
+   this defined. */
+/* #undef _POSIX_1_SOURCE */
+
+/* Define to 1 if you need to in order for `stat' and other things to work. */
+/* #undef _POSIX_SOURCE */
+
+/* Last resort, if no function name macros can be found */
+/* #undef __FUNCTION__ */
+
+/* force the Sun makecontext to behave correctly */
+/* #undef __MAKECONTEXT_V2_SOURCE */
+
+/* Define to empty if `const' does not conform to ANSI C. */
+/* #undef const */
+
+/* Define to `__inline__' or `__inline' if that's what the C compiler
+   calls it, or to nothing if 'inline' is not supported under any name.  */
+#ifndef __cplusplus
+/* #undef inline */
+#endif
+
+/* Define to `long int' if <sys/types.h> does not define. */
+/* #undef off_t */
+
+/* Define to `int' if <sys/types.h> does not define. */
+/* #undef pid_t */
+
+/* Define to the equivalent of the C99 'restrict' keyword, or to
+   nothing if this is not supported.  Do not define if restrict is
+   supported directly.  */
+#define restrict __restrict
+/* Work around a bug in Sun C++: it does not support _Restrict or
+   __restrict__, even though the corresponding Sun C compiler ends up with
+   "#define restrict _Restrict" or "#define restrict __restrict__" in the
+   previous line.  Perhaps some future version of Sun C++ will work with
+   restrict; if so, hopefully it defines __RESTRICT like Sun C does.  */
+#if defined __SUNPRO_CC && !defined __RESTRICT
+# define _Restrict
+# define __restrict__
+#endif
+
+/* Define to `unsigned int' if <sys/types.h> does not define. */
+/* #undef size_t */
+
+/* Define to empty if the keyword `volatile' does not work. Warning: valid
+   code using `volatile' can become incorrect without. Disable with care. */
+/* #undef volatile */
@@ -0,0 +1,2 @@
+#define CHPL_QTHREAD_SUPPORTS_REMOTE_CACHE 1
+#define CHPL_QTHREAD_SCHEDULER_ONE_WORKER_PER_SHEPHERD 1